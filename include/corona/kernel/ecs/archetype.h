@@ -1,9 +1,11 @@
 #pragma once
 #include <memory>
+#include <span>
 #include <vector>
 
 #include "chunk.h"
 #include "chunk_allocator.h"
+#include "corona/pal/cfw_platform.h"
 
 namespace Corona::Kernel::ECS {
 
@@ -105,6 +107,20 @@ class Archetype {
      */
     [[nodiscard]] EntityLocation allocate_entity();
 
+    /**
+     * @brief 为指定实体分配槽位，并记录行所属实体
+     * @param entity 实体 ID
+     * @return 实体在 Archetype 内的位置
+     */
+    [[nodiscard]] EntityLocation allocate_entity(EntityId entity);
+
+    /**
+     * @brief 获取指定位置的实体 ID
+     * @param location 实体位置
+     * @return 实体 ID，位置无效或未记录返回 kInvalidEntity
+     */
+    [[nodiscard]] EntityId entity_at(const EntityLocation& location) const;
+
     /**
      * @brief 释放实体槽位
      *
@@ -153,12 +169,45 @@ class Archetype {
      */
     template <Component T>
     void set_component(const EntityLocation& location, T&& value) {
-        T* ptr = get_component<T>(location);
-        if (ptr) {
-            *ptr = std::forward<T>(value);
+        using U = std::remove_cvref_t<T>;
+        if constexpr (is_soa_component_v<U>) {
+            write_split_component(location, get_component_type_id<U>(), &value);
+        } else {
+            U* ptr = get_component<U>(location);
+            if (ptr) {
+                *ptr = std::forward<T>(value);
+            }
         }
     }
 
+    // ========================================
+    // SoA 拆分组件访问
+    // ========================================
+
+    /**
+     * @brief 获取 SoA 组件单个字段的指针
+     * @param location 实体位置
+     * @param type_id 组件类型 ID
+     * @param field_index 字段下标
+     * @return 字段指针，类型不存在、未拆分或位置无效返回 nullptr
+     */
+    [[nodiscard]] void* get_field(const EntityLocation& location, ComponentTypeId type_id,
+                                  std::size_t field_index);
+
+    /**
+     * @brief 聚合读取 SoA 组件
+     * @return 成功返回 true
+     */
+    bool read_split_component(const EntityLocation& location, ComponentTypeId type_id,
+                              void* dst) const;
+
+    /**
+     * @brief 分散写入 SoA 组件
+     * @return 成功返回 true
+     */
+    bool write_split_component(const EntityLocation& location, ComponentTypeId type_id,
+                               const void* src);
+
     // ========================================
     // Chunk 访问（用于批量处理）
     // ========================================
@@ -172,6 +221,45 @@ class Archetype {
     [[nodiscard]] Chunk& get_chunk(std::size_t index);
     [[nodiscard]] const Chunk& get_chunk(std::size_t index) const;
 
+    /**
+     * @brief 确保至少有 count 个 Chunk（不足时创建空 Chunk）
+     * @param count 目标 Chunk 数量
+     */
+    void ensure_chunk_count(std::size_t count);
+
+    /**
+     * @brief 获取所有 Chunk 数据区起始地址的扁平数组
+     *
+     * 下标与 get_chunk() 一一对应。批量遍历时直接按下标读取地址，
+     * 避免逐 Chunk 解引用 unique_ptr，也便于硬件预取器顺序跟进。
+     *
+     * @return Chunk 数据区地址数组
+     */
+    [[nodiscard]] std::span<std::byte* const> chunk_data() const { return chunk_data_; }
+
+    /**
+     * @brief 预取指定 Chunk 的组件数组头部
+     *
+     * 在处理当前 Chunk 时调用，提前把下一个 Chunk 的对象头和各组件数组的
+     * 首个缓存行加载到缓存，掩盖 Chunk 边界处的访存延迟。
+     *
+     * @param index Chunk 索引，越界时什么也不做
+     * @param array_offsets 需要预取的组件数组偏移（ComponentLayout::array_offset）
+     */
+    void prefetch_chunk(std::size_t index, std::span<const std::size_t> array_offsets) const {
+        if (index >= chunks_.size()) {
+            return;
+        }
+        CFW_PREFETCH(chunks_[index].get());
+        const std::byte* base = chunk_data_[index];
+        if (!base) {
+            return;
+        }
+        for (auto offset : array_offsets) {
+            CFW_PREFETCH(base + offset);
+        }
+    }
+
     /// Chunk 迭代器类型
     using ChunkIterator = std::vector<std::unique_ptr<Chunk>>::iterator;
     using ConstChunkIterator = std::vector<std::unique_ptr<Chunk>>::const_iterator;
@@ -285,6 +373,7 @@ class Archetype {
     ArchetypeSignature signature_;                ///< 组件类型签名
     ArchetypeLayout layout_;                      ///< 内存布局
     std::vector<std::unique_ptr<Chunk>> chunks_;  ///< Chunk 列表
+    std::vector<std::byte*> chunk_data_;          ///< 各 Chunk 数据区地址（与 chunks_ 对应）
     ChunkAllocator* allocator_ = nullptr;         ///< Chunk 内存分配器
 };
 
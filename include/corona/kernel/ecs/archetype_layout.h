@@ -5,10 +5,20 @@
 
 namespace Corona::Kernel::ECS {
 
+/**
+ * @brief SoA 拆分组件中单个字段子列的布局信息
+ */
+struct FieldLayout {
+    std::size_t offset_in_component = 0;  ///< 字段在组件结构体内的偏移
+    std::size_t array_offset = 0;         ///< 字段子列在 Chunk 内的起始偏移
+    std::size_t size = 0;                 ///< 单个字段大小
+};
+
 /**
  * @brief 单个组件在 Chunk 内的布局信息
  *
  * 描述组件数组在 Chunk 内存中的位置和属性。
+ * SoA 拆分组件没有整体数组，array_offset 指向第一个字段子列。
  */
 struct ComponentLayout {
     ComponentTypeId type_id = kInvalidComponentTypeId;  ///< 组件类型 ID
@@ -16,10 +26,14 @@ struct ComponentLayout {
     std::size_t size = 0;                               ///< 单个组件大小
     std::size_t alignment = 0;                          ///< 对齐要求
     const ComponentTypeInfo* type_info = nullptr;       ///< 类型信息指针
+    std::vector<FieldLayout> fields;                    ///< SoA 字段子列（为空表示整体存储）
 
     [[nodiscard]] bool is_valid() const {
         return type_id != kInvalidComponentTypeId && size > 0;
     }
+
+    /// 是否为 SoA 拆分存储
+    [[nodiscard]] bool is_split() const { return !fields.empty(); }
 };
 
 /**
@@ -36,6 +50,12 @@ struct ComponentLayout {
  * - 缓存友好：遍历单个组件类型时数据连续
  * - SIMD 友好：同类型数据连续，便于向量化
  * - 灵活对齐：每个组件数组独立对齐
+ *
+ * 通过 CORONA_SOA_COMPONENT 声明的组件会进一步按字段拆分为子列：
+ *
+ * ```
+ * [Pos.x_0..Pos.x_N][Pos.y_0..Pos.y_N][Pos.z_0..Pos.z_N] | [CompB_0]...[CompB_N] | ...
+ * ```
  */
 struct ArchetypeLayout {
     std::vector<ComponentLayout> components;  ///< 各组件布局信息
@@ -72,6 +92,13 @@ struct ArchetypeLayout {
         return find_component(get_component_type_id<T>());
     }
 
+    /**
+     * @brief 获取组件在 components 中的下标（即 Chunk 列号）
+     * @param type_id 组件类型 ID
+     * @return 下标，类型不存在返回 -1
+     */
+    [[nodiscard]] std::ptrdiff_t component_index(ComponentTypeId type_id) const;
+
     /**
      * @brief 获取组件在 Chunk 中的数组起始偏移
      * @param type_id 组件类型 ID
@@ -1,10 +1,13 @@
 #pragma once
+#include <array>
 #include <cassert>
 #include <cstddef>
 #include <optional>
 #include <span>
+#include <vector>
 
 #include "archetype_layout.h"
+#include "entity_id.h"
 
 namespace Corona::Kernel::ECS {
 
@@ -27,6 +30,7 @@ class ChunkAllocator;
  * - SoA 布局，缓存友好
  * - swap-and-pop 删除策略，保持数据紧凑
  * - 支持外部内存分配器（ChunkAllocator）
+ * - 支持按字段拆分的 SoA 组件（见 CORONA_SOA_COMPONENT）
  */
 class Chunk {
    public:
@@ -72,6 +76,10 @@ class Chunk {
     /// 是否为空
     [[nodiscard]] bool is_empty() const { return count_ == 0; }
 
+    /// 获取原始内存块起始地址（组件数组地址 = data() + array_offset）
+    [[nodiscard]] std::byte* data() { return data_; }
+    [[nodiscard]] const std::byte* data() const { return data_; }
+
     // ========================================
     // 组件数组访问
     // ========================================
@@ -91,6 +99,7 @@ class Chunk {
      */
     template <Component T>
     [[nodiscard]] std::span<T> get_components() {
+        static_assert(!is_soa_component_v<T>, "SoA component has no contiguous array, use get_soa_components");
         void* ptr = get_component_array(get_component_type_id<T>());
         if (!ptr) {
             return {};
@@ -100,6 +109,7 @@ class Chunk {
 
     template <Component T>
     [[nodiscard]] std::span<const T> get_components() const {
+        static_assert(!is_soa_component_v<T>, "SoA component has no contiguous array, use get_soa_components");
         const void* ptr = get_component_array(get_component_type_id<T>());
         if (!ptr) {
             return {};
@@ -132,6 +142,105 @@ class Chunk {
         return static_cast<const T*>(get_component_at(get_component_type_id<T>(), index));
     }
 
+    // ========================================
+    // SoA 拆分组件访问
+    // ========================================
+
+    /**
+     * @brief 获取 SoA 组件指定字段子列的起始指针
+     * @param type_id 组件类型 ID
+     * @param field_index 字段下标（CORONA_SOA_COMPONENT 中的顺序）
+     * @return 字段子列指针，类型不存在或未拆分返回 nullptr
+     */
+    [[nodiscard]] void* get_field_array(ComponentTypeId type_id, std::size_t field_index);
+    [[nodiscard]] const void* get_field_array(ComponentTypeId type_id,
+                                              std::size_t field_index) const;
+
+    /**
+     * @brief 获取 SoA 组件的按字段视图
+     * @tparam T 通过 CORONA_SOA_COMPONENT 声明的组件类型
+     * @return 字段视图，类型不存在返回空视图
+     */
+    template <Component T>
+    [[nodiscard]] SoaSpan<T> get_soa_components() {
+        const auto* comp_layout = data_ ? layout_->find_component<T>() : nullptr;
+        if (!comp_layout || !comp_layout->is_split()) {
+            return {};
+        }
+        std::array<std::byte*, SoaSpan<T>::kFieldCount> columns{};
+        for (std::size_t i = 0; i < columns.size(); ++i) {
+            columns[i] = data_ + comp_layout->fields[i].array_offset;
+        }
+        return SoaSpan<T>(columns, count_);
+    }
+
+    /**
+     * @brief 将 SoA 组件的第 index 个元素聚合拷贝到 dst
+     * @param type_id 组件类型 ID
+     * @param index 实体索引
+     * @param dst 目标对象（大小为 sizeof(T)）
+     * @return 成功返回 true；类型不存在、未拆分或索引无效返回 false
+     */
+    bool read_split_component(ComponentTypeId type_id, std::size_t index, void* dst) const;
+
+    /**
+     * @brief 将 src 分散写入 SoA 组件的第 index 个元素
+     * @param type_id 组件类型 ID
+     * @param index 实体索引
+     * @param src 源对象（大小为 sizeof(T)）
+     * @return 成功返回 true；类型不存在、未拆分或索引无效返回 false
+     */
+    bool write_split_component(ComponentTypeId type_id, std::size_t index, const void* src);
+
+    // ========================================
+    // 行实体与变更版本
+    // ========================================
+
+    /// 获取第 index 行所属实体（未记录或越界返回 kInvalidEntity）
+    [[nodiscard]] EntityId entity_at(std::size_t index) const {
+        return index < count_ ? entities_[index] : kInvalidEntity;
+    }
+
+    /// 获取所有行的实体 ID（与组件数组下标一一对应）
+    [[nodiscard]] std::span<const EntityId> entities() const {
+        return std::span<const EntityId>(entities_.data(), count_);
+    }
+
+    /// 设置第 index 行所属实体
+    void set_entity(std::size_t index, EntityId entity) {
+        assert(index < count_ && "Invalid row index");
+        entities_[index] = entity;
+    }
+
+    /// 结构版本：最近一次增删行时的 tick
+    [[nodiscard]] ChangeTick structure_version() const { return structure_version_; }
+
+    /// 标记增删行（结构变化同时视为所有列变化）
+    void mark_structure_changed(ChangeTick tick) { structure_version_ = tick; }
+
+    /// 获取组件列的变更版本（column 与 layout().components 下标一致）
+    [[nodiscard]] ChangeTick column_version(std::size_t column) const {
+        return column < column_versions_.size() ? column_versions_[column] : 0;
+    }
+
+    /// 标记组件列已被写入
+    void mark_column_changed(std::size_t column, ChangeTick tick) {
+        if (column < column_versions_.size()) {
+            column_versions_[column] = tick;
+        }
+    }
+
+    /**
+     * @brief 将行数调整为 count
+     *
+     * 新增的行默认构造，多余的行析构，行实体重置为 kInvalidEntity。
+     * 用于按增量流重建 Chunk 内容。
+     *
+     * @param count 目标行数
+     * @pre count <= capacity()
+     */
+    void resize(std::size_t count);
+
     // ========================================
     // 实体槽位管理
     // ========================================
@@ -178,7 +287,7 @@ class Chunk {
     void rebind_layout(const ArchetypeLayout* new_layout) { layout_ = new_layout; }
 
    private:
-    /// 初始化内存（构造函数通用逻辑）
+    /// 初始化内存与行元数据（构造函数通用逻辑）
     void init_memory();
 
     /// 调用指定索引实体的所有组件构造函数
@@ -193,12 +302,18 @@ class Chunk {
     /// 将 src 索引的组件移动赋值到 dst 索引（dst 必须是已初始化对象）
     void move_assign_components(std::size_t dst, std::size_t src);
 
+    /// 逐字段拷贝 SoA 组件（src 与 dst 位于同一 Chunk）
+    void copy_split_fields(const ComponentLayout& comp, std::size_t dst, std::size_t src);
+
     std::byte* data_ = nullptr;                ///< 原始内存块
     std::size_t count_ = 0;                    ///< 当前实体数量
     std::size_t capacity_ = 0;                 ///< 最大实体容量
     const ArchetypeLayout* layout_ = nullptr;  ///< 组件布局（由 Archetype 持有）
     ChunkAllocator* allocator_ = nullptr;      ///< 内存分配器（nullptr 表示自分配）
     bool owns_memory_ = true;                  ///< 是否拥有内存（自分配时为 true）
+    std::vector<EntityId> entities_;           ///< 各行所属实体
+    std::vector<ChangeTick> column_versions_;  ///< 各组件列的变更版本
+    ChangeTick structure_version_ = 0;         ///< 结构变更版本
 };
 
 }  // namespace Corona::Kernel::ECS
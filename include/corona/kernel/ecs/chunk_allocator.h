@@ -2,8 +2,11 @@
 #include <cstddef>
 #include <memory>
 #include <mutex>
+#include <utility>
 #include <vector>
 
+#include "corona/kernel/memory/memory_tracker.h"
+#include "corona/kernel/memory/virtual_memory.h"
 #include "ecs_types.h"
 
 namespace Corona::Kernel::ECS {
@@ -19,6 +22,9 @@ namespace Corona::Kernel::ECS {
  * - 内存池复用：释放的 Chunk 内存会被复用
  * - 缓存行对齐：内存按 64 字节对齐
  * - 线程安全：可选的线程安全模式
+ * - 页后端：可选用 mmap/VirtualAlloc 保留 Arena 地址空间并按需提交，
+ *   HugePages 后端尽量使用大页（Arena 大小建议为大页的整数倍）
+ * - 内存追踪：已提交的 Arena 内存计入 MemoryTracker（默认 ECS 标签）
  *
  * 使用示例：
  * @code
@@ -42,9 +48,13 @@ class ChunkAllocator {
      * @param chunk_size 每个 Chunk 的大小（默认 16KB）
      * @param arena_size 每个 Arena 的大小（默认 1MB）
      * @param thread_safe 是否线程安全（默认 true）
+     * @param backend Arena 内存后端（默认堆分配）
+     * @param tag 内存计入的 MemoryTracker 标签（默认 ECS）
      */
     explicit ChunkAllocator(std::size_t chunk_size = kDefaultChunkSize,
-                            std::size_t arena_size = kDefaultArenaSize, bool thread_safe = true);
+                            std::size_t arena_size = kDefaultArenaSize, bool thread_safe = true,
+                            Kernal::Memory::PageBackend backend = Kernal::Memory::PageBackend::Heap,
+                            Kernal::Memory::MemoryTag tag = Kernal::Memory::MemoryTag::ECS);
 
     /// 析构函数
     ~ChunkAllocator();
@@ -87,6 +97,12 @@ class ChunkAllocator {
     /// 获取 Chunk 大小
     [[nodiscard]] std::size_t chunk_size() const { return chunk_size_; }
 
+    /// 获取 Arena 内存后端
+    [[nodiscard]] Kernal::Memory::PageBackend backend() const { return backend_; }
+
+    /// 获取内存计入的 MemoryTracker 标签
+    [[nodiscard]] Kernal::Memory::MemoryTag tag() const { return tag_; }
+
     /// 获取已分配的 Chunk 数量
     [[nodiscard]] std::size_t allocated_count() const;
 
@@ -102,6 +118,9 @@ class ChunkAllocator {
     /// 获取已使用内存量（字节）
     [[nodiscard]] std::size_t used_memory() const;
 
+    /// 获取已提交内存量（字节，堆后端等于 total_memory()）
+    [[nodiscard]] std::size_t committed_memory() const;
+
     // ========================================
     // 内存管理
     // ========================================
@@ -117,7 +136,8 @@ class ChunkAllocator {
     /**
      * @brief 收缩空闲内存
      *
-     * 释放完全空闲的 Arena（如果有）。
+     * 释放完全空闲的 Arena。VirtualMemory 后端下还会归还其余 Arena 中
+     * 空闲 Chunk 的物理页（保留首页存放空闲链表节点），再次分配时重新提交。
      * 这是一个优化操作，可以在内存压力大时调用。
      */
     void shrink();
@@ -130,6 +150,7 @@ class ChunkAllocator {
         std::size_t offset = 0;          ///< 当前分配偏移
         std::size_t chunk_capacity = 0;  ///< 可容纳的 Chunk 数量
         std::size_t allocated = 0;       ///< 已分配的 Chunk 数量（用于 shrink）
+        std::size_t committed = 0;       ///< 已提交字节数（页后端按需增长）
 
         Arena() = default;
         Arena(std::byte* d, std::size_t s, std::size_t cc)
@@ -139,6 +160,7 @@ class ChunkAllocator {
     /// 空闲链表节点（复用释放的 Chunk 内存）
     struct FreeNode {
         FreeNode* next = nullptr;
+        bool decommitted = false;  ///< 除首页外的物理页已被 shrink 归还
     };
 
     /// 创建新的 Arena
@@ -165,14 +187,32 @@ class ChunkAllocator {
     /// 加入空闲列表（不加锁）
     void push_free_list(void* ptr);
 
+    /// 释放 Arena 内存（不更新 MemoryTracker）
+    void release_arena(Arena& arena);
+
+    /// 释放所有 Arena 并清空空闲列表（不加锁）
+    void release_all_arenas();
+
+    /// 已提交内存量（不加锁）
+    [[nodiscard]] std::size_t committed_memory_impl() const;
+
+    /// 页后端下单个 Arena 保留的地址空间大小
+    [[nodiscard]] std::size_t reserved_arena_size() const;
+
+    /// Chunk 中 shrink 可归还的页范围 [begin, end)（不含空闲链表节点所在页）
+    [[nodiscard]] std::pair<std::byte*, std::byte*> decommit_range(void* chunk) const;
+
     std::size_t chunk_size_;           ///< Chunk 大小
     std::size_t arena_size_;           ///< Arena 大小
     std::size_t aligned_chunk_size_;   ///< 对齐后的 Chunk 大小
     bool thread_safe_;                 ///< 是否线程安全
+    Kernal::Memory::PageBackend backend_;  ///< Arena 内存后端
+    Kernal::Memory::MemoryTag tag_;        ///< MemoryTracker 标签
     std::vector<Arena> arenas_;        ///< Arena 列表
     FreeNode* free_list_ = nullptr;    ///< 空闲链表头
     std::size_t allocated_count_ = 0;  ///< 已分配 Chunk 数量
     std::size_t free_count_ = 0;       ///< 空闲 Chunk 数量
+    std::size_t decommitted_bytes_ = 0;  ///< shrink 归还的空闲 Chunk 物理页字节数
     mutable std::mutex mutex_;         ///< 线程安全锁
 };
 
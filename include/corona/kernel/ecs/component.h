@@ -1,5 +1,6 @@
 #pragma once
 #include <cstring>
+#include <span>
 #include <string_view>
 #include <type_traits>
 #include <typeindex>
@@ -7,6 +8,7 @@
 
 #include "corona/pal/cfw_platform.h"
 #include "ecs_types.h"
+#include "soa_component.h"
 
 namespace Corona::Kernel::ECS {
 
@@ -62,6 +64,15 @@ struct ComponentTypeInfo {
     /// 是否为 trivially destructible
     bool is_trivially_destructible = false;
 
+    /// SoA 拆分字段（为空表示整体存储，见 CORONA_SOA_COMPONENT）
+    std::span<const ComponentFieldInfo> fields;
+
+    /// 默认值原型（仅 SoA 组件，新槽位按字段从此拷贝）
+    const void* default_value = nullptr;
+
+    /// 是否为 SoA 拆分存储
+    [[nodiscard]] bool is_split() const { return !fields.empty(); }
+
     [[nodiscard]] bool is_valid() const { return id != kInvalidComponentTypeId && size > 0; }
 };
 
@@ -168,6 +179,11 @@ template <Component T>
             result.copy_construct = detail::copy_construct_impl<T>;
         }
 
+        if constexpr (is_soa_component_v<T>) {
+            result.fields = SoaLayout<T>::field_infos();
+            result.default_value = &SoaLayout<T>::default_value();
+        }
+
         return result;
     }();
     return info;
@@ -1,5 +1,6 @@
 #pragma once
 #include <cstddef>
+#include <cstdint>
 #include <limits>
 
 namespace Corona::Kernel::ECS {
@@ -12,6 +13,9 @@ using ArchetypeId = std::size_t;
 
 // EntityId 类定义在 entity_id.h 中
 
+/// 变更 tick（World 每帧递增，用于变更检测与增量同步）
+using ChangeTick = std::uint32_t;
+
 /// 无效的 Archetype ID
 inline constexpr ArchetypeId kInvalidArchetypeId = std::numeric_limits<ArchetypeId>::max();
 
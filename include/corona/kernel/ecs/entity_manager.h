@@ -1,5 +1,8 @@
 #pragma once
+#include <atomic>
 #include <cstddef>
+#include <mutex>
+#include <span>
 #include <vector>
 
 #include "entity_id.h"
@@ -40,12 +43,86 @@ namespace Corona::Kernel::ECS {
  * EntityId e3 = manager.create();
  * // e1 和 e3 可能有相同索引但不同版本号
  * @endcode
+ *
+ * 并发预留：
+ * - create()/destroy() 只能在拥有者线程调用，可与工作线程的预留并发进行：
+ *   空闲列表与记录数组的修改均持有预留锁，新索引统一经由原子计数器划出
+ * - reserve_id()/reserve_range() 以及 Reserver 可在工作线程并发调用，
+ *   预留的 ID 立即可用作句柄，在同步点 materialize_reserved() 之后成为存活的空实体
+ * - materialize 之前不应以 is_alive() 判断预留 ID：复用的空闲索引版本号已匹配，
+ *   立即返回 true；新索引在拥有者线程为其建立记录之前返回 false
+ * - restore()/clear() 与移动操作只能在没有进行中的预留时调用
+ *
+ * @code
+ * // 工作线程
+ * EntityManager::Reserver reserver(manager);
+ * EntityId spawned = reserver.reserve_id();
+ *
+ * // 同步点（所有 Reserver 已析构或 flush）
+ * manager.materialize_reserved();
+ * assert(manager.is_alive(spawned));
+ * @endcode
  */
 class EntityManager {
    public:
     /// 默认初始容量
     static constexpr std::size_t kDefaultInitialCapacity = 1024;
 
+    /// Reserver 每次从共享池批量获取的 ID 数量
+    static constexpr std::size_t kReserveBatchSize = 64;
+
+    /**
+     * @brief 一段连续的新索引（版本号均为 1）
+     */
+    struct ReservedRange {
+        EntityId::IndexType first = 0;  ///< 起始索引
+        std::size_t count = 0;          ///< 数量
+
+        /// 获取第 i 个 ID
+        [[nodiscard]] EntityId operator[](std::size_t i) const {
+            return EntityId(static_cast<EntityId::IndexType>(first + i), 1);
+        }
+    };
+
+    /**
+     * @brief 线程本地的 ID 预留缓存
+     *
+     * 每个工作线程（或任务）持有一个 Reserver，批量从 EntityManager
+     * 获取 ID（优先复用空闲索引，其次原子地划出新索引），之后的预留
+     * 只访问本地缓存，无需同步。析构或 flush() 时归还未使用的 ID。
+     */
+    class Reserver {
+       public:
+        explicit Reserver(EntityManager& manager, std::size_t batch_size = kReserveBatchSize);
+        ~Reserver();
+
+        Reserver(const Reserver&) = delete;
+        Reserver& operator=(const Reserver&) = delete;
+
+        /// 预留一个 ID
+        [[nodiscard]] EntityId reserve_id();
+
+        /// 预留 out.size() 个 ID
+        void reserve_ids(std::span<EntityId> out);
+
+        /// 将未使用的预留 ID 放回本地缓存
+        void release(EntityId id);
+
+        /// 将本地缓存中未使用的 ID 归还给 EntityManager
+        void flush();
+
+        /// 已交付给调用者的 ID 数量
+        [[nodiscard]] std::size_t reserved_count() const noexcept { return reserved_count_; }
+
+       private:
+        void refill();
+
+        EntityManager* manager_;
+        std::size_t batch_size_;
+        std::vector<EntityId> cache_;  ///< 本地空闲 ID（栈）
+        std::size_t reserved_count_ = 0;
+    };
+
     /// 默认构造
     EntityManager() = default;
 
@@ -56,9 +133,9 @@ class EntityManager {
     EntityManager(const EntityManager&) = delete;
     EntityManager& operator=(const EntityManager&) = delete;
 
-    // 支持移动
-    EntityManager(EntityManager&&) noexcept = default;
-    EntityManager& operator=(EntityManager&&) noexcept = default;
+    // 支持移动（不得有进行中的预留）
+    EntityManager(EntityManager&& other) noexcept;
+    EntityManager& operator=(EntityManager&& other) noexcept;
 
     ~EntityManager() = default;
 
@@ -70,7 +147,8 @@ class EntityManager {
      * @brief 创建新实体
      *
      * 分配一个新的 EntityId。如果有可复用的索引，优先使用；
-     * 否则扩展记录数组。
+     * 否则从新索引计数器划出一个索引并扩展记录数组。
+     * 存在待 materialize 的预留时先调用 materialize_reserved()。
      *
      * @return 新创建实体的 ID
      */
@@ -142,6 +220,54 @@ class EntityManager {
     [[nodiscard]] EntityId find_entity_at(ArchetypeId archetype_id,
                                           const EntityLocation& location) const;
 
+    /**
+     * @brief 按给定 ID 恢复实体记录
+     *
+     * 用于从增量流（WorldDelta）重建副本：直接以源 World 的 ID
+     * （含版本号）写入记录，必要时扩展记录数组。若该索引原本处于
+     * 空闲状态，会从空闲列表移除并计入存活数量。
+     *
+     * @param id 源实体 ID
+     * @param archetype_id 所属 Archetype ID
+     * @param location 位置
+     * @return ID 无效返回 false
+     */
+    bool restore(EntityId id, ArchetypeId archetype_id, const EntityLocation& location);
+
+    // ========================================
+    // 并发预留
+    // ========================================
+
+    /**
+     * @brief 并发预留一个 ID（线程安全）
+     *
+     * 优先复用空闲索引，否则原子地分配新索引。
+     * 高频调用请使用 Reserver 以避免每次加锁。
+     *
+     * @return 预留的实体 ID
+     */
+    [[nodiscard]] EntityId reserve_id();
+
+    /**
+     * @brief 并发预留一段连续的新索引（线程安全，无锁）
+     * @param count 数量
+     * @return 预留的索引范围
+     */
+    [[nodiscard]] ReservedRange reserve_range(std::size_t count);
+
+    /**
+     * @brief 同步点：为所有已预留的 ID 建立记录
+     *
+     * 调用后预留的 ID 变为存活的空实体，未使用而被归还的 ID 进入空闲列表。
+     * create() 会在需要时自动调用。
+     */
+    void materialize_reserved();
+
+    /// 是否存在尚未 materialize 的预留
+    [[nodiscard]] bool has_pending_reservations() const noexcept {
+        return reservations_pending_.load(std::memory_order_acquire);
+    }
+
     // ========================================
     // 统计信息
     // ========================================
@@ -168,9 +294,26 @@ class EntityManager {
     /// 验证 ID 有效性（仅检查边界和版本号）
     [[nodiscard]] bool is_valid_id(EntityId id) const;
 
+    /// materialize_reserved() 的实现（需持有 reserve_mutex_）
+    void materialize_reserved_locked();
+
+    /// 从空闲列表与新索引中取出最多 count 个 ID 追加到 out（线程安全）
+    void take_reserved(std::vector<EntityId>& out, std::size_t count);
+
+    /// 归还未使用的预留 ID（线程安全）
+    void return_reserved(std::span<const EntityId> ids);
+
     std::vector<EntityRecord> records_;           ///< 实体记录数组
     std::vector<EntityId::IndexType> free_list_;  ///< 空闲索引列表
     std::size_t alive_count_ = 0;                 ///< 存活实体计数
+
+    std::atomic<std::size_t> next_index_{0};          ///< 下一个新索引（>= records_.size()）
+    std::atomic<bool> reservations_pending_{false};   ///< 是否有待 materialize 的预留
+    std::mutex reserve_mutex_;                        ///< 保护 free_list_、records_ 的扩展与归还列表
+    std::size_t recycled_taken_ = 0;                  ///< 预留期间从空闲列表取出的数量
+    std::vector<EntityId> returned_;                  ///< 预留后未使用而归还的 ID
+    std::size_t accounted_end_ = 0;             ///< 此前的新索引均已计入 alive_count_ 或空闲列表
+    std::size_t created_beyond_accounted_ = 0;  ///< create() 在 accounted_end_ 之后分配的新索引数（已计入）
 };
 
 }  // namespace Corona::Kernel::ECS
@@ -0,0 +1,236 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <limits>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace Corona::Kernel::ECS {
+
+/**
+ * @brief 组件字段信息
+ *
+ * 描述 SoA 拆分组件中单个字段在结构体内的位置，
+ * ArchetypeLayout 据此为每个字段分配独立的子列。
+ */
+struct ComponentFieldInfo {
+    std::size_t offset = 0;     ///< 字段在组件结构体内的偏移
+    std::size_t size = 0;       ///< sizeof(字段)
+    std::size_t alignment = 0;  ///< alignof(字段)
+};
+
+namespace detail {
+
+/// 成员指针类型萃取
+template <typename M>
+struct MemberPointerTraits;
+
+template <typename C, typename F>
+struct MemberPointerTraits<F C::*> {
+    using ClassType = C;
+    using FieldType = F;
+};
+
+/// 判断两个成员指针是否指向同一字段
+template <auto A, auto B>
+[[nodiscard]] constexpr bool same_member() {
+    if constexpr (std::is_same_v<decltype(A), decltype(B)>) {
+        return A == B;
+    } else {
+        return false;
+    }
+}
+
+/// 查找成员指针在列表中的下标，未找到返回 npos
+template <auto Member, auto... Members>
+[[nodiscard]] constexpr std::size_t member_index() {
+    constexpr std::array<bool, sizeof...(Members)> matches{same_member<Member, Members>()...};
+    for (std::size_t i = 0; i < matches.size(); ++i) {
+        if (matches[i]) {
+            return i;
+        }
+    }
+    return std::numeric_limits<std::size_t>::max();
+}
+
+}  // namespace detail
+
+/**
+ * @brief SoA 拆分布局描述
+ *
+ * 默认不拆分。通过 CORONA_SOA_COMPONENT 宏特化后，组件的每个字段
+ * 会在 Chunk 内占据独立的连续子列：
+ *
+ * ```
+ * 普通存储：[x0 y0 z0][x1 y1 z1]...
+ * SoA 拆分：[x0 x1 ... xN][y0 y1 ... yN][z0 z1 ... zN]
+ * ```
+ *
+ * @tparam T 组件类型
+ */
+template <typename T>
+struct SoaLayout {
+    static constexpr bool kEnabled = false;
+};
+
+/**
+ * @brief SoA 拆分布局实现（由 CORONA_SOA_COMPONENT 使用）
+ *
+ * @tparam Members 参与拆分的成员指针列表，必须属于同一结构体
+ */
+template <auto... Members>
+struct SoaFields {
+    static_assert(sizeof...(Members) > 0, "SoA component requires at least one field");
+
+    using ComponentType =
+        typename detail::MemberPointerTraits<std::tuple_element_t<0, std::tuple<decltype(Members)...>>>::ClassType;
+
+    static_assert((std::is_same_v<typename detail::MemberPointerTraits<decltype(Members)>::ClassType, ComponentType> &&
+                   ...),
+                  "All SoA fields must belong to the same component type");
+    static_assert(std::is_trivially_copyable_v<ComponentType> && std::is_trivially_destructible_v<ComponentType>,
+                  "SoA component must be trivially copyable and trivially destructible");
+
+    static constexpr bool kEnabled = true;
+    static constexpr std::size_t kFieldCount = sizeof...(Members);
+
+    /// 第 I 个字段的类型
+    template <std::size_t I>
+    using FieldType = typename detail::MemberPointerTraits<
+        std::tuple_element_t<I, std::tuple<decltype(Members)...>>>::FieldType;
+
+    /// 第 I 个字段的成员指针
+    template <std::size_t I>
+    static constexpr auto member() {
+        return std::get<I>(std::make_tuple(Members...));
+    }
+
+    /// 指定成员在字段列表中的下标
+    template <auto Member>
+    static constexpr std::size_t kIndexOf = detail::member_index<Member, Members...>();
+
+    /// 字段信息表（顺序与 Members 一致）
+    [[nodiscard]] static const std::array<ComponentFieldInfo, kFieldCount>& field_infos() {
+        static const std::array<ComponentFieldInfo, kFieldCount> infos = []() {
+            const ComponentType& probe = default_value();
+            const auto* base = reinterpret_cast<const std::byte*>(&probe);
+            return std::array<ComponentFieldInfo, kFieldCount>{ComponentFieldInfo{
+                static_cast<std::size_t>(reinterpret_cast<const std::byte*>(&(probe.*Members)) - base),
+                sizeof(probe.*Members), alignof(typename detail::MemberPointerTraits<decltype(Members)>::FieldType)}...};
+        }();
+        return infos;
+    }
+
+    /// 默认构造的原型值（新槽位按字段从此拷贝）
+    [[nodiscard]] static const ComponentType& default_value() {
+        static const ComponentType value{};
+        return value;
+    }
+};
+
+/// 组件是否启用了 SoA 拆分
+template <typename T>
+inline constexpr bool is_soa_component_v = SoaLayout<T>::kEnabled;
+
+/**
+ * @brief SoA 组件的按字段视图
+ *
+ * 由 Chunk::get_soa_components() 和 World::each_chunk() 提供，
+ * 每个字段以独立的 std::span 暴露，便于编译器对单个字段向量化。
+ *
+ * 示例：
+ * @code
+ * world.each_chunk<Position, Velocity>([](std::size_t count, SoaSpan<Position> pos,
+ *                                         SoaSpan<Velocity> vel) {
+ *     auto x = pos.get<&Position::x>();
+ *     auto vx = vel.get<&Velocity::vx>();
+ *     for (std::size_t i = 0; i < count; ++i) {
+ *         x[i] += vx[i];
+ *     }
+ * });
+ * @endcode
+ *
+ * @tparam T SoA 组件类型
+ */
+template <typename T>
+class SoaSpan {
+   public:
+    using Layout = SoaLayout<T>;
+    static_assert(Layout::kEnabled, "SoaSpan requires a CORONA_SOA_COMPONENT type");
+
+    static constexpr std::size_t kFieldCount = Layout::kFieldCount;
+
+    SoaSpan() = default;
+    SoaSpan(const std::array<std::byte*, kFieldCount>& columns, std::size_t count)
+        : columns_(columns), count_(count) {}
+
+    /// 元素数量
+    [[nodiscard]] std::size_t size() const { return count_; }
+
+    /// 是否为空
+    [[nodiscard]] bool empty() const { return count_ == 0; }
+
+    /// 按下标获取字段子列
+    template <std::size_t I>
+    [[nodiscard]] std::span<typename Layout::template FieldType<I>> field() const {
+        using F = typename Layout::template FieldType<I>;
+        return std::span<F>(reinterpret_cast<F*>(columns_[I]), count_);
+    }
+
+    /// 按成员指针获取字段子列
+    template <auto Member>
+    [[nodiscard]] auto get() const {
+        constexpr std::size_t index = Layout::template kIndexOf<Member>;
+        static_assert(index < kFieldCount, "Member is not a SoA field of this component");
+        return field<index>();
+    }
+
+    /// 聚合读取第 i 个元素
+    [[nodiscard]] T load(std::size_t i) const {
+        T value{};
+        load_impl(value, i, std::make_index_sequence<kFieldCount>{});
+        return value;
+    }
+
+    /// 分散写入第 i 个元素
+    void store(std::size_t i, const T& value) const {
+        store_impl(value, i, std::make_index_sequence<kFieldCount>{});
+    }
+
+   private:
+    template <std::size_t... Is>
+    void load_impl(T& value, std::size_t i, std::index_sequence<Is...>) const {
+        ((value.*(Layout::template member<Is>()) = field<Is>()[i]), ...);
+    }
+
+    template <std::size_t... Is>
+    void store_impl(const T& value, std::size_t i, std::index_sequence<Is...>) const {
+        ((field<Is>()[i] = value.*(Layout::template member<Is>())), ...);
+    }
+
+    std::array<std::byte*, kFieldCount> columns_{};
+    std::size_t count_ = 0;
+};
+
+/**
+ * @brief 将组件声明为 SoA 拆分存储
+ *
+ * 必须在全局命名空间使用，且在该组件首次用于 Archetype 之前可见。
+ * 拆分后的组件不再有连续的 T 对象，不能通过 get_component() 取指针，
+ * 需改用 read_component()/set_component() 或 each_chunk() 的字段视图。
+ *
+ * @code
+ * struct Position { float x, y, z; };
+ * CORONA_SOA_COMPONENT(Position, &Position::x, &Position::y, &Position::z);
+ * @endcode
+ */
+#define CORONA_SOA_COMPONENT(Type, ...)                     \
+    template <>                                             \
+    struct Corona::Kernel::ECS::SoaLayout<Type>             \
+        : Corona::Kernel::ECS::SoaFields<__VA_ARGS__> {     \
+        static_assert(std::is_same_v<ComponentType, Type>); \
+    }
+
+}  // namespace Corona::Kernel::ECS
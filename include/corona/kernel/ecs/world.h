@@ -1,12 +1,49 @@
 #pragma once
+#include <array>
 #include <memory>
+#include <optional>
 #include <unordered_map>
+#include <utility>
 
 #include "archetype.h"
 #include "entity_manager.h"
 
 namespace Corona::Kernel::ECS {
 
+/// each_chunk 传给回调的组件视图：SoA 组件为 SoaSpan<T>，其余为 std::span<T>
+template <Component T>
+using ChunkView = std::conditional_t<is_soa_component_v<T>, SoaSpan<T>, std::span<T>>;
+
+namespace detail {
+
+/// 获取 Chunk 内指定组件的视图
+template <Component T>
+[[nodiscard]] ChunkView<T> chunk_view(Chunk& chunk) {
+    if constexpr (is_soa_component_v<T>) {
+        return chunk.template get_soa_components<T>();
+    } else {
+        return chunk.template get_components<T>();
+    }
+}
+
+/// 查询组件在 Archetype 布局中的列下标（每个 Archetype 只需计算一次）
+template <Component... Ts>
+[[nodiscard]] std::array<std::size_t, sizeof...(Ts)> column_indices(const ArchetypeLayout& layout) {
+    return {static_cast<std::size_t>(
+        layout.component_index(get_component_type_id<std::remove_const_t<Ts>>()))...};
+}
+
+/// 将遍历中以非 const 方式访问的组件列标记为已变更
+template <Component... Ts>
+void mark_written_columns(Chunk& chunk, const std::array<std::size_t, sizeof...(Ts)>& columns,
+                          ChangeTick tick) {
+    [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+        ((std::is_const_v<Ts> ? void() : chunk.mark_column_changed(columns[Is], tick)), ...);
+    }(std::index_sequence_for<Ts...>{});
+}
+
+}  // namespace detail
+
 /**
  * @brief ECS 世界
  *
@@ -39,6 +76,12 @@ namespace Corona::Kernel::ECS {
  * // 销毁实体
  * world.destroy_entity(entity);
  * @endcode
+ *
+ * 变更追踪：
+ * - World 维护单调递增的 change tick，由 advance_tick() 推进
+ * - 增删行时记录 Chunk 的结构版本，可写访问组件时记录对应列的版本
+ * - 遍历接口中以 const 类型查询（如 each<const Position>）不会标记列变更
+ * - WorldDelta 据此只编码相对基线 tick 发生变化的 Chunk 和列
  */
 class World {
    public:
@@ -139,6 +182,9 @@ class World {
     /**
      * @brief 获取组件
      *
+     * SoA 拆分组件（CORONA_SOA_COMPONENT）没有连续对象，不能取指针，
+     * 请改用 read_component() / set_component()。
+     *
      * @tparam T 组件类型
      * @param entity 实体 ID
      * @return 组件指针，不存在返回 nullptr
@@ -149,6 +195,18 @@ class World {
     template <Component T>
     [[nodiscard]] const T* get_component(EntityId entity) const;
 
+    /**
+     * @brief 读取组件副本
+     *
+     * 对所有组件可用；SoA 拆分组件会从各字段子列聚合出完整对象。
+     *
+     * @tparam T 组件类型（需可拷贝构造）
+     * @param entity 实体 ID
+     * @return 组件副本，不存在返回 nullopt
+     */
+    template <Component T>
+    [[nodiscard]] std::optional<T> read_component(EntityId entity) const;
+
     /**
      * @brief 设置组件值
      *
@@ -193,6 +251,45 @@ class World {
     template <Component... Ts, typename Func>
     void each(Func&& func);
 
+    /**
+     * @brief 遍历具有指定组件的所有实体（Chunk 预取模式）
+     *
+     * 语义与 each() 相同。区别在于处理当前 Chunk 时会预取下一个 Chunk
+     * 的对象头和所查询组件数组的头部，并通过 Archetype::chunk_data()
+     * 的扁平地址数组定位组件数组。适合 Chunk 数量多、遍历在 Chunk
+     * 边界处受访存延迟限制的大型 World。
+     *
+     * @tparam Ts 组件类型列表
+     * @tparam Func 回调函数类型
+     * @param func 回调函数，签名为 void(Ts&...)
+     */
+    template <Component... Ts, typename Func>
+    void each_prefetched(Func&& func);
+
+    /**
+     * @brief 按 Chunk 遍历具有指定组件的所有实体
+     *
+     * 每个非空 Chunk 调用一次回调。普通组件以 std::span<T> 传入，
+     * SoA 拆分组件以 SoaSpan<T> 传入（每个字段一个 span），
+     * 便于对单个字段做向量化处理。
+     *
+     * @tparam Ts 组件类型列表
+     * @tparam Func 回调函数类型
+     * @param func 回调函数，签名为 void(std::size_t count, ChunkView<Ts>...)
+     *
+     * @code
+     * world.each_chunk<Position, Velocity>(
+     *     [](std::size_t count, SoaSpan<Position> pos, std::span<Velocity> vel) {
+     *         auto x = pos.get<&Position::x>();
+     *         for (std::size_t i = 0; i < count; ++i) {
+     *             x[i] += vel[i].vx;
+     *         }
+     *     });
+     * @endcode
+     */
+    template <Component... Ts, typename Func>
+    void each_chunk(Func&& func);
+
     /**
      * @brief 遍历具有指定组件的所有实体（带 EntityId）
      *
@@ -203,6 +300,22 @@ class World {
     template <Component... Ts, typename Func>
     void each_with_entity(Func&& func);
 
+    // ========================================
+    // 变更追踪
+    // ========================================
+
+    /// 获取当前 change tick（本帧内的写入都会记录为此版本）
+    [[nodiscard]] ChangeTick change_tick() const { return change_tick_; }
+
+    /**
+     * @brief 推进 change tick
+     *
+     * 通常在每帧（或每次编码增量）之后调用，使后续写入带上新的版本。
+     *
+     * @return 推进后的 tick
+     */
+    ChangeTick advance_tick() { return ++change_tick_; }
+
     // ========================================
     // 统计信息
     // ========================================
@@ -218,6 +331,8 @@ class World {
     [[nodiscard]] const EntityManager& entity_manager() const { return entity_manager_; }
 
    private:
+    friend class WorldDelta;
+
     /// 获取或创建 Archetype
     Archetype* get_or_create_archetype(const ArchetypeSignature& signature);
 
@@ -235,11 +350,30 @@ class World {
     void handle_swap_and_pop(ArchetypeId archetype_id, const EntityLocation& from,
                              const EntityLocation& to);
 
+    /// 释放实体槽位，标记结构变更并处理 swap-and-pop
+    void release_slot(Archetype& archetype, const EntityLocation& location);
+
+    /// 标记指定位置所在 Chunk 的结构变更
+    void mark_structure_changed(Archetype& archetype, const EntityLocation& location) {
+        archetype.get_chunk(location.chunk_index).mark_structure_changed(change_tick_);
+    }
+
+    /// 标记指定位置所在 Chunk 的组件列变更
+    void mark_column_changed(Archetype& archetype, const EntityLocation& location,
+                             ComponentTypeId type_id) {
+        auto column = archetype.layout().component_index(type_id);
+        if (column >= 0) {
+            archetype.get_chunk(location.chunk_index)
+                .mark_column_changed(static_cast<std::size_t>(column), change_tick_);
+        }
+    }
+
     EntityManager entity_manager_;  ///< 实体管理器
     std::unordered_map<std::size_t, std::unique_ptr<Archetype>>
         archetypes_;                                               ///< Archetype 存储（key = signature hash）
     std::unordered_map<ArchetypeId, Archetype*> archetype_by_id_;  ///< ID -> Archetype 映射
     ArchetypeId next_archetype_id_ = 0;                            ///< Archetype ID 分配器
+    ChangeTick change_tick_ = 1;                                   ///< 当前变更版本（0 保留为"从未变更"）
 };
 
 // ========================================
@@ -272,7 +406,8 @@ EntityId World::create_entity(Ts&&... components) {
     EntityId entity = entity_manager_.create();
 
     // 在 Archetype 中分配槽位
-    EntityLocation location = archetype->allocate_entity();
+    EntityLocation location = archetype->allocate_entity(entity);
+    mark_structure_changed(*archetype, location);
 
     // 更新实体记录
     entity_manager_.update_location(entity, archetype->id(), location);
@@ -318,22 +453,16 @@ bool World::add_component(EntityId entity, T&& component) {
     }
 
     // 在目标 Archetype 分配新槽位
-    EntityLocation new_location = target_archetype->allocate_entity();
+    EntityLocation new_location = target_archetype->allocate_entity(entity);
+    mark_structure_changed(*target_archetype, new_location);
 
     // 如果有旧 Archetype，拷贝共有组件
     if (current_archetype) {
         copy_common_components(*current_archetype, record->location, *target_archetype,
                                new_location);
 
-        // 从旧 Archetype 释放
-        ArchetypeId arch_id = current_archetype->id();
-        EntityLocation old_loc = record->location;
-        auto moved_from = current_archetype->deallocate_entity(old_loc);
-
-        // 处理 swap-and-pop 影响
-        if (moved_from.has_value()) {
-            handle_swap_and_pop(arch_id, *moved_from, old_loc);
-        }
+        // 从旧 Archetype 释放（处理 swap-and-pop 影响）
+        release_slot(*current_archetype, record->location);
     }
 
     // 设置新组件
@@ -369,12 +498,7 @@ bool World::remove_component(EntityId entity) {
 
     if (new_signature.empty()) {
         // 移除所有组件，实体变为空实体
-        ArchetypeId arch_id = current_archetype->id();
-        EntityLocation old_loc = record->location;
-        auto moved_from = current_archetype->deallocate_entity(old_loc);
-        if (moved_from.has_value()) {
-            handle_swap_and_pop(arch_id, *moved_from, old_loc);
-        }
+        release_slot(*current_archetype, record->location);
         record->archetype_id = kInvalidArchetypeId;
         record->location = EntityLocation{};
         return true;
@@ -387,18 +511,14 @@ bool World::remove_component(EntityId entity) {
     }
 
     // 在目标 Archetype 分配新槽位
-    EntityLocation new_location = target_archetype->allocate_entity();
+    EntityLocation new_location = target_archetype->allocate_entity(entity);
+    mark_structure_changed(*target_archetype, new_location);
 
     // 拷贝共有组件（不包括被移除的）
     copy_common_components(*current_archetype, record->location, *target_archetype, new_location);
 
     // 从旧 Archetype 释放
-    ArchetypeId arch_id = current_archetype->id();
-    EntityLocation old_loc = record->location;
-    auto moved_from = current_archetype->deallocate_entity(old_loc);
-    if (moved_from.has_value()) {
-        handle_swap_and_pop(arch_id, *moved_from, old_loc);
-    }
+    release_slot(*current_archetype, record->location);
 
     // 更新实体记录
     entity_manager_.update_location(entity, target_archetype->id(), new_location);
@@ -408,6 +528,8 @@ bool World::remove_component(EntityId entity) {
 
 template <Component T>
 T* World::get_component(EntityId entity) {
+    static_assert(!is_soa_component_v<T>, "SoA component has no addressable object, use read_component");
+
     if (!is_alive(entity)) {
         return nullptr;
     }
@@ -422,22 +544,89 @@ T* World::get_component(EntityId entity) {
         return nullptr;
     }
 
-    return archetype->get_component<T>(record->location);
+    T* comp = archetype->get_component<T>(record->location);
+    if (comp) {
+        // 可写访问视为写入
+        mark_column_changed(*archetype, record->location, get_component_type_id<T>());
+    }
+    return comp;
 }
 
 template <Component T>
 const T* World::get_component(EntityId entity) const {
-    return const_cast<World*>(this)->get_component<T>(entity);
+    static_assert(!is_soa_component_v<T>, "SoA component has no addressable object, use read_component");
+
+    if (!is_alive(entity)) {
+        return nullptr;
+    }
+
+    const auto* record = entity_manager_.get_record(entity);
+    if (!record) {
+        return nullptr;
+    }
+
+    const Archetype* archetype = get_archetype(record->archetype_id);
+    if (!archetype) {
+        return nullptr;
+    }
+
+    return archetype->get_component<T>(record->location);
+}
+
+template <Component T>
+std::optional<T> World::read_component(EntityId entity) const {
+    if (!is_alive(entity)) {
+        return std::nullopt;
+    }
+
+    const auto* record = entity_manager_.get_record(entity);
+    if (!record) {
+        return std::nullopt;
+    }
+
+    const Archetype* archetype = get_archetype(record->archetype_id);
+    if (!archetype) {
+        return std::nullopt;
+    }
+
+    if constexpr (is_soa_component_v<T>) {
+        T value{};
+        if (!archetype->read_split_component(record->location, get_component_type_id<T>(), &value)) {
+            return std::nullopt;
+        }
+        return value;
+    } else {
+        const T* comp = archetype->get_component<T>(record->location);
+        if (!comp) {
+            return std::nullopt;
+        }
+        return *comp;
+    }
 }
 
 template <Component T>
 bool World::set_component(EntityId entity, T&& component) {
-    T* comp = get_component<T>(entity);
-    if (!comp) {
-        return false;
+    using U = std::remove_cvref_t<T>;
+    if constexpr (is_soa_component_v<U>) {
+        auto* record = is_alive(entity) ? entity_manager_.get_record(entity) : nullptr;
+        Archetype* archetype = record ? get_archetype(record->archetype_id) : nullptr;
+        if (!archetype) {
+            return false;
+        }
+        if (!archetype->write_split_component(record->location, get_component_type_id<U>(),
+                                              &component)) {
+            return false;
+        }
+        mark_column_changed(*archetype, record->location, get_component_type_id<U>());
+        return true;
+    } else {
+        U* comp = get_component<U>(entity);
+        if (!comp) {
+            return false;
+        }
+        *comp = std::forward<T>(component);
+        return true;
     }
-    *comp = std::forward<T>(component);
-    return true;
 }
 
 template <Component T>
@@ -461,6 +650,8 @@ bool World::has_component(EntityId entity) const {
 
 template <Component... Ts, typename Func>
 void World::each(Func&& func) {
+    static_assert((!is_soa_component_v<Ts> && ...), "SoA components must be iterated with each_chunk");
+
     // 构建查询签名
     auto required = ArchetypeSignature::create<Ts...>();
 
@@ -470,6 +661,8 @@ void World::each(Func&& func) {
             continue;
         }
 
+        const auto columns = detail::column_indices<Ts...>(archetype->layout());
+
         // 遍历该 Archetype 的所有 Chunk
         for (std::size_t chunk_idx = 0; chunk_idx < archetype->chunk_count(); ++chunk_idx) {
             auto& chunk = archetype->get_chunk(chunk_idx);
@@ -479,8 +672,10 @@ void World::each(Func&& func) {
                 continue;
             }
 
+            detail::mark_written_columns<Ts...>(chunk, columns, change_tick_);
+
             // 获取组件数组
-            auto components = std::make_tuple(chunk.get_components<Ts>()...);
+            auto components = std::make_tuple(chunk.template get_components<Ts>()...);
 
             // 遍历实体
             for (std::size_t i = 0; i < count; ++i) {
@@ -490,8 +685,80 @@ void World::each(Func&& func) {
     }
 }
 
+template <Component... Ts, typename Func>
+void World::each_prefetched(Func&& func) {
+    static_assert((!is_soa_component_v<Ts> && ...), "SoA components must be iterated with each_chunk");
+
+    // 构建查询签名
+    auto required = ArchetypeSignature::create<Ts...>();
+
+    // 遍历所有匹配的 Archetype
+    for (auto& [hash, archetype] : archetypes_) {
+        if (!archetype->signature().contains_all(required)) {
+            continue;
+        }
+
+        // 每个 Archetype 只查找一次组件数组偏移，逐 Chunk 只需做地址加法
+        const auto& layout = archetype->layout();
+        const std::array<std::size_t, sizeof...(Ts)> offsets{static_cast<std::size_t>(
+            layout.get_array_offset(get_component_type_id<std::remove_const_t<Ts>>()))...};
+        const auto columns = detail::column_indices<Ts...>(layout);
+
+        auto chunk_data = archetype->chunk_data();
+        archetype->prefetch_chunk(0, offsets);
+
+        for (std::size_t chunk_idx = 0; chunk_idx < chunk_data.size(); ++chunk_idx) {
+            // 处理当前 Chunk 期间预取下一个 Chunk
+            archetype->prefetch_chunk(chunk_idx + 1, offsets);
+
+            auto& chunk = archetype->get_chunk(chunk_idx);
+            auto count = chunk.size();
+            std::byte* base = chunk_data[chunk_idx];
+            if (count == 0 || !base) {
+                continue;
+            }
+
+            detail::mark_written_columns<Ts...>(chunk, columns, change_tick_);
+
+            [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+                auto arrays = std::make_tuple(reinterpret_cast<Ts*>(base + offsets[Is])...);
+                for (std::size_t i = 0; i < count; ++i) {
+                    func(std::get<Is>(arrays)[i]...);
+                }
+            }(std::index_sequence_for<Ts...>{});
+        }
+    }
+}
+
+template <Component... Ts, typename Func>
+void World::each_chunk(Func&& func) {
+    // 构建查询签名
+    auto required = ArchetypeSignature::create<Ts...>();
+
+    // 遍历所有匹配的 Archetype
+    for (auto& [hash, archetype] : archetypes_) {
+        if (!archetype->signature().contains_all(required)) {
+            continue;
+        }
+
+        const auto columns = detail::column_indices<Ts...>(archetype->layout());
+
+        for (auto& chunk : archetype->chunks()) {
+            auto count = chunk.size();
+            if (count == 0) {
+                continue;
+            }
+
+            detail::mark_written_columns<Ts...>(chunk, columns, change_tick_);
+            func(count, detail::chunk_view<Ts>(chunk)...);
+        }
+    }
+}
+
 template <Component... Ts, typename Func>
 void World::each_with_entity(Func&& func) {
+    static_assert((!is_soa_component_v<Ts> && ...), "SoA components must be iterated with each_chunk");
+
     // 构建查询签名
     auto required = ArchetypeSignature::create<Ts...>();
 
@@ -501,6 +768,8 @@ void World::each_with_entity(Func&& func) {
             continue;
         }
 
+        const auto columns = detail::column_indices<Ts...>(archetype->layout());
+
         // 遍历该 Archetype 的所有 Chunk
         for (std::size_t chunk_idx = 0; chunk_idx < archetype->chunk_count(); ++chunk_idx) {
             auto& chunk = archetype->get_chunk(chunk_idx);
@@ -510,14 +779,15 @@ void World::each_with_entity(Func&& func) {
                 continue;
             }
 
-            // 获取组件数组
-            auto components = std::make_tuple(chunk.get_components<Ts>()...);
+            detail::mark_written_columns<Ts...>(chunk, columns, change_tick_);
+
+            // 获取组件数组与行实体
+            auto components = std::make_tuple(chunk.template get_components<Ts>()...);
+            auto entities = chunk.entities();
 
             // 遍历实体
             for (std::size_t i = 0; i < count; ++i) {
-                // 注意：此处无法直接获取 EntityId，需要 Chunk 存储实体 ID
-                // 暂时传递无效 ID，后续需要扩展 Chunk 存储
-                func(kInvalidEntity, std::get<std::span<Ts>>(components)[i]...);
+                func(entities[i], std::get<std::span<Ts>>(components)[i]...);
             }
         }
     }
@@ -531,9 +801,13 @@ namespace detail {
 
 template <Component T>
 void set_component_at(Archetype& archetype, const EntityLocation& location, T&& value) {
-    T* comp = archetype.get_component<T>(location);
-    if (comp) {
-        *comp = std::forward<T>(value);
+    if constexpr (is_soa_component_v<T>) {
+        archetype.write_split_component(location, get_component_type_id<T>(), &value);
+    } else {
+        T* comp = archetype.get_component<T>(location);
+        if (comp) {
+            *comp = std::forward<T>(value);
+        }
     }
 }
 
@@ -556,6 +830,18 @@ inline void copy_common_components(Archetype& src, const EntityLocation& src_loc
             continue;  // 目标没有此组件
         }
 
+        if (src_comp.is_split()) {
+            // SoA 组件逐字段拷贝（字段顺序由类型决定，两侧一致）
+            for (std::size_t f = 0; f < src_comp.fields.size(); ++f) {
+                void* src_field = src.get_field(src_loc, src_comp.type_id, f);
+                void* dst_field = dst.get_field(dst_loc, src_comp.type_id, f);
+                if (src_field && dst_field) {
+                    std::memcpy(dst_field, src_field, src_comp.fields[f].size);
+                }
+            }
+            continue;
+        }
+
         void* src_ptr = src.get_component(src_loc, src_comp.type_id);
         void* dst_ptr = dst.get_component(dst_loc, src_comp.type_id);
 
@@ -0,0 +1,87 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "world.h"
+
+namespace Corona::Kernel::ECS {
+
+/**
+ * @brief World 增量编解码
+ *
+ * 根据 Chunk 的结构版本和组件列版本，把相对基线 tick 发生变化的数据
+ * 编码为紧凑的二进制流，并可应用到另一个 World（副本）上。
+ * 用于回放录制和本地观战进程的逐帧同步。
+ *
+ * 编码规则（每个发生变化的 Chunk 一条记录）：
+ * - 结构版本 > baseline：全量记录（行数、行实体 ID、所有可复制列）
+ * - 仅列版本 > baseline：列记录（只包含变化的可复制列）
+ * - 未变化的 Chunk 和 Archetype 不产生任何数据
+ *
+ * 流格式（本机字节序）：
+ * ```
+ * Header   : magic u32 | version u16 | reserved u16 | baseline u32 | tick u32 | archetype_count u32
+ * Archetype: component_count u32 | { type_id u64 | size u32 | replicated u8 }...
+ *            chunk_count u32 | record_count u32 | ChunkRecord...
+ * Chunk    : chunk_index u32 | op u8 | row_count u32 | [entity u64 × rows] (仅全量)
+ *            column_count u32 | { column u32 | data }...
+ * ```
+ * SoA 拆分组件的列数据按字段子列依次写出。
+ *
+ * 限制：
+ * - 只复制平凡可拷贝（trivially copyable）的组件，其余组件不同步（新增行为默认构造）
+ * - 没有任何组件的空实体不属于 Archetype，不会被复制
+ * - 组件类型 ID 基于 typeid，流只能在同一构建产物之间传递
+ * - 副本应视为只读：应用增量会直接写入源 World 的实体 ID
+ *
+ * 示例：
+ * @code
+ * ChangeTick baseline = 0;
+ * std::vector<std::byte> stream;
+ *
+ * // 每帧
+ * stream.clear();
+ * WorldDelta::encode(world, baseline, stream);
+ * baseline = world.change_tick();
+ * world.advance_tick();
+ *
+ * // 接收端
+ * WorldDelta::apply(replica, stream);
+ * @endcode
+ */
+class WorldDelta {
+   public:
+    /// 流魔数（"CWDL"）
+    static constexpr std::uint32_t kMagic = 0x4C445743;
+
+    /// 流格式版本
+    static constexpr std::uint16_t kVersion = 1;
+
+    /**
+     * @brief 编码相对基线 tick 的增量
+     *
+     * baseline 为 0 时输出所有非空 Chunk，即完整快照。
+     *
+     * @param world 源 World
+     * @param baseline 接收端已同步到的 tick（只编码版本大于它的数据）
+     * @param out 输出缓冲区（追加写入）
+     * @return 写出的 Chunk 记录数量
+     */
+    static std::size_t encode(const World& world, ChangeTick baseline, std::vector<std::byte>& out);
+
+    /**
+     * @brief 将增量流应用到副本 World
+     *
+     * 组件类型必须已在本进程注册且大小一致。
+     * 失败时副本可能处于部分应用的状态，应重新从完整快照同步。
+     *
+     * @param world 副本 World
+     * @param data 由 encode() 生成的数据
+     * @return 成功返回 true；流损坏、组件类型未注册或布局不一致返回 false
+     */
+    static bool apply(World& world, std::span<const std::byte> data);
+};
+
+}  // namespace Corona::Kernel::ECS
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <functional>
+#include <map>
+#include <memory_resource>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "frame_arena.h"
+#include "linear_arena.h"
+
+namespace Corona::Kernal::Memory {
+
+/// LinearArena 的 std::pmr::memory_resource 适配器
+///
+/// - 分配从 LinearArena 线性推进，deallocate 对 Arena 内的指针为空操作
+/// - Arena 空间不足时转交上游资源（默认 null_memory_resource，即抛出 std::bad_alloc）
+/// - 上游分配的内存在 deallocate 时正常归还
+///
+/// @note 容器必须在 Arena reset() 之前销毁或放弃使用
+class ArenaResource : public std::pmr::memory_resource {
+   public:
+    /// 构造函数
+    /// @param arena 被适配的线性分配器（生命周期需长于本对象）
+    /// @param upstream 空间不足时的后备资源
+    explicit ArenaResource(LinearArena& arena,
+                           std::pmr::memory_resource* upstream = std::pmr::null_memory_resource()) noexcept
+        : arena_(&arena), upstream_(upstream) {}
+
+    /// 获取被适配的分配器
+    [[nodiscard]] LinearArena& arena() const noexcept { return *arena_; }
+
+    /// 获取上游资源
+    [[nodiscard]] std::pmr::memory_resource* upstream() const noexcept { return upstream_; }
+
+   protected:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment) override;
+    [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+   private:
+    LinearArena* arena_;
+    std::pmr::memory_resource* upstream_;
+};
+
+/// FrameArena 的 std::pmr::memory_resource 适配器
+///
+/// 始终从 FrameArena 的当前帧缓冲区分配，swap()/begin_frame() 后整体失效，
+/// 因此逐帧容器无需逐个释放：
+/// @code
+/// FrameArena frame_arena;
+/// FrameArenaResource frame_resource(frame_arena);
+///
+/// // 每帧
+/// frame_arena.begin_frame();
+/// {
+///     FrameVector<std::uint32_t> visible(&frame_resource);
+///     FrameString label("frame", &frame_resource);
+///     ...
+/// }
+/// frame_arena.end_frame();
+/// @endcode
+///
+/// @note 跨帧保留的容器只在 FrameArena 的缓冲区轮转一周之前有效
+/// @note 从当前帧主分配器分配，与 FrameArena::allocate() 一样只能在单个线程使用
+class FrameArenaResource : public std::pmr::memory_resource {
+   public:
+    /// 构造函数
+    /// @param arena 帧分配器（生命周期需长于本对象）
+    /// @param upstream 当前帧空间不足时的后备资源
+    explicit FrameArenaResource(FrameArena& arena,
+                                std::pmr::memory_resource* upstream = std::pmr::null_memory_resource()) noexcept
+        : arena_(&arena), upstream_(upstream) {}
+
+    /// 获取帧分配器
+    [[nodiscard]] FrameArena& arena() const noexcept { return *arena_; }
+
+    /// 获取上游资源
+    [[nodiscard]] std::pmr::memory_resource* upstream() const noexcept { return upstream_; }
+
+   protected:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment) override;
+    [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+   private:
+    FrameArena* arena_;
+    std::pmr::memory_resource* upstream_;
+};
+
+// ============================================================================
+// 逐帧容器别名（构造时传入 FrameArenaResource 或 ArenaResource）
+// ============================================================================
+
+template <typename T>
+using FrameVector = std::pmr::vector<T>;
+
+using FrameString = std::pmr::string;
+
+template <typename Key, typename Value, typename Compare = std::less<Key>>
+using FrameMap = std::pmr::map<Key, Value, Compare>;
+
+template <typename Key, typename Value, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>>
+using FrameUnorderedMap = std::pmr::unordered_map<Key, Value, Hash, KeyEqual>;
+
+}  // namespace Corona::Kernal::Memory
@@ -35,6 +35,8 @@ inline void* aligned_malloc(std::size_t size, std::size_t alignment) {
 inline void* aligned_free(void* ptr) {
 #if _WIN32 || _WIN64
     _aligned_free(ptr);
+#else
+    std::free(ptr);
 #endif
     return nullptr;
 }
@@ -0,0 +1,152 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "cache_aligned_allocator.h"
+
+namespace Corona::Kernal::Memory {
+
+/// 基于纪元的延迟回收（Epoch-Based Reclamation）
+///
+/// 设计原理：
+/// - 全局纪元单调递增；读者进入临界区（pin）时把当前全局纪元写入自己的参与者记录，离开时标记为静默
+/// - 写者把对象从共享结构中摘下后 retire()，记录当时的全局纪元 e，等全局纪元推进到 e + 2 后才真正删除
+/// - 只有所有非静默的参与者都已观察到当前纪元时，全局纪元才能推进一步，
+///   因此纪元推进两步时，retire 之前进入临界区的读者必然都已离开，它们持有的指针不再被使用
+/// - 读者只写自己独占缓存行的记录，读者之间没有任何共享写入，读侧开销随读者数线性扩展
+/// - 待回收对象放在线程本地列表中，积累到 kCollectThreshold 个时尝试推进纪元并回收
+/// - 线程退出时未回收的对象移入全局孤儿列表，由之后任意线程的 collect() 回收；参与者记录复用、不释放
+///
+/// @note 临界区应保持短小：长时间停留在临界区会阻止纪元推进，所有线程的待回收对象随之积压
+/// @note 临界区可以嵌套，只有最外层的 Guard 析构时才离开
+class EpochManager {
+   public:
+    /// 线程本地待回收对象数达到该值时自动 collect()
+    static constexpr std::size_t kCollectThreshold = 64;
+
+    struct Participant;
+
+    /// 临界区守卫（RAII）：存活期间，进入临界区后读取到的已 retire 对象不会被删除
+    /// @note 必须在调用 pin() 的线程上析构：嵌套深度是参与者记录的线程私有状态，
+    ///       移动只能发生在同一线程内（Debug 构建下跨线程析构会触发断言）
+    class Guard {
+       public:
+        Guard() = default;
+        ~Guard() { release(); }
+
+        Guard(Guard&& other) noexcept : participant_(other.participant_), owned_(other.owned_) {
+            other.participant_ = nullptr;
+        }
+        Guard& operator=(Guard&& other) noexcept {
+            if (this != &other) {
+                release();
+                participant_ = other.participant_;
+                owned_ = other.owned_;
+                other.participant_ = nullptr;
+            }
+            return *this;
+        }
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+
+        /// 是否处于临界区
+        [[nodiscard]] bool active() const noexcept { return participant_ != nullptr; }
+
+       private:
+        friend class EpochManager;
+        Guard(Participant* participant, bool owned) noexcept : participant_(participant), owned_(owned) {}
+
+        void release() noexcept;
+
+        Participant* participant_ = nullptr;
+        bool owned_ = false;  ///< 线程退出阶段临时借用的参与者记录，离开时归还
+    };
+
+    /// 获取全局实例
+    [[nodiscard]] static EpochManager& instance();
+
+    EpochManager(const EpochManager&) = delete;
+    EpochManager& operator=(const EpochManager&) = delete;
+
+    /// 进入临界区
+    [[nodiscard]] Guard pin();
+
+    /// 延迟删除对象（对象必须已从共享结构中摘下，之后进入临界区的读者不会再读到它）
+    /// @param ptr 对象指针
+    /// @param deleter 删除函数，在确认没有读者持有 ptr 后调用（可能在其他线程）
+    void retire(void* ptr, void (*deleter)(void*));
+
+    /// 延迟 delete 对象
+    template <typename T>
+    void retire(const T* ptr) {
+        if (ptr) {
+            retire(const_cast<T*>(ptr), [](void* p) { delete static_cast<T*>(p); });
+        }
+    }
+
+    /// 尝试推进纪元并回收当前线程及孤儿列表中已过宽限期的对象
+    /// @return 本次删除的对象数
+    std::size_t collect();
+
+    /// 等待纪元推进两步后回收：返回时当前线程在调用前 retire 的对象均已删除
+    /// @note 当前线程不得处于临界区；其他线程长时间停留在临界区时会一直等待
+    void synchronize();
+
+    /// 当前全局纪元
+    [[nodiscard]] std::uint64_t epoch() const noexcept { return global_epoch_.load(std::memory_order_acquire); }
+
+    /// 当前线程尚未回收的对象数
+    [[nodiscard]] std::size_t pending();
+
+    /// 参与者记录：每个线程一个，独占缓存行
+    struct alignas(CacheLineSize) Participant {
+        std::atomic<std::uint64_t> epoch{kQuiescent};  ///< 所处纪元，kQuiescent 表示不在临界区
+        std::atomic<bool> in_use{false};
+        std::uint32_t depth = 0;  ///< 临界区嵌套深度（仅所属线程访问）
+        std::thread::id owner;    ///< 最近一次进入临界区的线程（用于断言 Guard 不跨线程析构）
+        Participant* next = nullptr;
+    };
+
+   private:
+    /// 待回收对象
+    struct Retired {
+        void* ptr;
+        void (*deleter)(void*);
+        std::uint64_t epoch;  ///< retire 时的全局纪元
+    };
+
+    class ThreadRegistration;
+
+    static constexpr std::uint64_t kQuiescent = ~std::uint64_t{0};
+
+    EpochManager() = default;
+
+    /// 当前线程的参与者记录与待回收列表（线程退出阶段返回 nullptr）
+    [[nodiscard]] ThreadRegistration* local();
+
+    /// 取得一个空闲的参与者记录（复用或新建）
+    [[nodiscard]] Participant* acquire_participant();
+
+    /// 所有非静默参与者都处于当前纪元时推进一步
+    bool try_advance();
+
+    /// 删除 list 中已过宽限期的对象，返回删除数
+    std::size_t reclaim(std::vector<Retired>& list, std::uint64_t epoch);
+
+    /// 并入孤儿列表
+    void adopt(std::vector<Retired>& list);
+
+    std::atomic<std::uint64_t> global_epoch_{1};
+    std::atomic<Participant*> participants_{nullptr};  ///< 参与者链表（只增不减）
+
+    std::mutex orphan_mutex_;
+    std::vector<Retired> orphans_;  ///< 已退出线程留下的待回收对象
+    std::atomic<std::size_t> orphan_count_{0};
+};
+
+}  // namespace Corona::Kernal::Memory
@@ -3,13 +3,30 @@
 #include <atomic>
 #include <mutex>
 #include <new>
+#include <vector>
 
 #include "chunk.h"
+#include "lock_free_stack.h"
 #include "pool_config.h"
 
 namespace Corona::Kernal::Memory {
 
 /// 固定大小块内存池
+///
+/// 线程安全模式下可启用线程本地弹匣（PoolConfig::magazine_size > 0）：
+/// - 每个线程为每个池持有一个私有空闲块链表（弹匣），本地分配/释放无锁、无竞争
+/// - 弹匣为空时从共享空闲链表批量取 magazine_size 个块；
+///   累积到 2 * magazine_size 时批量归还 magazine_size 个块
+/// - 线程退出时弹匣中的块自动归还
+/// - reset()/clear()/移动/析构不得与其他线程的分配并发执行
+///
+/// 无锁模式（PoolConfig::lock_free）：
+/// - 共享空闲链表为 ABA 安全的 LockFreeStack，空闲块内嵌 LockFreeNode
+/// - allocate()/deallocate() 只做一次 CAS 与两次原子计数，任意线程分配、任意线程释放均无锁，
+///   适合多生产者/多消费者的分配模式
+/// - 仅在空闲链表耗尽、需要新建 Chunk 时加锁
+/// - Chunk 在池的生命周期内不会被释放（pop 可能读取已被取走的块），
+///   shrink_to_fit()/reset()/clear() 不得与分配/释放并发执行
 class FixedPool {
    public:
     /// 构造函数
@@ -39,8 +56,16 @@ class FixedPool {
     void reset() noexcept;
 
     /// 释放所有未使用的 Chunk
+    ///
+    /// 一次遍历空闲链表统计各 Chunk 的空闲块数，再一次遍历重建剩余空闲链表，
+    /// 复杂度 O(free_blocks × log chunks)。
+    /// @note 只回收当前线程弹匣中的块，其他线程弹匣缓存的块仍视为占用
+    /// @note 无锁模式下不得与分配/释放并发执行
     void shrink_to_fit();
 
+    /// 将当前线程的弹匣中的块全部归还共享空闲链表
+    void flush_thread_cache();
+
     /// 清空内存池（释放所有 Chunk）
     void clear() noexcept;
 
@@ -53,7 +78,7 @@ class FixedPool {
     /// 获取总块数
     [[nodiscard]] std::size_t total_blocks() const noexcept;
 
-    /// 获取空闲块数
+    /// 获取空闲块数（包含各线程弹匣中缓存的块）
     [[nodiscard]] std::size_t free_blocks() const noexcept;
 
     /// 获取已使用块数
@@ -69,15 +94,72 @@ class FixedPool {
     [[nodiscard]] PoolStats stats() const noexcept;
 
    private:
+    struct Magazine;
+    struct ThreadCache;
+
+    /// 获取当前线程对应本池的弹匣（首次使用时创建并登记）
+    [[nodiscard]] Magazine* local_magazine();
+
+    /// 从共享空闲链表批量补充弹匣（加锁）
+    void refill_magazine(Magazine* magazine);
+
+    /// 将弹匣中的 count 个块批量归还共享空闲链表（加锁）
+    void flush_magazine(Magazine* magazine, std::size_t count) noexcept;
+
+    /// 解除所有弹匣的登记
+    /// @param return_blocks 为 true 时将弹匣中的块归还共享空闲链表，否则丢弃
+    void detach_magazines(bool return_blocks) noexcept;
+
+    /// 是否启用线程本地弹匣
+    [[nodiscard]] bool uses_magazines() const noexcept {
+        return config_.thread_safe && !config_.lock_free && config_.magazine_size > 0;
+    }
+
+    /// 无锁模式分配：弹出无锁栈，耗尽时加锁扩容
+    [[nodiscard]] void* allocate_lock_free();
+
+    /// 无锁模式释放：压入无锁栈
+    void deallocate_lock_free(void* ptr) noexcept;
+
+    /// 无锁模式下当前已分配的块数（近似值）
+    [[nodiscard]] std::size_t lock_free_used_blocks() const noexcept;
+
+    /// 释放完全空闲的 Chunk 并重建 free_list_（需持有锁）
+    void release_empty_chunks_locked();
+
+    /// 将无锁栈中的块全部移入 free_list_（无锁模式，不得与分配并发）
+    void drain_lock_free_list() noexcept;
+
+    /// 将 free_list_ 中的块全部压回无锁栈（无锁模式，不得与分配并发）
+    void refill_lock_free_list() noexcept;
+
+    /// 各弹匣缓存的块数之和（需持有 mutex_）
+    [[nodiscard]] std::size_t cached_blocks_locked() const noexcept;
+
+    /// 线程安全模式下加锁，否则返回空锁
+    [[nodiscard]] std::unique_lock<std::mutex> lock_if_thread_safe() const noexcept;
+
     /// 分配新的 Chunk
     [[nodiscard]] ChunkHeader* allocate_chunk();
 
+    /// Chunk 实际使用的页后端（Chunk 小于大页时 HugePages 退化为 VirtualMemory）
+    [[nodiscard]] PageBackend chunk_backend() const noexcept;
+
+    /// 页后端下每个 Chunk 的映射大小
+    [[nodiscard]] std::size_t mapped_chunk_size() const noexcept;
+
+    /// 每个 Chunk 实际占用的内存（计入 MemoryTracker）
+    [[nodiscard]] std::size_t chunk_footprint() const noexcept;
+
     /// 初始化 Chunk 的空闲链表
     void initialize_free_list(ChunkHeader* chunk);
 
-    /// 查找包含指定地址的 Chunk
+    /// 查找包含指定地址的 Chunk（按地址索引二分查找）
     [[nodiscard]] ChunkHeader* find_chunk(void* ptr) const noexcept;
 
+    /// 查找包含指定地址的 Chunk 在 chunk_index_ 中的下标，不存在返回 chunk_index_.size()
+    [[nodiscard]] std::size_t chunk_slot(const void* ptr) const noexcept;
+
     /// 释放单个 Chunk
     void free_chunk(ChunkHeader* chunk) noexcept;
 
@@ -91,12 +173,20 @@ class FixedPool {
     PoolConfig config_;
     ChunkHeader* first_chunk_ = nullptr;
     FreeBlock* free_list_ = nullptr;  // 全局空闲链表（跨 Chunk）
+    std::vector<ChunkHeader*> chunk_index_;  // 按地址升序排列的 Chunk（归属查找）
 
     // 线程安全
     mutable std::mutex mutex_;
+    Magazine* magazines_ = nullptr;  // 已登记的线程弹匣（受 mutex_ 保护）
+
+    // 无锁模式：共享空闲链表与计数（各占缓存行，避免与 mutex_ 及彼此伪共享）
+    alignas(CacheLineSize) LockFreeStack lock_free_list_;
+    alignas(CacheLineSize) std::atomic<std::size_t> lock_free_allocations_{0};
+    alignas(CacheLineSize) std::atomic<std::size_t> lock_free_deallocations_{0};
+    std::atomic<std::size_t> lock_free_peak_{0};
 
     // 统计
-    std::size_t total_blocks_ = 0;
+    alignas(CacheLineSize) std::size_t total_blocks_ = 0;
     std::size_t free_blocks_ = 0;
     std::size_t chunk_count_ = 0;
     std::size_t allocation_count_ = 0;
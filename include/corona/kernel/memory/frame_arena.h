@@ -1,8 +1,12 @@
 #pragma once
 
-#include <array>
+#include <atomic>
 #include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
 #include <utility>
+#include <vector>
 
 #include "linear_arena.h"
 
@@ -11,46 +15,81 @@ namespace Corona::Kernal::Memory {
 /// 默认帧分配器缓冲区大小（1MB）
 inline constexpr std::size_t kDefaultFrameArenaSize = 1024 * 1024;
 
-/// 双缓冲帧分配器（支持跨帧数据）
+/// 默认工作线程子分配器块大小（16KB）
+inline constexpr std::size_t kDefaultFrameThreadBlockSize = 16 * 1024;
+
+/// 帧分配器配置
+struct FrameArenaConfig {
+    std::size_t buffer_size = kDefaultFrameArenaSize;             ///< 每个缓冲区主分配器的大小
+    std::size_t buffer_count = 2;                                 ///< 缓冲区数量（同时在途的帧数，为 1 时不保留上一帧）
+    bool growable = false;                                        ///< 主分配器耗尽时是否链接追加块
+    std::size_t thread_buffer_size = 0;                           ///< 每个缓冲区供工作线程划分的区域大小（0 = 禁用）
+    std::size_t thread_block_size = kDefaultFrameThreadBlockSize;  ///< 每次为线程划分的子分配器大小
+    PageBackend backend = PageBackend::Heap;                      ///< 主分配器的内存后端
+    MemoryTag tag = MemoryTag::Frame;                             ///< 内存计入的 MemoryTracker 标签
+};
+
+/// 多缓冲帧分配器（支持跨帧数据与多线程分配）
 ///
 /// 设计原理：
-/// - 使用两个 LinearArena 交替使用
-/// - 当前帧使用一个缓冲区分配
-/// - 帧结束时交换缓冲区，新帧重置当前缓冲区
-/// - 上一帧的数据在下一帧仍然有效
+/// - 使用 buffer_count 个缓冲区轮转，当前帧使用其中一个分配
+/// - 帧结束时切换到下一个缓冲区，新帧重置当前缓冲区
+/// - 之前 buffer_count - 1 帧的数据仍然有效（默认双缓冲：上一帧）
+///
+/// 多线程分配（thread_buffer_size > 0）：
+/// - 每个缓冲区额外持有一块线程区域，工作线程通过 thread_allocate() 分配
+/// - 每个线程以原子操作从线程区域划出 thread_block_size 大小的子分配器，之后在其中无锁、无原子地线性分配
+/// - begin_frame()/swap() 使所有线程的子分配器同时失效，无需逐线程重置
+/// - allocate()/create() 等主分配器接口仍为单线程使用
+/// - begin_frame()/end_frame()/swap()/reset_all() 不得与 thread_allocate() 并发执行
 class FrameArena {
    public:
     /// 构造函数
     /// @param buffer_size 每个缓冲区的大小
-    explicit FrameArena(std::size_t buffer_size = kDefaultFrameArenaSize);
+    /// @param growable 缓冲区耗尽时是否链接追加块（见 LinearArena）
+    explicit FrameArena(std::size_t buffer_size = kDefaultFrameArenaSize, bool growable = false);
+
+    /// 构造函数
+    /// @param config 帧分配器配置
+    explicit FrameArena(const FrameArenaConfig& config);
 
     /// 禁用拷贝
     FrameArena(const FrameArena&) = delete;
     FrameArena& operator=(const FrameArena&) = delete;
 
     /// 支持移动
-    FrameArena(FrameArena&&) noexcept = default;
-    FrameArena& operator=(FrameArena&&) noexcept = default;
+    FrameArena(FrameArena&& other) noexcept;
+    FrameArena& operator=(FrameArena&& other) noexcept;
 
     /// 析构函数
-    ~FrameArena() = default;
+    ~FrameArena();
 
     /// 获取当前帧的分配器
-    [[nodiscard]] LinearArena& current() noexcept { return arenas_[current_index_]; }
+    [[nodiscard]] LinearArena& current() noexcept { return buffers_[current_index_]->arena; }
 
     /// 获取当前帧的分配器（const 版本）
-    [[nodiscard]] const LinearArena& current() const noexcept { return arenas_[current_index_]; }
+    [[nodiscard]] const LinearArena& current() const noexcept { return buffers_[current_index_]->arena; }
 
     /// 获取上一帧的分配器
-    [[nodiscard]] LinearArena& previous() noexcept { return arenas_[1 - current_index_]; }
+    [[nodiscard]] LinearArena& previous() noexcept { return frame_buffer(1); }
 
     /// 获取上一帧的分配器（const 版本）
-    [[nodiscard]] const LinearArena& previous() const noexcept { return arenas_[1 - current_index_]; }
+    [[nodiscard]] const LinearArena& previous() const noexcept { return frame_buffer(1); }
+
+    /// 获取 frames_ago 帧之前的分配器（0 为当前帧）
+    /// @pre frames_ago < buffer_count()
+    [[nodiscard]] LinearArena& frame_buffer(std::size_t frames_ago) noexcept {
+        return buffers_[buffer_index(frames_ago)]->arena;
+    }
+
+    [[nodiscard]] const LinearArena& frame_buffer(std::size_t frames_ago) const noexcept {
+        return buffers_[buffer_index(frames_ago)]->arena;
+    }
 
     /// 交换缓冲区（帧结束时调用）
     void swap() noexcept;
 
-    /// 帧开始时调用（重置当前缓冲区）
+    /// 帧开始时调用（重置当前缓冲区及其线程区域）
     void begin_frame() noexcept;
 
     /// 帧结束时调用（交换缓冲区）
@@ -77,26 +116,72 @@ class FrameArena {
     template <typename T>
     [[nodiscard]] T* allocate_array(std::size_t count);
 
+    /// 从当前线程的子分配器分配内存（可在任意线程并发调用）
+    /// @param size 分配大小
+    /// @param alignment 对齐要求
+    /// @return 分配的内存地址，线程区域耗尽或未启用返回 nullptr
+    [[nodiscard]] void* thread_allocate(std::size_t size,
+                                        std::size_t alignment = alignof(std::max_align_t)) noexcept;
+
+    /// 从当前线程的子分配器分配并构造对象（可在任意线程并发调用）
+    /// @throw std::bad_alloc 如果分配失败
+    template <typename T, typename... Args>
+    [[nodiscard]] T* thread_create(Args&&... args);
+
+    /// 检查指针是否属于任一缓冲区（主分配器或线程区域）
+    [[nodiscard]] bool owns(const void* ptr) const noexcept;
+
+    /// 获取缓冲区数量
+    [[nodiscard]] std::size_t buffer_count() const noexcept { return buffers_.size(); }
+
     /// 获取当前帧索引
     [[nodiscard]] std::size_t current_index() const noexcept { return current_index_; }
 
     /// 获取单个缓冲区容量
-    [[nodiscard]] std::size_t buffer_capacity() const noexcept { return arenas_[0].capacity(); }
+    [[nodiscard]] std::size_t buffer_capacity() const noexcept { return buffers_[0]->arena.capacity(); }
 
-    /// 获取当前帧已使用大小
-    [[nodiscard]] std::size_t current_used() const noexcept { return arenas_[current_index_].used(); }
+    /// 获取当前帧已使用大小（主分配器）
+    [[nodiscard]] std::size_t current_used() const noexcept { return current().used(); }
 
-    /// 获取当前帧可用空间
-    [[nodiscard]] std::size_t current_available() const noexcept {
-        return arenas_[current_index_].available();
-    }
+    /// 获取当前帧可用空间（主分配器）
+    [[nodiscard]] std::size_t current_available() const noexcept { return current().available(); }
+
+    /// 获取当前帧线程区域已划分的大小
+    [[nodiscard]] std::size_t current_thread_used() const noexcept;
 
-    /// 重置两个缓冲区
+    /// 重置所有缓冲区
     void reset_all() noexcept;
 
    private:
-    std::array<LinearArena, 2> arenas_;
+    /// 单帧缓冲区：主分配器 + 线程区域
+    struct FrameBuffer {
+        explicit FrameBuffer(const FrameArenaConfig& config);
+        ~FrameBuffer();
+
+        FrameBuffer(const FrameBuffer&) = delete;
+        FrameBuffer& operator=(const FrameBuffer&) = delete;
+
+        /// 原子地从线程区域划出 size 字节，空间不足返回 nullptr
+        [[nodiscard]] std::byte* carve(std::size_t size) noexcept;
+
+        LinearArena arena;
+        MemoryTag tag;
+        std::byte* thread_region = nullptr;
+        std::size_t thread_capacity = 0;
+        std::atomic<std::size_t> thread_offset{0};
+    };
+
+    [[nodiscard]] std::size_t buffer_index(std::size_t frames_ago) const noexcept {
+        return (current_index_ + buffers_.size() - frames_ago % buffers_.size()) % buffers_.size();
+    }
+
+    /// 使所有线程子分配器失效
+    void advance_epoch() noexcept;
+
+    std::vector<std::unique_ptr<FrameBuffer>> buffers_;
     std::size_t current_index_ = 0;
+    std::size_t thread_block_size_ = kDefaultFrameThreadBlockSize;
+    std::atomic<std::uint64_t> epoch_{0};  // 线程子分配器的有效期标识（全局唯一，不会重复）
 };
 
 // ============================================================================
@@ -113,4 +198,13 @@ T* FrameArena::allocate_array(std::size_t count) {
     return current().allocate_array<T>(count);
 }
 
+template <typename T, typename... Args>
+T* FrameArena::thread_create(Args&&... args) {
+    void* ptr = thread_allocate(sizeof(T), alignof(T));
+    if (!ptr) {
+        throw std::bad_alloc();
+    }
+    return new (ptr) T(std::forward<Args>(args)...);
+}
+
 }  // namespace Corona::Kernal::Memory
@@ -0,0 +1,297 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Corona::Kernal::Memory {
+
+/// 句柄池句柄（32 位：索引 + 版本号）
+///
+/// ```
+/// PoolHandle (32 bits):
+/// ┌────────────────────────────┬──────────────────┐
+/// │  Generation (12 bits)      │  Index (20 bits)  │
+/// └────────────────────────────┴──────────────────┘
+/// ```
+///
+/// - 按对象类型区分，不同池的句柄不能混用
+/// - 版本号 0 保留为无效值，因此默认构造（全 0）的句柄无效
+/// - 只有 4 字节，可直接存入 ECS 组件
+template <typename T>
+class PoolHandle {
+   public:
+    using RawType = std::uint32_t;
+
+    static constexpr unsigned kIndexBits = 20;
+    static constexpr unsigned kGenerationBits = 32 - kIndexBits;
+    static constexpr RawType kMaxIndex = (RawType{1} << kIndexBits) - 1;
+    static constexpr RawType kMaxGeneration = (RawType{1} << kGenerationBits) - 1;
+
+    /// 默认构造（无效句柄）
+    constexpr PoolHandle() noexcept = default;
+
+    /// 从索引和版本号构造
+    constexpr PoolHandle(RawType index, RawType generation) noexcept
+        : raw_((generation << kIndexBits) | (index & kMaxIndex)) {}
+
+    /// 从原始 32 位值构造
+    [[nodiscard]] static constexpr PoolHandle from_raw(RawType raw) noexcept {
+        PoolHandle handle;
+        handle.raw_ = raw;
+        return handle;
+    }
+
+    /// 获取索引部分
+    [[nodiscard]] constexpr RawType index() const noexcept { return raw_ & kMaxIndex; }
+
+    /// 获取版本号部分
+    [[nodiscard]] constexpr RawType generation() const noexcept { return raw_ >> kIndexBits; }
+
+    /// 获取原始 32 位值
+    [[nodiscard]] constexpr RawType raw() const noexcept { return raw_; }
+
+    /// 检查是否为有效句柄（不检查对象是否存活，存活检查见 HandlePool::contains）
+    [[nodiscard]] constexpr bool is_valid() const noexcept { return generation() != 0; }
+
+    [[nodiscard]] constexpr bool operator==(const PoolHandle& other) const noexcept = default;
+    [[nodiscard]] constexpr auto operator<=>(const PoolHandle& other) const noexcept = default;
+
+   private:
+    RawType raw_ = 0;
+};
+
+/// 基于句柄的对象池（稳定的紧凑句柄 + 稠密存储）
+///
+/// 设计原理：
+/// - 存活对象连续存放在稠密数组中，遍历时无空洞、缓存友好
+/// - 销毁时把末尾对象移入空位（swap-remove），稠密数组始终保持紧凑
+/// - 槽位表把句柄索引映射到稠密下标，并记录版本号：销毁后版本号递增，旧句柄立即失效（O(1) 校验）
+/// - 空闲槽位以槽位表内嵌的链表复用
+/// - 槽位版本号耗尽时该槽位退役、不再复用，保证旧句柄永远不会误命中新对象
+///
+/// 与 ObjectPool 的区别：对象会在销毁其他对象或扩容时被移动，
+/// 因此只应长期持有句柄，get() 返回的指针仅在下一次 create()/destroy() 之前有效
+///
+/// @note 非线程安全
+template <typename T>
+class HandlePool {
+    static_assert(std::is_move_constructible_v<T> && std::is_move_assignable_v<T>,
+                  "T must be movable (dense storage relocates objects)");
+
+   public:
+    using value_type = T;
+    using handle_type = PoolHandle<T>;
+    using pointer = T*;
+    using const_pointer = const T*;
+
+    /// 最大槽位数
+    static constexpr std::size_t kMaxSlots = std::size_t{handle_type::kMaxIndex} + 1;
+
+    /// 构造函数
+    /// @param initial_capacity 初始容量
+    explicit HandlePool(std::size_t initial_capacity = 64) { reserve(initial_capacity); }
+
+    /// 禁用拷贝
+    HandlePool(const HandlePool&) = delete;
+    HandlePool& operator=(const HandlePool&) = delete;
+
+    /// 支持移动
+    HandlePool(HandlePool&&) noexcept = default;
+    HandlePool& operator=(HandlePool&&) noexcept = default;
+
+    ~HandlePool() = default;
+
+    /// 创建对象
+    /// @param args 构造函数参数
+    /// @return 新对象的句柄，槽位耗尽返回无效句柄
+    template <typename... Args>
+    [[nodiscard]] handle_type create(Args&&... args);
+
+    /// 销毁对象
+    /// @return 句柄有效且对象已销毁返回 true，旧句柄或无效句柄返回 false
+    bool destroy(handle_type handle);
+
+    /// 检查句柄是否指向存活对象（O(1)）
+    [[nodiscard]] bool contains(handle_type handle) const noexcept { return slot_of(handle) != nullptr; }
+
+    /// 获取对象
+    /// @return 对象指针（仅在下一次 create()/destroy() 之前有效），句柄失效返回 nullptr
+    [[nodiscard]] pointer get(handle_type handle) noexcept {
+        const Slot* slot = slot_of(handle);
+        return slot ? &dense_[slot->dense_index] : nullptr;
+    }
+
+    [[nodiscard]] const_pointer get(handle_type handle) const noexcept {
+        const Slot* slot = slot_of(handle);
+        return slot ? &dense_[slot->dense_index] : nullptr;
+    }
+
+    /// 存活对象的稠密数组（顺序随销毁而变化）
+    [[nodiscard]] std::span<T> values() noexcept { return dense_; }
+    [[nodiscard]] std::span<const T> values() const noexcept { return dense_; }
+
+    /// 获取稠密数组中第 dense_index 个对象的句柄
+    [[nodiscard]] handle_type handle_at(std::size_t dense_index) const noexcept {
+        const auto index = dense_to_slot_[dense_index];
+        return handle_type(index, slots_[index].generation);
+    }
+
+    /// 遍历所有存活对象
+    /// @param func 回调函数 void(handle_type, T&)，回调中不得创建或销毁对象
+    template <typename Func>
+    void for_each(Func&& func) {
+        for (std::size_t i = 0; i < dense_.size(); ++i) {
+            func(handle_at(i), dense_[i]);
+        }
+    }
+
+    /// 销毁所有对象（所有已发出的句柄随之失效）
+    void clear();
+
+    /// 预留容量
+    void reserve(std::size_t capacity) {
+        dense_.reserve(capacity);
+        dense_to_slot_.reserve(capacity);
+        slots_.reserve(capacity);
+    }
+
+    /// 获取存活对象数
+    [[nodiscard]] std::size_t size() const noexcept { return dense_.size(); }
+
+    /// 是否没有存活对象
+    [[nodiscard]] bool empty() const noexcept { return dense_.empty(); }
+
+    /// 获取容量
+    [[nodiscard]] std::size_t capacity() const noexcept { return dense_.capacity(); }
+
+    /// 获取已退役（版本号耗尽）的槽位数
+    [[nodiscard]] std::size_t retired_slots() const noexcept { return retired_count_; }
+
+   private:
+    static constexpr std::uint32_t kNullSlot = 0xFFFFFFFFu;
+
+    /// 槽位：存活时记录稠密下标，空闲时记录下一个空闲槽位
+    struct Slot {
+        std::uint32_t dense_index = kNullSlot;  ///< 稠密下标（存活）/ 下一个空闲槽位（空闲）
+        std::uint32_t generation = 1;           ///< 当前版本号（从 1 开始）
+        bool alive = false;
+    };
+
+    [[nodiscard]] const Slot* slot_of(handle_type handle) const noexcept {
+        const auto index = handle.index();
+        if (index >= slots_.size()) {
+            return nullptr;
+        }
+        const Slot& slot = slots_[index];
+        return slot.alive && slot.generation == handle.generation() ? &slot : nullptr;
+    }
+
+    /// 释放槽位：递增版本号，耗尽时退役
+    void release_slot(std::uint32_t index) noexcept {
+        Slot& slot = slots_[index];
+        slot.alive = false;
+        if (slot.generation == handle_type::kMaxGeneration) {
+            ++retired_count_;  // 不再放回空闲链表
+            return;
+        }
+        ++slot.generation;
+        slot.dense_index = free_head_;
+        free_head_ = index;
+    }
+
+    std::vector<T> dense_;                     ///< 存活对象（紧凑）
+    std::vector<std::uint32_t> dense_to_slot_;  ///< 稠密下标 -> 槽位索引
+    std::vector<Slot> slots_;                  ///< 槽位表（句柄索引）
+    std::uint32_t free_head_ = kNullSlot;      ///< 空闲槽位链表头
+    std::size_t retired_count_ = 0;
+};
+
+// ============================================================================
+// 实现
+// ============================================================================
+
+template <typename T>
+template <typename... Args>
+PoolHandle<T> HandlePool<T>::create(Args&&... args) {
+    std::uint32_t index = free_head_;
+    if (index == kNullSlot && slots_.size() >= kMaxSlots) {
+        return handle_type{};  // 槽位耗尽
+    }
+
+    // 先构造对象，构造或扩容失败时回滚，不修改槽位表
+    dense_.emplace_back(std::forward<Args>(args)...);
+    const bool new_slot = index == kNullSlot;
+    try {
+        if (new_slot) {
+            index = static_cast<std::uint32_t>(slots_.size());
+            slots_.emplace_back();
+        }
+        dense_to_slot_.push_back(index);
+    } catch (...) {
+        if (new_slot && slots_.size() > index) {
+            slots_.pop_back();
+        }
+        dense_.pop_back();
+        throw;
+    }
+
+    Slot& slot = slots_[index];
+    if (!new_slot) {
+        free_head_ = slot.dense_index;
+    }
+    slot.dense_index = static_cast<std::uint32_t>(dense_.size() - 1);
+    slot.alive = true;
+    return handle_type(index, slot.generation);
+}
+
+template <typename T>
+bool HandlePool<T>::destroy(handle_type handle) {
+    const Slot* found = slot_of(handle);
+    if (!found) {
+        return false;
+    }
+
+    const std::uint32_t index = handle.index();
+    const std::uint32_t dense_index = found->dense_index;
+    const std::size_t last = dense_.size() - 1;
+
+    // swap-remove：末尾对象移入空位
+    if (dense_index != last) {
+        dense_[dense_index] = std::move(dense_[last]);
+        const std::uint32_t moved_slot = dense_to_slot_[last];
+        dense_to_slot_[dense_index] = moved_slot;
+        slots_[moved_slot].dense_index = dense_index;
+    }
+    dense_.pop_back();
+    dense_to_slot_.pop_back();
+
+    release_slot(index);
+    return true;
+}
+
+template <typename T>
+void HandlePool<T>::clear() {
+    for (const std::uint32_t index : dense_to_slot_) {
+        release_slot(index);
+    }
+    dense_.clear();
+    dense_to_slot_.clear();
+}
+
+}  // namespace Corona::Kernal::Memory
+
+// std::hash 特化
+namespace std {
+template <typename T>
+struct hash<Corona::Kernal::Memory::PoolHandle<T>> {
+    std::size_t operator()(const Corona::Kernal::Memory::PoolHandle<T>& handle) const noexcept {
+        return std::hash<std::uint32_t>{}(handle.raw());
+    }
+};
+}  // namespace std
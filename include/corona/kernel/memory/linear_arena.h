@@ -7,15 +7,60 @@
 #include <utility>
 
 #include "cache_aligned_allocator.h"
+#include "memory_tracker.h"
+#include "virtual_memory.h"
 
 namespace Corona::Kernal::Memory {
 
 /// 线性分配器（只分配不释放，整体重置）
+///
+/// 可增长模式（growable = true）下，主缓冲区耗尽时会链接追加块继续分配：
+/// - 追加块大小至少为主缓冲区容量，超大请求按需放大
+/// - reset()/rewind() 退还的追加块进入本分配器的块缓存，下次溢出时优先复用
+/// - release_cached_blocks() 释放块缓存
+///
+/// 页后端（VirtualMemory / HugePages）下主缓冲区只保留地址空间，随分配推进逐段提交；
+/// shrink_to_fit() 归还当前位置之后已提交的页。追加块始终使用堆内存。
+///
+/// 主缓冲区已提交的内存与追加块（含块缓存）计入构造时指定的 MemoryTracker 标签。
+///
+/// 标记与回退用于嵌套的临时分配：
+/// @code
+/// auto marker = arena.mark();
+/// auto* scratch = arena.allocate_array<float>(count);
+/// ...
+/// arena.rewind(marker);  // 或使用 LinearArena::Scope 自动回退
+/// @endcode
 class LinearArena {
    public:
+    /// 分配位置标记（由 mark() 返回，仅对产生它的分配器有效）
+    struct Marker {
+        const void* block = nullptr;  ///< 所在块（nullptr 表示主缓冲区）
+        std::size_t offset = 0;       ///< 块内偏移
+        std::size_t used_before = 0;  ///< 之前各块已使用的字节数
+    };
+
+    /// 作用域标记：析构时回退到构造时的位置
+    class Scope {
+       public:
+        explicit Scope(LinearArena& arena) noexcept : arena_(arena), marker_(arena.mark()) {}
+        ~Scope() { arena_.rewind(marker_); }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+       private:
+        LinearArena& arena_;
+        Marker marker_;
+    };
+
     /// 构造函数
-    /// @param capacity 容量（字节）
-    explicit LinearArena(std::size_t capacity);
+    /// @param capacity 主缓冲区容量（字节）
+    /// @param growable 空间不足时是否链接追加块
+    /// @param backend 主缓冲区的内存后端
+    /// @param tag 内存计入的 MemoryTracker 标签
+    explicit LinearArena(std::size_t capacity, bool growable = false, PageBackend backend = PageBackend::Heap,
+                         MemoryTag tag = MemoryTag::General);
 
     /// 析构函数
     ~LinearArena();
@@ -31,7 +76,7 @@ class LinearArena {
     /// 分配内存
     /// @param size 分配大小
     /// @param alignment 对齐要求
-    /// @return 分配的内存地址，空间不足返回 nullptr
+    /// @return 分配的内存地址，空间不足（且不可增长或追加块分配失败）返回 nullptr
     [[nodiscard]] void* allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t)) noexcept;
 
     /// 分配并构造对象
@@ -54,30 +99,102 @@ class LinearArena {
     template <typename T>
     [[nodiscard]] T* allocate_array_uninitialized(std::size_t count) noexcept;
 
-    /// 重置分配器（不调用析构函数！）
+    /// 重置分配器（不调用析构函数！追加块退回块缓存）
     void reset() noexcept;
 
-    /// 获取容量
-    [[nodiscard]] std::size_t capacity() const noexcept { return capacity_; }
+    /// 获取当前分配位置
+    [[nodiscard]] Marker mark() const noexcept { return {current_block_, offset_, used_before_}; }
+
+    /// 回退到 mark() 返回的位置（不调用析构函数！）
+    /// @param marker 标记，必须来自本分配器且位于当前位置之前
+    void rewind(const Marker& marker) noexcept;
+
+    /// 释放块缓存中的所有追加块
+    void release_cached_blocks() noexcept;
+
+    /// 释放块缓存，并在页后端下归还主缓冲区当前位置之后已提交的页
+    void shrink_to_fit() noexcept;
+
+    /// 获取主缓冲区的内存后端
+    [[nodiscard]] PageBackend backend() const noexcept { return backend_; }
+
+    /// 获取内存计入的 MemoryTracker 标签
+    [[nodiscard]] MemoryTag tag() const noexcept { return tag_; }
+
+    /// 获取主缓冲区已提交的字节数（堆后端等于容量）
+    [[nodiscard]] std::size_t committed() const noexcept { return committed_; }
+
+    /// 是否为可增长模式
+    [[nodiscard]] bool growable() const noexcept { return growable_; }
+
+    /// 获取容量（主缓冲区与活跃追加块之和）
+    [[nodiscard]] std::size_t capacity() const noexcept { return capacity_ + chained_capacity_; }
 
     /// 获取已使用大小
-    [[nodiscard]] std::size_t used() const noexcept { return offset_; }
+    [[nodiscard]] std::size_t used() const noexcept { return used_before_ + offset_; }
 
-    /// 获取可用空间
-    [[nodiscard]] std::size_t available() const noexcept { return capacity_ - offset_; }
+    /// 获取当前块的可用空间
+    [[nodiscard]] std::size_t available() const noexcept { return current_capacity() - offset_; }
 
     /// 检查是否为空
-    [[nodiscard]] bool empty() const noexcept { return offset_ == 0; }
+    [[nodiscard]] bool empty() const noexcept { return used() == 0; }
+
+    /// 获取活跃追加块数量
+    [[nodiscard]] std::size_t chained_block_count() const noexcept;
+
+    /// 获取块缓存中的追加块数量
+    [[nodiscard]] std::size_t cached_block_count() const noexcept;
+
+    /// 检查指针是否位于本分配器的缓冲区内（包含追加块与块缓存）
+    [[nodiscard]] bool owns(const void* ptr) const noexcept;
 
     /// 获取使用率
     [[nodiscard]] double utilization() const noexcept {
-        return capacity_ > 0 ? static_cast<double>(offset_) / static_cast<double>(capacity_) : 0.0;
+        const std::size_t total = capacity();
+        return total > 0 ? static_cast<double>(used()) / static_cast<double>(total) : 0.0;
     }
 
    private:
+    /// 追加块头部（数据紧随其后）
+    struct Block {
+        Block* prev = nullptr;     ///< 链中的上一块 / 缓存中的下一块
+        std::size_t capacity = 0;  ///< 数据区容量
+
+        [[nodiscard]] std::byte* data() noexcept;
+    };
+
+    /// 在当前块内分配，空间不足返回 nullptr
+    [[nodiscard]] void* bump(std::size_t size, std::size_t alignment) noexcept;
+
+    /// 链接一个至少能容纳 size（按 alignment 对齐）的追加块
+    [[nodiscard]] bool grow(std::size_t size, std::size_t alignment) noexcept;
+
+    /// 将当前追加块退回块缓存
+    void retire_current_block() noexcept;
+
+    /// 释放链表中的所有块
+    void free_blocks(Block* block) noexcept;
+
+    /// 页后端下提交主缓冲区直到至少 size 字节
+    [[nodiscard]] bool commit_primary(std::size_t size) noexcept;
+
+    /// 释放主缓冲区
+    void release_primary() noexcept;
+
+    [[nodiscard]] std::byte* current_data() const noexcept;
+    [[nodiscard]] std::size_t current_capacity() const noexcept;
+
     std::byte* buffer_ = nullptr;
     std::size_t capacity_ = 0;
-    std::size_t offset_ = 0;
+    std::size_t offset_ = 0;             // 当前块内偏移
+    bool growable_ = false;
+    PageBackend backend_ = PageBackend::Heap;
+    MemoryTag tag_ = MemoryTag::General;
+    std::size_t committed_ = 0;          // 主缓冲区已提交的字节数
+    Block* current_block_ = nullptr;     // 当前追加块（nullptr 表示主缓冲区）
+    Block* cached_blocks_ = nullptr;     // 可复用的追加块
+    std::size_t chained_capacity_ = 0;   // 活跃追加块容量之和
+    std::size_t used_before_ = 0;        // 当前块之前各块已使用的字节数
 };
 
 // ============================================================================
@@ -1,21 +1,36 @@
 #pragma once
 
 #include <atomic>
+#include <cassert>
 #include <cstddef>
+#include <cstdint>
 
 #include "cache_aligned_allocator.h"
 
 namespace Corona::Kernal::Memory {
 
 /// 无锁空闲链表节点
-struct alignas(CacheLineSize) LockFreeNode {
+///
+/// 节点通常直接嵌入空闲内存块（如 FixedPool 的无锁模式），对齐与间距由宿主决定，
+/// 因此节点本身不再强制按缓存行对齐
+struct LockFreeNode {
     std::atomic<LockFreeNode*> next{nullptr};
 };
 
 /// 无锁空闲链表（LIFO 栈）
 ///
-/// 使用 CAS 操作实现无锁并发访问
-/// 适用于高竞争场景下的空闲块管理
+/// 使用 CAS 操作实现无锁并发访问，适用于高竞争场景下的空闲块管理
+///
+/// ABA 防护：
+/// - 栈顶指针与一个版本号打包在同一个 64 位字中（指针占低 kPointerBits 位，版本号占高位），
+///   每次 pop 成功都会递增版本号
+/// - 即使节点在 pop 读取 next 与 CAS 之间被其他线程弹出并重新压入，版本号也已变化，CAS 必然失败
+/// - 单字 CAS 在所有平台上都是无锁的，无需 16 字节 CAS（cmpxchg16b）
+/// - 64 位平台假定用户态地址不超过 48 位（x86-64 / ARM64 的 Windows、Linux 均满足），
+///   版本号为 16 位，只有在一次 pop 的读-CAS 窗口内恰好发生 65536 次 pop 才会误判
+///
+/// 节点内存必须在栈的使用期间保持可读：pop 可能读取已被其他线程取走的节点的 next，
+/// 该值随后因版本号不匹配被丢弃。已弹出节点的 next 只应以原子方式改写（如再次 push）
 class LockFreeStack {
    public:
     LockFreeStack() = default;
@@ -31,50 +46,67 @@ class LockFreeStack {
 
     /// 压入节点
     /// @param node 要压入的节点
-    void push(LockFreeNode* node) noexcept {
-        if (!node) {
+    void push(LockFreeNode* node) noexcept { push_list(node, node); }
+
+    /// 一次 CAS 压入一条已链接的节点链（first -> ... -> last）
+    /// @param first 链首节点（出栈时最先弹出）
+    /// @param last 链尾节点
+    void push_list(LockFreeNode* first, LockFreeNode* last) noexcept {
+        if (!first || !last) {
             return;
         }
 
-        LockFreeNode* old_head = head_.load(std::memory_order_relaxed);
+        // push 不会造成 ABA（不读取旧栈顶节点的内容），只需保留版本号
+        std::uint64_t old_head = head_.load(std::memory_order_relaxed);
+        std::uint64_t new_head;
         do {
-            node->next.store(old_head, std::memory_order_relaxed);
-        } while (!head_.compare_exchange_weak(old_head, node, std::memory_order_release,
+            last->next.store(pointer_of(old_head), std::memory_order_relaxed);
+            new_head = pack(first, tag_of(old_head));
+        } while (!head_.compare_exchange_weak(old_head, new_head, std::memory_order_release,
                                               std::memory_order_relaxed));
     }
 
     /// 弹出节点
     /// @return 弹出的节点，如果栈为空返回 nullptr
     [[nodiscard]] LockFreeNode* pop() noexcept {
-        LockFreeNode* old_head = head_.load(std::memory_order_acquire);
-        while (old_head) {
-            LockFreeNode* next = old_head->next.load(std::memory_order_relaxed);
-            if (head_.compare_exchange_weak(old_head, next, std::memory_order_acquire,
-                                            std::memory_order_relaxed)) {
-                return old_head;
+        std::uint64_t old_head = head_.load(std::memory_order_acquire);
+        while (LockFreeNode* node = pointer_of(old_head)) {
+            LockFreeNode* next = node->next.load(std::memory_order_relaxed);
+            if (head_.compare_exchange_weak(old_head, pack(next, tag_of(old_head) + 1), std::memory_order_acquire,
+                                            std::memory_order_acquire)) {
+                return node;
             }
-            // CAS 失败，old_head 已被更新，重试
+            // CAS 失败，old_head 已被更新（版本号不同），重试
         }
         return nullptr;
     }
 
-    /// 检查是否为空
-    [[nodiscard]] bool empty() const noexcept {
-        return head_.load(std::memory_order_acquire) == nullptr;
+    /// 一次性取走整条链（调用者获得链的所有权）
+    /// @return 原栈顶节点，栈为空返回 nullptr
+    [[nodiscard]] LockFreeNode* take_all() noexcept {
+        std::uint64_t old_head = head_.load(std::memory_order_relaxed);
+        while (!head_.compare_exchange_weak(old_head, pack(nullptr, tag_of(old_head) + 1), std::memory_order_acquire,
+                                            std::memory_order_relaxed)) {
+        }
+        return pointer_of(old_head);
     }
 
-    /// 获取当前头节点（仅用于调试）
-    [[nodiscard]] LockFreeNode* peek() const noexcept {
-        return head_.load(std::memory_order_acquire);
-    }
+    /// 检查是否为空
+    [[nodiscard]] bool empty() const noexcept { return peek() == nullptr; }
+
+    /// 获取当前头节点（不弹出；调用者需保证读取节点期间节点内存有效）
+    [[nodiscard]] LockFreeNode* peek() const noexcept { return pointer_of(head_.load(std::memory_order_acquire)); }
+
+    /// 获取当前版本号（仅用于调试）
+    [[nodiscard]] std::uint64_t tag() const noexcept { return tag_of(head_.load(std::memory_order_acquire)); }
 
     /// 清空栈（注意：不会释放节点内存）
-    void clear() noexcept { head_.store(nullptr, std::memory_order_release); }
+    void clear() noexcept { (void)take_all(); }
 
     /// 获取大致的节点数量（可能不精确）
     [[nodiscard]] std::size_t approximate_size() const noexcept {
         std::size_t count = 0;
-        LockFreeNode* current = head_.load(std::memory_order_acquire);
+        LockFreeNode* current = peek();
         while (current) {
             ++count;
             current = current->next.load(std::memory_order_relaxed);
@@ -83,7 +115,25 @@ class LockFreeStack {
     }
 
    private:
-    std::atomic<LockFreeNode*> head_{nullptr};
+    /// 指针所占位数（其余高位存放版本号）
+    static constexpr unsigned kPointerBits = sizeof(void*) == 8 ? 48 : 32;
+    static constexpr std::uint64_t kPointerMask = (std::uint64_t{1} << kPointerBits) - 1;
+
+    static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "LockFreeStack requires lock-free 64-bit atomics");
+
+    [[nodiscard]] static std::uint64_t pack(LockFreeNode* node, std::uint64_t tag) noexcept {
+        const auto address = static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(node));
+        assert((address & ~kPointerMask) == 0 && "Node address exceeds LockFreeStack pointer bits");
+        return address | (tag << kPointerBits);
+    }
+
+    [[nodiscard]] static LockFreeNode* pointer_of(std::uint64_t value) noexcept {
+        return reinterpret_cast<LockFreeNode*>(static_cast<std::uintptr_t>(value & kPointerMask));
+    }
+
+    [[nodiscard]] static std::uint64_t tag_of(std::uint64_t value) noexcept { return value >> kPointerBits; }
+
+    std::atomic<std::uint64_t> head_{0};  ///< 打包的 栈顶指针 | 版本号
 };
 
 }  // namespace Corona::Kernal::Memory
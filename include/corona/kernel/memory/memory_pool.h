@@ -7,20 +7,32 @@
 /// - PoolConfig: 内存池配置
 /// - FixedPool: 固定大小块内存池
 /// - ObjectPool: 类型安全对象池
+/// - HandlePool: 32 位索引+版本号句柄的对象池（稠密存储、悬空句柄检测）
 /// - LinearArena: 线性分配器
-/// - FrameArena: 双缓冲帧分配器
-/// - LockFreeStack: 无锁空闲链表
+/// - FrameArena: 多缓冲帧分配器（支持工作线程子分配器）
+/// - LockFreeStack: ABA 安全的无锁空闲链表（FixedPool 无锁模式的共享空闲链表）
 /// - ThreadLocalPool: 线程本地对象池
+/// - SizeClassAllocator: 尺寸分级通用分配器（std::pmr::memory_resource）
+/// - ArenaResource / FrameArenaResource: 线性/帧分配器的 std::pmr 适配器
+/// - PageBackend: mmap / VirtualAlloc / 大页内存后端（FixedPool、LinearArena、FrameArena 可选）
+/// - MemoryTracker: 按标签汇总各分配器的内存占用、峰值、分配速率与预算
+/// - EpochManager: 基于纪元的延迟回收（无锁读者持有的对象在所有读者离开后才删除）
 
+#include "arena_resource.h"
 #include "cache_aligned_allocator.h"
 #include "chunk.h"
+#include "epoch_manager.h"
 #include "fixed_pool.h"
 #include "frame_arena.h"
+#include "handle_pool.h"
 #include "linear_arena.h"
 #include "lock_free_stack.h"
+#include "memory_tracker.h"
 #include "object_pool.h"
 #include "pool_config.h"
+#include "size_class_allocator.h"
 #include "thread_local_pool.h"
+#include "virtual_memory.h"
 
 namespace Corona::Kernal::Memory {
 
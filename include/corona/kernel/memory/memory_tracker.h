@@ -0,0 +1,182 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "cache_aligned_allocator.h"
+
+namespace Corona::Kernal::Memory {
+
+/// 内存标签（按子系统归类分配器占用的内存）
+enum class MemoryTag : std::uint8_t {
+    General,  ///< 未归类
+    ECS,      ///< ECS Chunk 与组件数据
+    Events,   ///< 事件总线 / 事件流
+    Systems,  ///< 系统调度
+    Storage,  ///< Utils::Storage 对象池
+    Frame,    ///< 帧分配器
+    Plugins,  ///< 插件
+    VFS,      ///< 虚拟文件系统
+    User0,    ///< 应用自定义标签
+    User1,
+    User2,
+    User3,
+    User4,
+    User5,
+    User6,
+    User7,
+    Count,
+};
+
+/// 标签数量
+inline constexpr std::size_t kMemoryTagCount = static_cast<std::size_t>(MemoryTag::Count);
+
+/// 获取标签名称
+[[nodiscard]] const char* memory_tag_name(MemoryTag tag) noexcept;
+
+/// 单个标签的统计信息
+struct TagStats {
+    std::size_t current_bytes = 0;          ///< 当前占用（字节）
+    std::size_t peak_bytes = 0;             ///< 峰值占用（字节）
+    std::uint64_t total_allocated_bytes = 0;  ///< 累计分配字节数
+    std::uint64_t total_freed_bytes = 0;      ///< 累计释放字节数
+    std::uint64_t allocation_count = 0;       ///< 累计分配次数
+    std::uint64_t deallocation_count = 0;     ///< 累计释放次数
+    double allocation_rate = 0.0;           ///< 两次 sample() 之间的分配次数 / 秒
+    double allocated_bytes_rate = 0.0;      ///< 两次 sample() 之间的分配字节数 / 秒
+    std::size_t budget_bytes = 0;           ///< 预算（0 = 不限制）
+
+    /// 是否超出预算
+    [[nodiscard]] bool over_budget() const noexcept { return budget_bytes > 0 && current_bytes > budget_bytes; }
+};
+
+/// 按标签汇总内核分配器内存占用的全局追踪器
+///
+/// 设计原理：
+/// - 记录的是分配器向系统申请/归还的内存（Chunk、Arena、缓冲区），而非分配器内部的每次小块分配，
+///   因此 current_bytes 反映各子系统的真实内存占用，且记录频率很低
+/// - 每个线程持有自己的计数器，只由所属线程以 relaxed 读写更新（无原子读改写、无竞争），查询时汇总所有线程
+/// - 线程退出时计数器并入全局累计值
+/// - 峰值：线程本地净增量超过 kPeakFlushThreshold 时才并入全局近似占用并更新峰值，
+///   查询时再以精确占用校正，误差不超过 线程数 × kPeakFlushThreshold
+class MemoryTracker {
+   public:
+    /// 线程本地净增量并入峰值统计的阈值（64KB）
+    static constexpr std::int64_t kPeakFlushThreshold = 64 * 1024;
+
+    /// 获取全局实例
+    [[nodiscard]] static MemoryTracker& instance();
+
+    MemoryTracker(const MemoryTracker&) = delete;
+    MemoryTracker& operator=(const MemoryTracker&) = delete;
+
+    /// 记录一次分配（无锁，可在任意线程调用）
+    void record_allocation(MemoryTag tag, std::size_t bytes) noexcept;
+
+    /// 记录一次释放（无锁，可在任意线程调用）
+    void record_deallocation(MemoryTag tag, std::size_t bytes) noexcept;
+
+    /// 查询单个标签的统计信息（速率为最近一次 sample() 的结果）
+    [[nodiscard]] TagStats stats(MemoryTag tag) const;
+
+    /// 采样所有标签：汇总计数器并根据与上次采样的间隔计算分配速率（建议每帧或定期调用）
+    std::array<TagStats, kMemoryTagCount> sample();
+
+    /// 所有标签当前占用之和（字节）
+    [[nodiscard]] std::size_t total_bytes() const;
+
+    /// 设置标签预算（0 = 不限制）
+    void set_budget(MemoryTag tag, std::size_t bytes) noexcept;
+
+    /// 获取标签预算
+    [[nodiscard]] std::size_t budget(MemoryTag tag) const noexcept;
+
+    /// 再分配 additional 字节后是否会超出预算（可供分配前检查以强制执行预算）
+    [[nodiscard]] bool would_exceed_budget(MemoryTag tag, std::size_t additional) const;
+
+    /// 将峰值重置为当前占用
+    void reset_peaks();
+
+   private:
+    /// 单个线程、单个标签的计数器（仅所属线程写入）
+    struct Counters {
+        std::atomic<std::uint64_t> allocated_bytes{0};
+        std::atomic<std::uint64_t> freed_bytes{0};
+        std::atomic<std::uint64_t> allocation_count{0};
+        std::atomic<std::uint64_t> deallocation_count{0};
+        std::int64_t pending = 0;  ///< 尚未并入峰值统计的净增量
+    };
+
+    /// 单个线程的计数器块（独占缓存行，避免与其他线程的计数器伪共享）
+    struct alignas(CacheLineSize) ThreadCounters {
+        std::array<Counters, kMemoryTagCount> tags;
+    };
+
+    /// 汇总后的原始计数
+    struct Totals {
+        std::uint64_t allocated_bytes = 0;
+        std::uint64_t freed_bytes = 0;
+        std::uint64_t allocation_count = 0;
+        std::uint64_t deallocation_count = 0;
+    };
+
+    /// 上次采样的计数（用于计算速率）
+    struct RateSample {
+        std::uint64_t allocated_bytes = 0;
+        std::uint64_t allocation_count = 0;
+        double allocation_rate = 0.0;
+        double allocated_bytes_rate = 0.0;
+    };
+
+    class ThreadRegistration;
+
+    MemoryTracker() = default;
+
+    /// 获取当前线程的计数器块（首次调用时注册；线程退出阶段已注销时返回 nullptr）
+    [[nodiscard]] ThreadCounters* local_counters();
+
+    /// 线程计数器注销后直接计入累计值（加锁，仅在线程退出阶段使用）
+    void record_retired(std::size_t tag, std::size_t bytes, bool allocation) noexcept;
+
+    /// 注销线程，计数并入 retired_
+    void retire(ThreadCounters* counters);
+
+    /// 汇总所有线程的计数（需持有 mutex_）
+    [[nodiscard]] Totals totals_locked(std::size_t tag) const;
+
+    /// 并入线程本地增量并更新峰值
+    void flush_pending(std::size_t tag, std::int64_t delta) noexcept;
+
+    /// 以精确占用校正峰值
+    void raise_peak(std::size_t tag, std::size_t current) const noexcept;
+
+    /// 根据汇总计数构建统计信息（需持有 mutex_）
+    [[nodiscard]] TagStats make_stats_locked(std::size_t tag) const;
+
+    mutable std::mutex mutex_;                         ///< 保护线程列表、退出线程累计值与速率采样
+    std::vector<ThreadCounters*> threads_;             ///< 已注册线程的计数器块
+    std::array<Totals, kMemoryTagCount> retired_{};    ///< 已退出线程的累计计数
+    std::array<RateSample, kMemoryTagCount> rates_{};  ///< 上次采样结果
+    std::chrono::steady_clock::time_point last_sample_ = std::chrono::steady_clock::now();
+
+    std::array<std::atomic<std::int64_t>, kMemoryTagCount> approx_current_{};  ///< 已并入的近似占用
+    mutable std::array<std::atomic<std::size_t>, kMemoryTagCount> peak_{};      ///< 峰值占用
+    std::array<std::atomic<std::size_t>, kMemoryTagCount> budget_{};            ///< 预算
+};
+
+/// 记录一次带标签的分配（MemoryTracker::instance().record_allocation 的简写）
+inline void track_allocation(MemoryTag tag, std::size_t bytes) noexcept {
+    MemoryTracker::instance().record_allocation(tag, bytes);
+}
+
+/// 记录一次带标签的释放（MemoryTracker::instance().record_deallocation 的简写）
+inline void track_deallocation(MemoryTag tag, std::size_t bytes) noexcept {
+    MemoryTracker::instance().record_deallocation(tag, bytes);
+}
+
+}  // namespace Corona::Kernal::Memory
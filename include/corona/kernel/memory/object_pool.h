@@ -22,7 +22,7 @@ class ObjectPool {
 
     /// 构造函数
     /// @param initial_capacity 初始容量
-    /// @param thread_safe 是否线程安全
+    /// @param thread_safe 是否线程安全（启用时使用线程本地弹匣缓存）
     explicit ObjectPool(std::size_t initial_capacity = 64, bool thread_safe = true);
 
     /// 析构函数（注意：不会自动销毁活跃对象）
@@ -81,6 +81,7 @@ ObjectPool<T>::ObjectPool(std::size_t initial_capacity, bool thread_safe)
           .max_chunks = 0,
           .thread_safe = thread_safe,
           .enable_debug = false,
+          .magazine_size = thread_safe ? kDefaultMagazineSize : 0,
       }) {}
 
 template <typename T>
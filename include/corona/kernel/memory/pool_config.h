@@ -3,6 +3,8 @@
 #include <cstddef>
 
 #include "cache_aligned_allocator.h"
+#include "memory_tracker.h"
+#include "virtual_memory.h"
 
 namespace Corona::Kernal::Memory {
 
@@ -10,6 +12,7 @@ namespace Corona::Kernal::Memory {
 inline constexpr std::size_t kDefaultChunkSize = 64 * 1024;  // 64 KB
 inline constexpr std::size_t kMinBlockSize = 16;             // 最小块大小（需要能存放指针）
 inline constexpr std::size_t kMaxBlockSize = 4096;           // 最大块大小
+inline constexpr std::size_t kDefaultMagazineSize = 32;      // 默认线程本地弹匣容量（块数）
 
 /// 内存池配置
 struct PoolConfig {
@@ -20,6 +23,10 @@ struct PoolConfig {
     std::size_t max_chunks = 0;                   ///< 最大 Chunk 数量 (0 = 无限制)
     bool thread_safe = true;                      ///< 是否线程安全
     bool enable_debug = false;                    ///< 是否启用调试功能
+    std::size_t magazine_size = 0;                ///< 线程本地弹匣批量大小 (0 = 禁用，仅 thread_safe 时生效)
+    bool lock_free = false;                       ///< 空闲链表使用无锁栈（隐含 thread_safe，忽略 magazine_size）
+    PageBackend backend = PageBackend::Heap;      ///< Chunk 内存后端（HugePages 仅在 chunk_size >= 大页时生效）
+    MemoryTag tag = MemoryTag::General;           ///< Chunk 内存计入的 MemoryTracker 标签
 
     /// 验证配置是否有效
     [[nodiscard]] constexpr bool is_valid() const noexcept {
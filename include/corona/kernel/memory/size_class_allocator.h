@@ -0,0 +1,130 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+
+#include "fixed_pool.h"
+#include "pool_config.h"
+
+namespace Corona::Kernal::Memory {
+
+/// 尺寸分级分配器配置
+struct SizeClassConfig {
+    std::size_t chunk_size = kDefaultChunkSize;         ///< 各级 FixedPool 的 Chunk 大小
+    bool thread_safe = true;                            ///< 是否线程安全
+    std::size_t magazine_size = kDefaultMagazineSize;   ///< 线程本地弹匣批量大小（仅 thread_safe 时生效）
+    std::pmr::memory_resource* upstream = nullptr;      ///< 大块分配的上游资源（nullptr = new_delete_resource）
+    MemoryTag tag = MemoryTag::General;                 ///< Chunk 与大块分配计入的 MemoryTracker 标签
+};
+
+/// 尺寸分级通用分配器
+///
+/// 把 [kMinBlockSize, kMaxBlockSize] 区间划分为一组尺寸级别，每级由一个 FixedPool 提供内存：
+/// - 128 字节以内按 16 字节递增（16, 32, ..., 128）
+/// - 之后每个 2 的幂区间划分为 4 级（160, 192, 224, 256, 320, ..., 4096），内部浪费不超过 25%
+/// - 超过 kMaxBlockSize 或对齐要求超过级别自然对齐的请求转交上游资源
+///
+/// 作为 std::pmr::memory_resource 使用，可直接驱动标准容器：
+/// @code
+/// SizeClassAllocator allocator;
+/// std::pmr::vector<int> values(&allocator);
+/// std::pmr::string name("pooled", &allocator);
+/// @endcode
+///
+/// @note 释放时依赖 deallocate 传入的 bytes/alignment 与分配时一致（pmr 约定）
+class SizeClassAllocator : public std::pmr::memory_resource {
+   public:
+    /// 尺寸级别数量
+    static constexpr std::size_t kClassCount = 28;
+
+    /// 构造函数
+    /// @param config 分配器配置
+    explicit SizeClassAllocator(const SizeClassConfig& config = {});
+
+    /// 析构函数（释放所有级别的 Chunk；未归还的大块分配不会被回收）
+    ~SizeClassAllocator() override;
+
+    /// 禁用拷贝和移动（容器持有的是资源地址）
+    SizeClassAllocator(const SizeClassAllocator&) = delete;
+    SizeClassAllocator& operator=(const SizeClassAllocator&) = delete;
+
+    /// 获取请求大小对应的级别下标
+    /// @param bytes 请求字节数
+    /// @return 级别下标；超过 kMaxBlockSize 返回 kClassCount
+    [[nodiscard]] static constexpr std::size_t size_class_index(std::size_t bytes) noexcept {
+        if (bytes <= 128) {
+            return bytes == 0 ? 0 : (bytes - 1) / 16;
+        }
+        if (bytes > kMaxBlockSize) {
+            return kClassCount;
+        }
+        // 2^(k-1) < bytes <= 2^k，区间内步长为 2^(k-3)
+        std::size_t k = 0;
+        for (std::size_t v = bytes - 1; v != 0; v >>= 1) {
+            ++k;
+        }
+        return 8 + (k - 8) * 4 + ((bytes - 1 - (std::size_t{1} << (k - 1))) >> (k - 3));
+    }
+
+    /// 获取级别的块大小
+    /// @param index 级别下标（< kClassCount）
+    [[nodiscard]] static constexpr std::size_t class_size(std::size_t index) noexcept {
+        if (index < 8) {
+            return 16 * (index + 1);
+        }
+        const std::size_t group = (index - 8) / 4;
+        const std::size_t step = std::size_t{32} << group;
+        return (std::size_t{128} << group) + ((index - 8) % 4 + 1) * step;
+    }
+
+    /// 获取级别的块对齐（块大小的最低位，不超过缓存行）
+    /// @param index 级别下标（< kClassCount）
+    [[nodiscard]] static constexpr std::size_t class_alignment(std::size_t index) noexcept {
+        const std::size_t size = class_size(index);
+        const std::size_t lowest_bit = size & (~size + 1);
+        return lowest_bit < CacheLineSize ? lowest_bit : CacheLineSize;
+    }
+
+    /// 获取指定级别的内存池
+    [[nodiscard]] const FixedPool& pool(std::size_t index) const noexcept { return *pools_[index]; }
+
+    /// 获取所有级别的汇总统计（不含大块分配）
+    [[nodiscard]] PoolStats stats() const noexcept;
+
+    /// 当前由上游资源提供的大块分配字节数
+    [[nodiscard]] std::size_t large_bytes() const noexcept { return large_bytes_.load(std::memory_order_relaxed); }
+
+    /// 累计大块分配次数
+    [[nodiscard]] std::size_t large_allocation_count() const noexcept {
+        return large_allocation_count_.load(std::memory_order_relaxed);
+    }
+
+    /// 释放各级别中未使用的 Chunk
+    void shrink_to_fit();
+
+    /// 获取上游资源
+    [[nodiscard]] std::pmr::memory_resource* upstream() const noexcept { return upstream_; }
+
+   protected:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment) override;
+    [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+   private:
+    /// 选择可同时满足大小和对齐的级别，无法满足返回 kClassCount
+    [[nodiscard]] static std::size_t select_class(std::size_t bytes, std::size_t alignment) noexcept;
+
+    std::array<std::unique_ptr<FixedPool>, kClassCount> pools_;
+    std::pmr::memory_resource* upstream_;
+    MemoryTag tag_;
+    std::atomic<std::size_t> large_bytes_{0};
+    std::atomic<std::size_t> large_allocation_count_{0};
+};
+
+static_assert(SizeClassAllocator::class_size(SizeClassAllocator::kClassCount - 1) == kMaxBlockSize);
+static_assert(SizeClassAllocator::size_class_index(kMaxBlockSize) == SizeClassAllocator::kClassCount - 1);
+
+}  // namespace Corona::Kernal::Memory
@@ -1,8 +1,13 @@
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
 #include <utility>
 
-#include "object_pool.h"
+#include "fixed_pool.h"
 
 namespace Corona::Kernal::Memory {
 
@@ -10,6 +15,14 @@ namespace Corona::Kernal::Memory {
 ///
 /// 每个线程拥有独立的对象池实例，避免线程间竞争
 /// 适用于高频创建/销毁对象的多线程场景
+///
+/// 跨线程销毁：
+/// - 每个对象前置一个槽位头，记录创建它的线程池
+/// - 在其他线程调用 destroy() 时，析构后将槽位压入所属池的无锁远程释放队列
+/// - 所属线程在下一次 create() 时整批回收队列中的槽位，池本身始终只由所属线程访问
+/// - 线程退出后，其池在最后一个对象被销毁时才释放，存活对象不会悬空
+///
+/// 因此生产者/消费者之间可以安全地传递 make_thread_local_unique 创建的对象
 template <typename T>
 class ThreadLocalPool {
    public:
@@ -20,40 +33,119 @@ class ThreadLocalPool {
     /// 默认池容量
     static constexpr std::size_t kDefaultCapacity = 256;
 
-    /// 获取当前线程的池实例
-    static ObjectPool<T>& instance() {
-        thread_local ObjectPool<T> pool(kDefaultCapacity, false);  // 线程内无需同步
-        return pool;
-    }
-
-    /// 创建对象
+    /// 创建对象（从当前线程的池分配）
     /// @param args 构造函数参数
     /// @return 新创建的对象指针
+    /// @throw std::bad_alloc 如果分配失败
     template <typename... Args>
-    [[nodiscard]] static pointer create(Args&&... args) {
-        return instance().create(std::forward<Args>(args)...);
-    }
+    [[nodiscard]] static pointer create(Args&&... args);
 
-    /// 销毁对象
+    /// 销毁对象（可在任意线程调用，内存归还给创建对象的线程池）
     /// @param obj 要销毁的对象
-    static void destroy(pointer obj) noexcept { instance().destroy(obj); }
+    static void destroy(pointer obj) noexcept;
+
+    /// 立即回收其他线程归还给当前线程池的对象
+    static void drain_remote_frees() noexcept { drain(local_shard()); }
 
     /// 获取当前线程池的统计信息
-    [[nodiscard]] static PoolStats stats() { return instance().stats(); }
+    [[nodiscard]] static PoolStats stats() { return local_shard().pool.stats(); }
 
-    /// 获取当前线程池的活跃对象数
-    [[nodiscard]] static std::size_t size() { return instance().size(); }
+    /// 获取当前线程池的活跃对象数（包含已移交给其他线程、尚未销毁的对象）
+    [[nodiscard]] static std::size_t size() {
+        const Shard& shard = local_shard();
+        return shard.refs.load(std::memory_order_relaxed) - 1 - shard.credit;
+    }
 
     /// 获取当前线程池的容量
-    [[nodiscard]] static std::size_t capacity() { return instance().capacity(); }
+    [[nodiscard]] static std::size_t capacity() { return local_shard().pool.total_blocks(); }
 
-    /// 获取当前线程池的可用槽位数
-    [[nodiscard]] static std::size_t available() { return instance().available(); }
+    /// 获取当前线程池的可用槽位数（不含远程释放队列中尚未回收的槽位）
+    [[nodiscard]] static std::size_t available() { return local_shard().pool.free_blocks(); }
 
    private:
-    // 禁止实例化
+    struct Shard;
+
+    /// 对象槽位：槽位头 + 对象存储
+    struct Slot {
+        union {
+            Shard* owner;       ///< 存活期间：所属线程池
+            Slot* next_remote;  ///< 位于远程释放队列中：下一个槽位
+        };
+        alignas(T) std::byte storage[sizeof(T)];
+    };
+
+    /// 单个线程的池
+    struct Shard {
+        Shard()
+            : pool(PoolConfig{
+                  .block_size = align_up(sizeof(Slot), alignof(Slot)),
+                  .block_alignment = std::max(alignof(Slot), CacheLineSize),
+                  .chunk_size = kDefaultChunkSize,
+                  .initial_chunks = (kDefaultCapacity * sizeof(Slot) + kDefaultChunkSize - 1) / kDefaultChunkSize,
+                  .thread_safe = false,  // 仅所属线程（或最后的释放者）访问
+              }) {}
+
+        FixedPool pool;
+        std::size_t credit = 0;  ///< 所属线程预留的引用数（避免每次分配都修改 refs）
+
+        /// 远程释放队列（多生产者，所属线程整体取走）
+        alignas(CacheLineSize) std::atomic<Slot*> remote_head{nullptr};
+
+        /// 引用计数 = 1（所属线程存活）+ 存活对象数 + credit，归零时释放池
+        alignas(CacheLineSize) std::atomic<std::size_t> refs{1};
+    };
+
+    /// 线程退出时释放所属线程的引用
+    struct ShardHolder {
+        Shard* shard = nullptr;
+
+        ~ShardHolder() {
+            Shard* owned = std::exchange(shard, nullptr);
+            if (!owned) {
+                return;
+            }
+            drain(*owned);
+            const std::size_t release = owned->credit + 1;
+            owned->credit = 0;
+            if (owned->refs.fetch_sub(release, std::memory_order_acq_rel) == release) {
+                delete owned;
+            }
+        }
+    };
+
+    /// 所属线程每次预留的引用数
+    static constexpr std::size_t kRefBatch = 64;
+
     ThreadLocalPool() = delete;
     ~ThreadLocalPool() = delete;
+
+    [[nodiscard]] static ShardHolder& holder() noexcept {
+        thread_local ShardHolder instance;
+        return instance;
+    }
+
+    /// 获取当前线程的池（首次调用时创建）
+    [[nodiscard]] static Shard& local_shard() {
+        ShardHolder& local = holder();
+        if (!local.shard) {
+            local.shard = new Shard();
+        }
+        return *local.shard;
+    }
+
+    [[nodiscard]] static Slot* slot_of(pointer obj) noexcept {
+        return reinterpret_cast<Slot*>(reinterpret_cast<std::byte*>(obj) - offsetof(Slot, storage));
+    }
+
+    /// 回收远程释放队列中的所有槽位（仅所属线程调用）
+    static void drain(Shard& shard) noexcept {
+        Slot* slot = shard.remote_head.exchange(nullptr, std::memory_order_acquire);
+        while (slot) {
+            Slot* next = slot->next_remote;
+            shard.pool.deallocate(slot);
+            slot = next;
+        }
+    }
 };
 
 /// 线程本地池智能指针删除器
@@ -72,4 +164,73 @@ template <typename T, typename... Args>
     return ThreadLocalUniquePtr<T>(ThreadLocalPool<T>::create(std::forward<Args>(args)...));
 }
 
+// ============================================================================
+// 实现
+// ============================================================================
+
+template <typename T>
+template <typename... Args>
+T* ThreadLocalPool<T>::create(Args&&... args) {
+    Shard& shard = local_shard();
+    if (shard.remote_head.load(std::memory_order_relaxed)) {
+        drain(shard);
+    }
+
+    void* memory = shard.pool.allocate();
+    if (!memory) {
+        throw std::bad_alloc();
+    }
+
+    auto* slot = new (memory) Slot;
+    slot->owner = &shard;
+    pointer obj;
+    try {
+        obj = new (slot->storage) T(std::forward<Args>(args)...);
+    } catch (...) {
+        shard.pool.deallocate(memory);
+        throw;
+    }
+
+    if (shard.credit == 0) {
+        // 所属线程存活时 refs 不会归零，relaxed 即可
+        shard.refs.fetch_add(kRefBatch, std::memory_order_relaxed);
+        shard.credit = kRefBatch;
+    }
+    --shard.credit;
+    return obj;
+}
+
+template <typename T>
+void ThreadLocalPool<T>::destroy(pointer obj) noexcept {
+    if (!obj) {
+        return;
+    }
+
+    Slot* slot = slot_of(obj);
+    Shard* owner = slot->owner;
+    obj->~T();
+
+    if (owner == holder().shard) {
+        // 本线程创建的对象：直接归还
+        owner->pool.deallocate(slot);
+        if (++owner->credit > 2 * kRefBatch) {
+            owner->refs.fetch_sub(kRefBatch, std::memory_order_relaxed);
+            owner->credit -= kRefBatch;
+        }
+        return;
+    }
+
+    // 其他线程创建的对象：压入所属池的远程释放队列
+    Slot* head = owner->remote_head.load(std::memory_order_relaxed);
+    do {
+        slot->next_remote = head;
+    } while (!owner->remote_head.compare_exchange_weak(head, slot, std::memory_order_release,
+                                                       std::memory_order_relaxed));
+
+    // 所属线程已退出且这是最后一个对象：释放整个池（队列中的槽位随 Chunk 一并释放）
+    if (owner->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        delete owner;
+    }
+}
+
 }  // namespace Corona::Kernal::Memory
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Corona::Kernal::Memory {
+
+/// 大块内存的分配后端
+enum class PageBackend : std::uint8_t {
+    Heap,           ///< aligned_malloc（默认）
+    VirtualMemory,  ///< 直接向系统保留地址空间（mmap / VirtualAlloc），按需提交
+    HugePages,      ///< 同 VirtualMemory，并尽量使用大页以减少 TLB 缺失
+};
+
+/// 当前平台是否支持 VirtualMemory / HugePages 后端
+[[nodiscard]] bool virtual_memory_supported() noexcept;
+
+/// 系统页大小（通常为 4KB）
+[[nodiscard]] std::size_t system_page_size() noexcept;
+
+/// 大页大小（Linux 通常为 2MB；不支持时返回 system_page_size()）
+[[nodiscard]] std::size_t huge_page_size() noexcept;
+
+/// 后端的映射粒度：保留大小按此取整，返回地址按此对齐
+/// @param backend VirtualMemory 返回系统页大小，HugePages 返回大页大小
+[[nodiscard]] std::size_t page_granularity(PageBackend backend) noexcept;
+
+/// 保留一段地址空间（不提交物理内存，访问前需 commit_pages）
+///
+/// HugePages 后端在 Linux 上先尝试 MAP_HUGETLB（需要预留 hugetlbfs 页），
+/// 失败时退回普通映射并通过 madvise(MADV_HUGEPAGE) 请求透明大页；
+/// 在 Windows 上尝试 MEM_LARGE_PAGES（需要 SeLockMemoryPrivilege，且会立即提交），失败时退回普通页。
+///
+/// @param size 保留大小，必须是 page_granularity(backend) 的整数倍
+/// @param backend VirtualMemory 或 HugePages
+/// @return 按 page_granularity(backend) 对齐的地址，失败返回 nullptr
+[[nodiscard]] void* reserve_pages(std::size_t size, PageBackend backend) noexcept;
+
+/// 提交已保留地址空间中的一段（使其可读写）
+/// @param ptr 起始地址（按系统页对齐）
+/// @param size 大小（系统页的整数倍）
+/// @return 成功返回 true
+bool commit_pages(void* ptr, std::size_t size) noexcept;
+
+/// 归还一段已提交内存的物理页，地址空间保留，再次访问前需重新 commit_pages
+/// @param ptr 起始地址（按系统页对齐）
+/// @param size 大小（系统页的整数倍）
+void decommit_pages(void* ptr, std::size_t size) noexcept;
+
+/// 释放 reserve_pages 保留的整段地址空间
+/// @param ptr reserve_pages 的返回值
+/// @param size 保留时的大小
+void release_pages(void* ptr, std::size_t size) noexcept;
+
+// ============================================================================
+// 文件映射（持久化存储）
+// ============================================================================
+
+/// 可映射文件的平台句柄（POSIX 文件描述符 / Windows HANDLE）
+using FileHandle = std::intptr_t;
+
+/// 无效文件句柄
+inline constexpr FileHandle kInvalidFileHandle = -1;
+
+/// 映射偏移的对齐粒度（POSIX 为系统页大小，Windows 为分配粒度，通常 64KB）
+[[nodiscard]] std::size_t file_mapping_granularity() noexcept;
+
+/// 以读写方式打开文件（不存在则创建），并独占锁定，防止多个进程同时映射同一文件
+/// @param path 文件路径
+/// @param size 输出：文件当前长度
+/// @return 文件句柄，失败（含文件已被其他进程锁定）返回 kInvalidFileHandle
+[[nodiscard]] FileHandle open_mapped_file(const char* path, std::size_t& size) noexcept;
+
+/// 调整文件长度（扩展部分填零）
+bool resize_mapped_file(FileHandle file, std::size_t size) noexcept;
+
+/// 以共享读写方式映射文件的一段（写入直接反映到文件）
+/// @param offset 文件偏移，必须是 file_mapping_granularity() 的整数倍
+/// @param size 映射大小，offset + size 不得超过文件长度
+/// @return 映射地址，失败返回 nullptr
+[[nodiscard]] void* map_file(FileHandle file, std::size_t offset, std::size_t size) noexcept;
+
+/// 将映射中的修改同步写回文件（阻塞直到写入完成）
+bool flush_mapped_file(void* ptr, std::size_t size) noexcept;
+
+/// 解除 map_file 建立的映射
+void unmap_file(void* ptr, std::size_t size) noexcept;
+
+/// 关闭文件（已建立的映射仍然有效，直到 unmap_file）
+void close_mapped_file(FileHandle file) noexcept;
+
+}  // namespace Corona::Kernal::Memory
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+#include "corona/kernel/memory/cache_aligned_allocator.h"
+
+namespace Corona::Kernal::Utils {
+
+/**
+ * @brief 事件计数器 (Event Count)
+ *
+ * 让线程在“条件不满足”时休眠、并在条件可能变化时被唤醒的无锁同步原语，
+ * 通知方在没有等待者时只需一次内存屏障与一次读取，不加锁、不进入内核。
+ *
+ * @details 等待协议（避免丢失唤醒）：
+ * @code
+ * while (true) {
+ *     if (try_get_work()) { ... continue; }
+ *     const auto key = event.prepare_wait();  // 登记为等待者
+ *     if (try_get_work()) {                   // 登记后必须再检查一次条件
+ *         event.cancel_wait();
+ *         continue;
+ *     }
+ *     event.commit_wait(key);  // 登记之后发生过 notify 则立即返回
+ * }
+ * @endcode
+ * 通知方先发布条件（如推入任务），再调用 notify_one() / notify_all()。
+ *
+ * @details 实现：
+ * - epoch_ 为 32 位等待字，以 C++20 atomic::wait / notify 休眠与唤醒（Linux 为 futex，Windows 为 WaitOnAddress）
+ * - waiters_ 记录已登记的等待者数；为 0 时 notify 直接返回
+ * - 通知时递增 epoch_：已登记但尚未休眠的等待者在 commit_wait 中发现 epoch 变化，直接返回
+ * - notify_one 只唤醒一个休眠者；其余休眠者的 key 虽已过期，但在下次被唤醒时才返回，不会一起醒来
+ *
+ * @thread_safety 所有方法都是线程安全的
+ */
+class EventCount final {
+   public:
+    using Key = std::uint32_t;
+
+    EventCount() = default;
+    EventCount(const EventCount&) = delete;
+    EventCount& operator=(const EventCount&) = delete;
+
+    /**
+     * @brief 登记为等待者，返回当前纪元
+     *
+     * @note 之后必须调用 cancel_wait() 或 commit_wait() 之一
+     */
+    [[nodiscard]] Key prepare_wait() noexcept {
+        waiters_.fetch_add(1, std::memory_order_seq_cst);
+        // 与通知方的屏障配对：要么通知方看到本线程已登记，要么本线程随后的检查看到已发布的条件
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        return epoch_.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief 放弃等待（登记后发现条件已满足）
+     */
+    void cancel_wait() noexcept { waiters_.fetch_sub(1, std::memory_order_relaxed); }
+
+    /**
+     * @brief 休眠直到 prepare_wait() 之后有 notify 发生
+     *
+     * @param key prepare_wait() 的返回值
+     */
+    void commit_wait(Key key) noexcept {
+        while (epoch_.load(std::memory_order_acquire) == key) {
+            epoch_.wait(key, std::memory_order_acquire);
+        }
+        waiters_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief 唤醒一个等待者（没有等待者时无开销）
+     */
+    void notify_one() noexcept {
+        if (has_waiters()) {
+            epoch_.fetch_add(1, std::memory_order_release);
+            epoch_.notify_one();
+        }
+    }
+
+    /**
+     * @brief 唤醒所有等待者
+     */
+    void notify_all() noexcept {
+        if (has_waiters()) {
+            epoch_.fetch_add(1, std::memory_order_release);
+            epoch_.notify_all();
+        }
+    }
+
+    /**
+     * @brief 当前登记的等待者数（近似值）
+     */
+    [[nodiscard]] std::uint32_t waiters() const noexcept { return waiters_.load(std::memory_order_relaxed); }
+
+   private:
+    [[nodiscard]] bool has_waiters() noexcept {
+        // 与 prepare_wait 的屏障配对：调用方在此之前发布的条件对登记后再检查的等待者可见
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        return waiters_.load(std::memory_order_relaxed) != 0;
+    }
+
+    alignas(Memory::CacheLineSize) std::atomic<std::uint32_t> epoch_{0};  ///< 等待字（每次通知递增）
+    std::atomic<std::uint32_t> waiters_{0};                               ///< 已登记的等待者数
+};
+
+}  // namespace Corona::Kernal::Utils
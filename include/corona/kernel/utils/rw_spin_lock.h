@@ -0,0 +1,229 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#endif
+
+namespace Corona::Kernel::Utils {
+
+/**
+ * @brief 自旋等待时的 CPU 提示（降低功耗并让出超线程资源）
+ */
+inline void spin_pause() noexcept {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    _mm_pause();
+#elif defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+}
+
+/**
+ * @brief 8 字节的读写自旋锁，兼作顺序锁（seqlock）
+ *
+ * 状态打包在一个 64 位原子字中：
+ * @code
+ * ┌──────────────────────────────┬──────────────────────────────┬────────┐
+ * │  Version (32 bits)           │  Readers (31 bits)           │ Writer │
+ * └──────────────────────────────┴──────────────────────────────┴────────┘
+ * @endcode
+ *
+ * - 满足 SharedTimedLockable，可直接用于 std::unique_lock / std::shared_lock 及超时加锁
+ * - 写锁释放时递增版本号，乐观读者以 read_begin() / read_validate() 检测读取期间是否发生写入
+ * - 写者优先于新读者：写者置位后，新的共享加锁会等待，避免写者饥饿
+ *
+ * @note 自旋等待适用于临界区很短的场景（如 Storage 中小对象的读写），长时间持锁应使用 std::shared_timed_mutex
+ * @note 写者先置位写标志、再等待已有读者退出，因此写者等待期间同一线程不得再次加共享锁
+ */
+class RwSpinLock {
+   public:
+    RwSpinLock() noexcept = default;
+    ~RwSpinLock() = default;
+
+    RwSpinLock(const RwSpinLock&) = delete;
+    RwSpinLock& operator=(const RwSpinLock&) = delete;
+
+    // ========================================
+    // 独占锁
+    // ========================================
+
+    void lock() noexcept {
+        std::uint32_t spins = 0;
+        while (!try_acquire_writer_bit()) {
+            backoff(spins);
+        }
+        while (state_.load(std::memory_order_acquire) & kReaderMask) {
+            backoff(spins);
+        }
+    }
+
+    [[nodiscard]] bool try_lock() noexcept {
+        std::uint64_t state = state_.load(std::memory_order_relaxed);
+        if ((state & (kWriterBit | kReaderMask)) != 0 ||
+            !state_.compare_exchange_strong(state, state | kWriterBit, std::memory_order_acquire,
+                                            std::memory_order_relaxed)) {
+            return false;
+        }
+        std::atomic_thread_fence(std::memory_order_release);
+        return true;
+    }
+
+    void unlock() noexcept {
+        // 清除写标志并递增版本号（版本号溢出时自然回绕）
+        state_.fetch_add(kVersionUnit - kWriterBit, std::memory_order_release);
+    }
+
+    template <typename Rep, typename Period>
+    [[nodiscard]] bool try_lock_for(const std::chrono::duration<Rep, Period>& timeout) noexcept {
+        return try_lock_until(std::chrono::steady_clock::now() + timeout);
+    }
+
+    template <typename Clock, typename Duration>
+    [[nodiscard]] bool try_lock_until(const std::chrono::time_point<Clock, Duration>& deadline) noexcept {
+        std::uint32_t spins = 0;
+        while (!try_acquire_writer_bit()) {
+            if (Clock::now() >= deadline) {
+                return false;
+            }
+            backoff(spins);
+        }
+        while (state_.load(std::memory_order_acquire) & kReaderMask) {
+            if (Clock::now() >= deadline) {
+                state_.fetch_and(~kWriterBit, std::memory_order_relaxed);  // 放弃：撤销写标志，版本号不变
+                return false;
+            }
+            backoff(spins);
+        }
+        return true;
+    }
+
+    // ========================================
+    // 共享锁
+    // ========================================
+
+    void lock_shared() noexcept {
+        std::uint32_t spins = 0;
+        while (!try_lock_shared()) {
+            backoff(spins);
+        }
+    }
+
+    [[nodiscard]] bool try_lock_shared() noexcept {
+        std::uint64_t state = state_.load(std::memory_order_relaxed);
+        while ((state & kWriterBit) == 0) {
+            if (state_.compare_exchange_weak(state, state + kReaderUnit, std::memory_order_acquire,
+                                             std::memory_order_relaxed)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void unlock_shared() noexcept { state_.fetch_sub(kReaderUnit, std::memory_order_release); }
+
+    template <typename Rep, typename Period>
+    [[nodiscard]] bool try_lock_shared_for(const std::chrono::duration<Rep, Period>& timeout) noexcept {
+        return try_lock_shared_until(std::chrono::steady_clock::now() + timeout);
+    }
+
+    template <typename Clock, typename Duration>
+    [[nodiscard]] bool try_lock_shared_until(const std::chrono::time_point<Clock, Duration>& deadline) noexcept {
+        std::uint32_t spins = 0;
+        while (!try_lock_shared()) {
+            if (Clock::now() >= deadline) {
+                return false;
+            }
+            backoff(spins);
+        }
+        return true;
+    }
+
+    // ========================================
+    // 乐观读（顺序锁）
+    // ========================================
+
+    /**
+     * @brief 开始一次乐观读
+     *
+     * @return 版本快照；若当前有写者则返回 kWriteLocked，调用者应重试或改用共享锁
+     *
+     * @note 乐观读不修改锁状态，读者之间、读者与共享锁持有者之间均无缓存行争用
+     */
+    [[nodiscard]] std::uint64_t read_begin() const noexcept {
+        const std::uint64_t state = state_.load(std::memory_order_acquire);
+        return (state & kWriterBit) ? kWriteLocked : (state >> kVersionShift);
+    }
+
+    /**
+     * @brief 校验乐观读期间没有发生写入
+     *
+     * @param version read_begin() 返回的版本快照
+     * @return 读取期间无写者持锁且版本号未变化时返回 true，此时读到的数据一致
+     */
+    [[nodiscard]] bool read_validate(std::uint64_t version) const noexcept {
+        std::atomic_thread_fence(std::memory_order_acquire);
+        const std::uint64_t state = state_.load(std::memory_order_relaxed);
+        return version != kWriteLocked && (state & kWriterBit) == 0 && (state >> kVersionShift) == version;
+    }
+
+    /**
+     * @brief 获取当前版本号（已完成的写锁次数，仅用于调试）
+     */
+    [[nodiscard]] std::uint64_t version() const noexcept {
+        return state_.load(std::memory_order_acquire) >> kVersionShift;
+    }
+
+    /// read_begin() 在写者持锁时返回的哨兵值
+    static constexpr std::uint64_t kWriteLocked = ~std::uint64_t{0};
+
+   private:
+    static constexpr std::uint64_t kWriterBit = 1;
+    static constexpr std::uint64_t kReaderUnit = 2;
+    static constexpr unsigned kVersionShift = 32;
+    static constexpr std::uint64_t kReaderMask = ((std::uint64_t{1} << kVersionShift) - 1) & ~kWriterBit;
+    static constexpr std::uint64_t kVersionUnit = std::uint64_t{1} << kVersionShift;
+
+    /// 自旋超过该次数后改为让出时间片
+    static constexpr std::uint32_t kSpinLimit = 64;
+
+    /// 置位写标志；随后的释放栅栏保证乐观读者看到本次写入的数据时必然也看到写标志
+    [[nodiscard]] bool try_acquire_writer_bit() noexcept {
+        if (state_.fetch_or(kWriterBit, std::memory_order_acquire) & kWriterBit) {
+            return false;
+        }
+        std::atomic_thread_fence(std::memory_order_release);
+        return true;
+    }
+
+    static void backoff(std::uint32_t& spins) noexcept {
+        if (spins < kSpinLimit) {
+            ++spins;
+            spin_pause();
+        } else {
+            std::this_thread::yield();
+        }
+    }
+
+    std::atomic<std::uint64_t> state_{0};
+};
+
+static_assert(sizeof(RwSpinLock) == 8, "RwSpinLock must stay 8 bytes");
+
+/**
+ * @brief 支持乐观读（read_begin / read_validate）的锁
+ */
+template <typename Lock>
+concept OptimisticReadLock = requires(const Lock& lock, std::uint64_t version) {
+    { lock.read_begin() } -> std::same_as<std::uint64_t>;
+    { lock.read_validate(version) } -> std::same_as<bool>;
+};
+
+}  // namespace Corona::Kernel::Utils
@@ -0,0 +1,221 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+#include "corona/kernel/memory/epoch_manager.h"
+#include "storage.h"
+
+namespace Corona::Kernel::Utils {
+
+/**
+ * @brief 快照读（RCU）模式的对象池
+ *
+ * 每个对象以不可变版本的形式存放：写者构造新副本并发布，读者拿到指向某一版本的指针，
+ * 旧版本通过 Memory::EpochManager 延迟回收。
+ *
+ * @tparam T 存储的元素类型，需可复制构造（update() 基于当前版本的副本修改）
+ * @tparam BufferCapacity 每个底层 StaticBuffer 的容量，必须是 2 的幂次且 >= 2
+ * @tparam InitialBuffers 初始 buffer 数量，必须 >= 1
+ *
+ * @note 实现：底层是 Storage<const T*, ..., RwSpinLock>，槽位只存版本指针
+ * - 读：进入纪元临界区后以 Storage::try_read() 乐观读取指针（只读锁字、不写共享缓存行），
+ *   返回的 Snapshot 持有纪元守卫，存活期间指向的版本不会被删除；读者数增加时读侧没有额外争用
+ * - 写：在锁外构造新版本，只在交换指针的瞬间持有槽位独占锁，随后 retire 旧版本
+ * - update() 为乐观并发：若交换前发现版本已被其他写者替换，则基于新版本重做修改
+ *
+ * @note 适用于读多写少、被所有系统线程频繁读取的配置与状态对象；每次写入都会复制整个对象
+ * @note Snapshot 应短暂持有：存活的 Snapshot 会阻止纪元推进，所有线程的旧版本随之积压
+ * @note Snapshot 不能跨线程传递，必须在创建它的线程上析构
+ * @note 析构时不得有存活的 Snapshot 或并发访问
+ *
+ * @note 使用示例：
+ * @code
+ * SnapshotStorage<RenderSettings> settings;
+ * auto id = settings.allocate();
+ *
+ * // 任意线程，无锁读取
+ * if (auto snapshot = settings.read(id)) {
+ *     use(snapshot->resolution);
+ * }
+ *
+ * // 写者发布新版本
+ * settings.update(id, [](RenderSettings& s) { s.vsync = false; });
+ * @endcode
+ */
+template <typename T, std::size_t BufferCapacity = 128, std::size_t InitialBuffers = 2>
+class SnapshotStorage {
+    using Slots = Storage<const T*, BufferCapacity, InitialBuffers, RwSpinLock>;
+
+   public:
+    using ObjectId = typename Slots::ObjectId;
+
+    /**
+     * @brief 对象某一版本的只读快照 (RAII)
+     *
+     * @note 持有纪元守卫，存活期间指针始终有效且内容不变
+     * @note 必须在调用 read() 的线程上析构：可以在该线程内移动，但不能移交给其他线程
+     */
+    class Snapshot final {
+       public:
+        Snapshot() = default;
+        Snapshot(Kernal::Memory::EpochManager::Guard&& guard, const T* ptr) : guard_(std::move(guard)), ptr_(ptr) {}
+
+        Snapshot(Snapshot&&) = default;
+        Snapshot& operator=(Snapshot&&) = default;
+        Snapshot(const Snapshot&) = delete;
+        Snapshot& operator=(const Snapshot&) = delete;
+
+        [[nodiscard]] bool valid() const { return ptr_ != nullptr; }
+        explicit operator bool() const { return valid(); }
+
+        const T* get() const { return ptr_; }
+        const T* operator->() const { return ptr_; }
+        const T& operator*() const { return *ptr_; }
+
+       private:
+        Kernal::Memory::EpochManager::Guard guard_;
+        const T* ptr_ = nullptr;
+    };
+
+    /**
+     * @brief 构造函数
+     *
+     * @param tag 槽位内存计入的 MemoryTracker 标签
+     */
+    explicit SnapshotStorage(Kernal::Memory::MemoryTag tag = Kernal::Memory::MemoryTag::Storage) : slots_(tag) {}
+
+    SnapshotStorage(const SnapshotStorage&) = delete;
+    SnapshotStorage& operator=(const SnapshotStorage&) = delete;
+    SnapshotStorage(SnapshotStorage&&) = delete;
+    SnapshotStorage& operator=(SnapshotStorage&&) = delete;
+
+    /**
+     * @brief 析构函数，直接删除所有当前版本（已 retire 的旧版本由 EpochManager 回收）
+     */
+    ~SnapshotStorage() {
+        slots_.for_each_write([](const T*& ptr) {
+            delete ptr;
+            ptr = nullptr;
+        });
+    }
+
+    /**
+     * @brief 分配一个对象并发布其初始版本
+     *
+     * @param args 初始版本的构造参数
+     * @return 对象 ID
+     */
+    template <typename... Args>
+    [[nodiscard]] ObjectId allocate(Args&&... args) {
+        auto initial = std::make_unique<const T>(std::forward<Args>(args)...);
+        const ObjectId id = slots_.allocate();
+        *slots_.acquire_write(id) = initial.release();
+        return id;
+    }
+
+    /**
+     * @brief 释放对象，当前版本在所有读者离开后回收
+     *
+     * @throws std::runtime_error 若 ID 无效或重复释放
+     */
+    void deallocate(ObjectId id) {
+        const T* old = nullptr;
+        {
+            auto writer = slots_.try_acquire_write(id);
+            if (!writer) {
+                CFW_LOG_FLUSH();
+                throw std::runtime_error("Attempt to deallocate unoccupied snapshot object ID: " + std::to_string(id));
+            }
+            old = std::exchange(*writer, nullptr);
+        }
+        slots_.deallocate(id);
+        Kernal::Memory::EpochManager::instance().retire(old);
+    }
+
+    /**
+     * @brief 检查指定 ID 是否存在
+     */
+    [[nodiscard]] bool contains(ObjectId id) const { return slots_.contains(id); }
+
+    /**
+     * @brief 获取当前对象数量
+     */
+    [[nodiscard]] std::size_t count() const { return slots_.count(); }
+
+    /**
+     * @brief 获取对象当前版本的快照（无锁）
+     *
+     * @return Snapshot，若 ID 无效或未占用则 valid() 为 false
+     */
+    [[nodiscard]] Snapshot read(ObjectId id) {
+        auto guard = Kernal::Memory::EpochManager::instance().pin();
+        const T* ptr = nullptr;
+        if (!slots_.try_read(id, ptr) || !ptr) {
+            return Snapshot();
+        }
+        return Snapshot(std::move(guard), ptr);
+    }
+
+    /**
+     * @brief 发布新版本（整体替换）
+     *
+     * @param value 新版本
+     * @return 若 ID 有效且已占用则返回 true
+     */
+    bool publish(ObjectId id, T value) {
+        auto next = std::make_unique<const T>(std::move(value));
+        const T* old = nullptr;
+        {
+            auto writer = slots_.try_acquire_write(id);
+            if (!writer || !*writer) {
+                return false;
+            }
+            old = std::exchange(*writer, next.release());
+        }
+        Kernal::Memory::EpochManager::instance().retire(old);
+        return true;
+    }
+
+    /**
+     * @brief 基于当前版本修改并发布新版本
+     *
+     * @param func 回调 void(T&)，作用于当前版本的副本；可能因并发写入而被调用多次，不应有其他副作用
+     * @return 若 ID 有效且已占用则返回 true
+     *
+     * @note 复制与修改在锁外进行，只有指针交换持有槽位独占锁
+     */
+    template <typename Func>
+    bool update(ObjectId id, Func&& func) {
+        while (true) {
+            // 快照在交换完成前保持存活：基础版本不会被回收，其地址也就不会被新版本复用
+            Snapshot current = read(id);
+            if (!current) {
+                return false;
+            }
+            auto next = std::make_unique<T>(*current);
+            func(*next);
+
+            const T* old = nullptr;
+            {
+                auto writer = slots_.try_acquire_write(id);
+                if (!writer || !*writer) {
+                    return false;
+                }
+                if (*writer != current.get()) {
+                    continue;  // 期间已有其他写者发布新版本，基于新版本重做
+                }
+                old = std::exchange(*writer, next.release());
+            }
+            Kernal::Memory::EpochManager::instance().retire(old);
+            return true;
+        }
+    }
+
+   private:
+    Slots slots_;
+};
+
+}  // namespace Corona::Kernel::Utils
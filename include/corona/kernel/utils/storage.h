@@ -1,19 +1,35 @@
 #pragma once
 
+#include <algorithm>
 #include <array>
 #include <atomic>
+#include <bit>
 #include <cstddef>
 #include <cstdint>
-#include <list>
+#include <cstring>
+#include <memory>
 #include <mutex>
+#include <new>
 #include <queue>
 #include <shared_mutex>
+#include <span>
+#include <string>
 #include <stdexcept>
+#include <thread>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
 #include "corona/kernel/core/i_logger.h"
+#include "corona/kernel/memory/cache_aligned_allocator.h"
+#include "corona/kernel/memory/lock_free_stack.h"
+#include "corona/kernel/memory/memory_tracker.h"
+#include "corona/kernel/memory/virtual_memory.h"
 #include "corona/pal/cfw_platform.h"
+#include "rw_spin_lock.h"
 #include "stack_trace.h"
 
 // 超时锁配置（用于死锁检测）
@@ -36,6 +52,20 @@
 #define CFW_ENABLE_LOCK_LOGGING 0  // 默认关闭，设为 1 则启用锁日志记录
 #endif
 
+// 乐观读开关：ThreadSanitizer 无法理解顺序锁的读-校验协议，检测到时退化为共享锁读取
+#ifndef CFW_ENABLE_OPTIMISTIC_READS
+#if defined(__SANITIZE_THREAD__)
+#define CFW_ENABLE_OPTIMISTIC_READS 0
+#elif defined(__has_feature)
+#if __has_feature(thread_sanitizer)
+#define CFW_ENABLE_OPTIMISTIC_READS 0
+#endif
+#endif
+#endif
+#ifndef CFW_ENABLE_OPTIMISTIC_READS
+#define CFW_ENABLE_OPTIMISTIC_READS 1
+#endif
+
 namespace Corona::Kernel::Utils {
 
 /**
@@ -46,20 +76,86 @@ namespace Corona::Kernel::Utils {
  *
  * @tparam T 存储的元素类型
  * @tparam Capacity 缓冲区容量，必须是 2 的幂次且 >= 2
+ * @tparam SlotLock 槽位锁类型，需满足 SharedTimedLockable（默认 std::shared_timed_mutex）
  *
  * @note 此结构体仅作为 Storage 的内部数据容器使用，不提供分配/释放等高级操作
- * @note 包含三个核心成员：buffer（数据数组）、occupied（占用标志）、mutexes（槽位锁）
+ * @note 核心成员：槽位区（槽位锁数组 + 对象数组）、占用位图、block_lock（块锁）
+ * @note 占用位图每 64 个槽位一个字，遍历时以 count-trailing-zeros 直接跳到下一个已占用槽位
+ *
+ * @note 按需提交：
+ * - 槽位区在构造时不分配内存，空 buffer 只占用本结构体自身
+ * - 槽位区较大（对象数组不少于 kVirtualCommitPages 页）时保留虚拟地址空间，随高水位线增长逐页提交，
+ *   槽位锁在所在页提交时构造；较小时在首次分配时从堆上一次性分配
+ * - 槽位从未使用过的部分（高水位线以上）不需要空闲索引，只有释放过的槽位记录在 recycled 中
+ * - 对象在分配时原地构造、释放时析构，不会为整个数组默认构造
+ *
+ * @note 外部镜像（Storage 持久化模式）：占用位图与对象数组位于调用者提供的映像中（如文件映射），
+ *       布局为 [占用位图][对齐填充][对象数组]，共 kImageBytes 字节；槽位区只包含槽位锁，
+ *       析构时不销毁对象（对象随映像保留），并解除映像的映射
  */
-template <typename T, std::size_t Capacity>
+template <typename T, std::size_t Capacity, typename SlotLock = std::shared_timed_mutex>
 struct StaticBuffer {
     static_assert(Capacity >= 2, "Capacity must be at least 2");
     static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+    static_assert(Capacity <= (std::size_t{1} << 31), "Capacity must fit in 32-bit slot indices");
+
+    /// 占用位图的字数
+    static constexpr std::size_t kOccupancyWords = (Capacity + 63) / 64;
+
+    /// 对象数组至少跨越多少页时改用保留 + 逐页提交
+    static constexpr std::size_t kVirtualCommitPages = 4;
+
+    /// 外部映像中对象数组的偏移
+    static constexpr std::size_t kImageValuesOffset =
+        (kOccupancyWords * sizeof(std::uint64_t) + alignof(T) - 1) / alignof(T) * alignof(T);
+
+    /// 外部映像的大小（占用位图 + 对象数组）
+    static constexpr std::size_t kImageBytes = kImageValuesOffset + Capacity * sizeof(T);
+
+    /// 非满 buffer 链表节点（由 Storage 维护）
+    struct FreeListNode : Kernal::Memory::LockFreeNode {
+        StaticBuffer* owner = nullptr;
+        std::size_t index = 0;  ///< buffer 在所属 Storage 中的索引
+    };
 
     StaticBuffer() {
-        free_indices.reserve(Capacity);
-        for (std::size_t i = 0; i < Capacity; ++i) {
-            occupied[i].store(false, std::memory_order_relaxed);
-            free_indices.push_back(i);
+        free_list_node.owner = this;
+
+        const std::size_t page = Kernal::Memory::system_page_size();
+        virtual_backed = Kernal::Memory::virtual_memory_supported() && sizeof(T) * Capacity >= kVirtualCommitPages * page;
+        if (virtual_backed) {
+            // 锁数组与对象数组各自按页对齐，分别随高水位线提交
+            values_offset = Kernal::Memory::align_up(sizeof(SlotLock) * Capacity, page);
+            region_bytes = values_offset + Kernal::Memory::align_up(sizeof(T) * Capacity, page);
+            reserve_region();
+            values = region + values_offset;
+        } else {
+            values_offset = Kernal::Memory::align_up(sizeof(SlotLock) * Capacity, alignof(T));
+            region_bytes = values_offset + sizeof(T) * Capacity;
+        }
+    }
+
+    /**
+     * @brief 以外部映像构造（占用位图与对象数组位于 image 中）
+     *
+     * @param image 映像起始地址（至少 kImageBytes 字节，按 alignof(T) 对齐）
+     * @param mapped_bytes 非 0 时析构时以 unmap_file 解除 image 的映射
+     */
+    StaticBuffer(std::byte* image, std::size_t mapped_bytes) : image_mapping(image), image_mapping_bytes(mapped_bytes) {
+        free_list_node.owner = this;
+        occupancy = reinterpret_cast<std::uint64_t*>(image);
+        values = image + kImageValuesOffset;
+        external = true;
+
+        // 槽位区只包含槽位锁
+        const std::size_t page = Kernal::Memory::system_page_size();
+        virtual_backed =
+            Kernal::Memory::virtual_memory_supported() && sizeof(SlotLock) * Capacity >= kVirtualCommitPages * page;
+        region_bytes = virtual_backed ? Kernal::Memory::align_up(sizeof(SlotLock) * Capacity, page)
+                                      : sizeof(SlotLock) * Capacity;
+        values_offset = region_bytes;
+        if (virtual_backed) {
+            reserve_region();
         }
     }
 
@@ -68,16 +164,168 @@ struct StaticBuffer {
     StaticBuffer(StaticBuffer&&) = delete;
     StaticBuffer& operator=(StaticBuffer&&) = delete;
 
-    ~StaticBuffer() = default;
+    ~StaticBuffer() {
+        if (region) {
+            if (!external) {
+                for (std::size_t i = next_occupied(0); i < Capacity; i = next_occupied(i + 1)) {
+                    std::destroy_at(&value(i));
+                }
+            }
+            for (std::size_t i = 0; i < committed_slots.load(std::memory_order_relaxed); ++i) {
+                std::destroy_at(&slot_lock(i));
+            }
+            if (virtual_backed) {
+                Kernal::Memory::release_pages(region, region_bytes);
+            } else {
+                ::operator delete(region, std::align_val_t{kRegionAlignment});
+            }
+        }
+        if (image_mapping_bytes > 0) {
+            Kernal::Memory::unmap_file(image_mapping, image_mapping_bytes);
+        }
+    }
+
+    /// 槽位是否被占用
+    [[nodiscard]] bool is_occupied(std::size_t index) const noexcept {
+        return (occupancy_word(index / 64).load(std::memory_order_acquire) >> (index % 64)) & 1;
+    }
+
+    /// 标记槽位为已占用（需持有该槽位的独占锁）
+    void set_occupied(std::size_t index) noexcept {
+        occupancy_word(index / 64).fetch_or(std::uint64_t{1} << (index % 64), std::memory_order_release);
+    }
+
+    /// 标记槽位为空闲（需持有该槽位的独占锁）
+    void clear_occupied(std::size_t index) noexcept {
+        occupancy_word(index / 64).fetch_and(~(std::uint64_t{1} << (index % 64)), std::memory_order_release);
+    }
+
+    /// 查找 first 及之后的第一个已占用槽位，没有则返回 Capacity
+    [[nodiscard]] std::size_t next_occupied(std::size_t first) const noexcept {
+        for (std::size_t word = first / 64; word < kOccupancyWords; ++word) {
+            std::uint64_t bits = occupancy_word(word).load(std::memory_order_acquire);
+            if (word == first / 64) {
+                bits &= ~std::uint64_t{0} << (first % 64);
+            }
+            if (bits != 0) {
+                return word * 64 + static_cast<std::size_t>(std::countr_zero(bits));
+            }
+        }
+        return Capacity;
+    }
+
+    /// 占用位图的第 word 个字（原子访问）
+    [[nodiscard]] std::atomic_ref<std::uint64_t> occupancy_word(std::size_t word) const noexcept {
+        return std::atomic_ref<std::uint64_t>(occupancy[word]);
+    }
+
+    /// 外部映像起始地址（自有模式返回 nullptr）
+    [[nodiscard]] std::byte* image() const noexcept { return image_mapping; }
+
+    /// 槽位的锁与存储是否已提交（未提交的槽位从未被分配过，不可访问）
+    [[nodiscard]] bool is_committed(std::size_t index) const noexcept {
+        return index < committed_slots.load(std::memory_order_acquire);
+    }
+
+    /// 槽位锁（槽位必须已提交）
+    [[nodiscard]] SlotLock& slot_lock(std::size_t index) const noexcept { return *std::launder(lock_storage(index)); }
+
+    /// 槽位中的对象（槽位必须已被占用）
+    [[nodiscard]] T& value(std::size_t index) const noexcept { return *std::launder(slot_storage(index)); }
+
+    /// 槽位的原始存储（用于原地构造）
+    [[nodiscard]] T* slot_storage(std::size_t index) const noexcept {
+        return reinterpret_cast<T*>(values + index * sizeof(T));
+    }
+
+    /// 可分配的槽位数：回收的槽位 + 高水位线以上从未使用的槽位（需持有 alloc_mutex）
+    [[nodiscard]] std::size_t free_count() const noexcept { return recycled.size() + (Capacity - high_water); }
 
-    std::array<T, Capacity> buffer{};                                 ///< 数据存储数组
-    std::array<std::atomic<bool>, Capacity> occupied{};               ///< 槽位占用标志，原子操作确保可见性
-    mutable std::array<std::shared_timed_mutex, Capacity> mutexes{};  ///< 每个槽位的独立共享锁（支持超时）
+    /**
+     * @brief 确保前 slots 个槽位已提交（需持有 alloc_mutex）
+     *
+     * @return 新提交的字节数；提交失败返回 0 且不改变状态（调用者以 is_committed 判断）
+     */
+    std::size_t commit(std::size_t slots) {
+        const std::size_t committed = committed_slots.load(std::memory_order_relaxed);
+        if (slots <= committed) {
+            return 0;
+        }
+
+        std::size_t bytes = 0;
+        std::size_t new_committed = Capacity;
+        if (!virtual_backed) {
+            region = static_cast<std::byte*>(::operator new(region_bytes, std::align_val_t{kRegionAlignment}));
+            if (!external) {
+                values = region + values_offset;
+            }
+            bytes = region_bytes;
+        } else {
+            // 外部映像模式下 values_offset == region_bytes，对象数组部分为空
+            const std::size_t page = Kernal::Memory::system_page_size();
+            const std::size_t lock_end =
+                std::min(Kernal::Memory::align_up(slots * sizeof(SlotLock), page), values_offset);
+            const std::size_t value_end =
+                std::min(Kernal::Memory::align_up(slots * sizeof(T), page), region_bytes - values_offset);
+            if (!Kernal::Memory::commit_pages(region + committed_lock_bytes, lock_end - committed_lock_bytes) ||
+                !Kernal::Memory::commit_pages(region + values_offset + committed_value_bytes,
+                                              value_end - committed_value_bytes)) {
+                return 0;
+            }
+            bytes = (lock_end - committed_lock_bytes) + (value_end - committed_value_bytes);
+            committed_lock_bytes = lock_end;
+            committed_value_bytes = value_end;
+            new_committed = std::min({Capacity, lock_end / sizeof(SlotLock), external ? Capacity : value_end / sizeof(T)});
+        }
 
-    std::vector<std::size_t> free_indices;
+        std::uninitialized_default_construct(lock_storage(committed), lock_storage(new_committed));
+        committed_bytes += bytes;
+        committed_slots.store(new_committed, std::memory_order_release);
+        return bytes;
+    }
+
+    mutable RwSpinLock block_lock;  ///< 块锁：槽位访问持共享锁，整块遍历持独占锁
+
+    FreeListNode free_list_node;  ///< 非满 buffer 链表节点
     std::mutex alloc_mutex;
+    std::vector<std::uint32_t> recycled;  ///< 释放过的槽位索引（受 alloc_mutex 保护）
+    std::size_t high_water = 0;           ///< 从未使用过的槽位起点（受 alloc_mutex 保护）
     std::atomic<std::size_t> active_count{0};
-    std::atomic<bool> is_full{false};
+    bool in_free_list = false;  ///< 是否位于非满 buffer 链表中（受 alloc_mutex 保护）
+
+    std::atomic<std::size_t> committed_slots{0};  ///< 已提交（锁已构造）的槽位数
+    std::size_t committed_bytes = 0;              ///< 已提交的字节数（受 alloc_mutex 保护）
+
+   private:
+    static constexpr std::size_t kRegionAlignment = std::max({alignof(T), alignof(SlotLock), alignof(std::max_align_t)});
+
+    [[nodiscard]] SlotLock* lock_storage(std::size_t index) const noexcept {
+        return reinterpret_cast<SlotLock*>(region) + index;
+    }
+
+    void reserve_region() {
+        region = static_cast<std::byte*>(
+            Kernal::Memory::reserve_pages(region_bytes, Kernal::Memory::PageBackend::VirtualMemory));
+        if (!region) {
+            throw std::bad_alloc();
+        }
+    }
+
+    /// 槽位占用位图（每 64 个槽位一个字，以 atomic_ref 原子访问），指向 inline_occupancy 或外部映像
+    alignas(std::atomic_ref<std::uint64_t>::required_alignment) std::uint64_t inline_occupancy[kOccupancyWords]{};
+    std::uint64_t* occupancy = inline_occupancy;
+
+    std::byte* values = nullptr;  ///< 对象数组（自有模式位于槽位区内，外部映像模式位于映像内）
+    std::byte* image_mapping = nullptr;  ///< 外部映像起始地址
+    std::size_t image_mapping_bytes = 0;
+    bool external = false;
+
+    std::byte* region = nullptr;  ///< 槽位区：[槽位锁数组][对齐填充][对象数组]（外部映像模式只有槽位锁数组）
+    std::size_t region_bytes = 0;
+    std::size_t values_offset = 0;  ///< 对象数组在槽位区中的偏移
+    std::size_t committed_lock_bytes = 0;
+    std::size_t committed_value_bytes = 0;
+    bool virtual_backed = false;
 };
 
 /**
@@ -89,16 +337,37 @@ struct StaticBuffer {
  * @tparam T 存储的元素类型
  * @tparam BufferCapacity 每个底层 StaticBuffer 的容量，必须是 2 的幂次且 >= 2
  * @tparam InitialBuffers 初始 buffer 数量，必须 >= 1
+ * @tparam SlotLock 槽位锁策略，需满足 SharedTimedLockable：
+ *         - std::shared_timed_mutex（默认）：通用，适合持锁时间较长或对象较大的场景
+ *         - RwSpinLock：8 字节读写自旋锁，显著减小每个槽位的内存占用，并支持 try_read() 乐观读
  *
  * @note 句柄类型：
- * - ObjectId 是 std::uintptr_t 类型，存储槽位的实际内存地址
- * - 通过 get_parent_buffer() 根据地址范围反查所属的 StaticBuffer
+ * - ObjectId 是 std::uintptr_t 类型，编码为 ((buffer 索引 + 1) << log2(BufferCapacity)) | 槽位索引，0 为无效值
+ * - 通过 get_parent_buffer() 以一次移位和无锁的 buffer 目录查找定位所属的 StaticBuffer（O(1)，不加锁）
+ * - buffer 目录分段存放（第 k 段容纳 2^k 个 buffer），段只增不减，扩容时无需复制或使旧段失效
+ *
+ * @note 非满 buffer 链表：有空闲槽位的 buffer 挂在一个无锁栈（Memory::LockFreeStack）上，
+ *       分配时直接取栈顶 buffer，无需逐个检查所有 buffer；已满的 buffer 在被分配者遇到时才出栈（惰性移除），
+ *       释放使已满 buffer 重新出现空闲槽位时再入栈。出栈只在持有 list_mutex_ 时进行，缩容（独占锁）期间没有并发出栈，
+ *       因此节点所在的 buffer 在被读取期间不会被释放
+ *
+ * @note 按需提交：StaticBuffer 的槽位区随高水位线逐页提交（或在首次分配时整体分配），
+ *       对象在 allocate 时原地构造、deallocate 时析构，空闲的 Storage 只占用 StaticBuffer 自身
+ *
+ * @note 内存追踪：每个 StaticBuffer 自身的大小及其槽位区已提交的字节数计入构造时指定的 MemoryTracker 标签
+ *
+ * @note 调试层：CFW_ENABLE_LOCK_TIMEOUT 打开时，所有阻塞加锁改为超时加锁，超时后记录调用栈并抛出异常，
+ *       对两种锁策略同样有效
  *
  * @note 线程安全性：
- * - allocate：多线程安全，扩容时使用独占锁保护 buffer 列表
- * - deallocate：多线程安全，使用独占锁标记槽位空闲后回收句柄
+ * - allocate/allocate_n：多线程安全，从无锁的非满 buffer 链表取 buffer，扩容时使用独占锁保护 buffer 列表
+ * - deallocate/deallocate_n：多线程安全，使用独占锁标记槽位空闲后回收句柄
  * - acquire_read/acquire_write：多线程安全，分别使用共享锁/独占锁访问槽位
  * - 迭代器：多线程安全，采用 try_lock 避免死锁，锁定失败的槽位会加入跳过队列稍后重试
+ * - for_each_read/for_each_write 及其并行版本：按 buffer 加块锁（独占）后以占用位图遍历，不逐槽加锁
+ *
+ * @note 锁层次：list_mutex_（buffer 列表）-> block_lock（buffer 块锁）-> slot_lock（槽位锁）。
+ *       所有槽位访问先持块共享锁再加槽位锁，整块遍历只需独占块锁即可排除所有槽位访问者
  *
  * @note 使用示例：
  * @code
@@ -124,14 +393,17 @@ struct StaticBuffer {
  * entities.deallocate(id);
  * @endcode
  */
-template <typename T, std::size_t BufferCapacity = 128, std::size_t InitialBuffers = 2>
+template <typename T, std::size_t BufferCapacity = 128, std::size_t InitialBuffers = 2,
+          typename SlotLock = std::shared_timed_mutex>
 class Storage {
     static_assert(InitialBuffers >= 1, "InitialBuffers must be at least 1");
     static_assert(BufferCapacity >= 2, "BufferCapacity must be at least 2");
     static_assert((BufferCapacity & (BufferCapacity - 1)) == 0, "BufferCapacity must be a power of two");
 
+    using Buffer = StaticBuffer<T, BufferCapacity, SlotLock>;
+
    public:
-    using ObjectId = std::uintptr_t;  ///< 对象 ID 类型，存储槽位的实际内存地址
+    using ObjectId = std::uintptr_t;  ///< 对象 ID 类型，编码 buffer 索引与槽位索引
 
     /**
      * @brief 只读访问句柄 (RAII)
@@ -139,8 +411,8 @@ class Storage {
     class ReadHandle final {
        public:
         ReadHandle() = default;
-        ReadHandle(const T* ptr, std::shared_lock<std::shared_timed_mutex>&& lock)
-            : ptr_(ptr), lock_(std::move(lock)) {
+        ReadHandle(const T* ptr, ObjectId id, std::shared_lock<RwSpinLock>&& block_lock, std::shared_lock<SlotLock>&& lock)
+            : ptr_(ptr), id_(id), block_lock_(std::move(block_lock)), lock_(std::move(lock)) {
 #if CFW_ENABLE_LOCK_LOGGING
             CFW_LOG_TRACE("ReadHandle acquire lock for ptr addr: {}", reinterpret_cast<std::uintptr_t>(ptr_));
 #endif
@@ -164,9 +436,14 @@ class Storage {
         const T* operator->() const { return ptr_; }
         const T& operator*() const { return *ptr_; }
 
+        /// 获取对象 ID
+        [[nodiscard]] ObjectId id() const { return id_; }
+
        private:
         const T* ptr_ = nullptr;
-        std::shared_lock<std::shared_timed_mutex> lock_;
+        ObjectId id_ = 0;
+        std::shared_lock<RwSpinLock> block_lock_;  ///< 块共享锁（在槽位锁之后释放）
+        std::shared_lock<SlotLock> lock_;
     };
 
     /**
@@ -175,8 +452,8 @@ class Storage {
     class WriteHandle final {
        public:
         WriteHandle() = default;
-        WriteHandle(T* ptr, std::unique_lock<std::shared_timed_mutex>&& lock)
-            : ptr_(ptr), lock_(std::move(lock)) {
+        WriteHandle(T* ptr, ObjectId id, std::shared_lock<RwSpinLock>&& block_lock, std::unique_lock<SlotLock>&& lock)
+            : ptr_(ptr), id_(id), block_lock_(std::move(block_lock)), lock_(std::move(lock)) {
 #if CFW_ENABLE_LOCK_LOGGING
             CFW_LOG_TRACE("WriteHandle acquire lock for ptr addr: {}", reinterpret_cast<std::uintptr_t>(ptr_));
 #endif
@@ -200,22 +477,74 @@ class Storage {
         T* operator->() const { return ptr_; }
         T& operator*() const { return *ptr_; }
 
+        /// 获取对象 ID
+        [[nodiscard]] ObjectId id() const { return id_; }
+
        private:
         T* ptr_ = nullptr;
-        std::unique_lock<std::shared_timed_mutex> lock_;
+        ObjectId id_ = 0;
+        std::shared_lock<RwSpinLock> block_lock_;  ///< 块共享锁（在槽位锁之后释放）
+        std::unique_lock<SlotLock> lock_;
     };
 
    public:
     /**
-     * @brief 构造函数，创建初始 buffer 并预分配所有槽位 ID
+     * @brief 构造函数，创建初始 buffer
      *
-     * @note 创建 InitialBuffers 个 StaticBuffer，每个包含 BufferCapacity 个槽位
-     * @note 将所有槽位的地址作为 ID 加入空闲队列
+     * @param tag buffer 内存计入的 MemoryTracker 标签
+     *
+     * @note 创建 InitialBuffers 个 StaticBuffer，每个包含 BufferCapacity 个槽位；槽位区在首次分配时才提交
      */
-    Storage() {
+    explicit Storage(Kernal::Memory::MemoryTag tag = Kernal::Memory::MemoryTag::Storage) : tag_(tag) {
         for (std::size_t i = 0; i < InitialBuffers; ++i) {
-            buffers_.emplace_back();
+            append_buffer_locked();
+        }
+        // 逆序入栈，优先从第一个 buffer 分配
+        for (std::size_t i = InitialBuffers; i-- > 0;) {
+            list_if_needed_locked(*buffers_[i]);
+        }
+        Kernal::Memory::track_allocation(tag_, InitialBuffers * kBufferHeaderBytes);
+    }
+
+    /**
+     * @brief 持久化构造函数：buffer 的对象数组与占用位图存放在内存映射文件中
+     *
+     * @param path 映射文件路径；不存在时创建，存在时校验后恢复其中的所有对象
+     * @param tag buffer 内存计入的 MemoryTracker 标签（文件映射本身不计入）
+     *
+     * @note 文件布局：[文件头（一个映射粒度）][buffer 0 映像][buffer 1 映像]...，
+     *       文件头记录格式版本、sizeof(T)、alignof(T)、BufferCapacity 与 buffer 数量，
+     *       每个 buffer 映像为 [占用位图][对象数组]，按映射粒度对齐、单独映射
+     * @note 重新打开时只需映射文件并扫描占用位图重建空闲索引，不复制对象；
+     *       ObjectId 在重启前后保持不变，可直接持久化在其他数据中
+     * @note T 必须可平凡复制，且不应包含指针等进程相关的数据
+     * @note 写入经由页缓存回写到文件：进程崩溃不丢失数据，系统崩溃前需要 flush() 才能保证落盘
+     * @note 同一文件同时只能被一个 Storage 打开（文件在打开期间被独占锁定）
+     *
+     * @throws std::runtime_error 若文件无法打开或映射、不是有效的 Storage 映像，或布局与当前类型不匹配
+     */
+    explicit Storage(const std::string& path, Kernal::Memory::MemoryTag tag = Kernal::Memory::MemoryTag::Storage)
+        requires std::is_trivially_copyable_v<T>
+        : tag_(tag) {
+        try {
+            open_file(path);
+            const std::size_t count =
+                std::max(static_cast<std::size_t>(file_header_->buffer_count), InitialBuffers);
+            for (std::size_t i = 0; i < count; ++i) {
+                append_buffer_locked();
+                restore_buffer_locked(*buffers_.back());
+            }
+            buffer_count_.store(count, std::memory_order_relaxed);
+            for (std::size_t i = count; i-- > 0;) {
+                if (buffers_[i]->free_count() > 0) {
+                    list_if_needed_locked(*buffers_[i]);
+                }
+            }
+        } catch (...) {
+            release_buffers();
+            throw;
         }
+        Kernal::Memory::track_allocation(tag_, buffers_.size() * kBufferHeaderBytes);
     }
 
     Storage(const Storage&) = delete;
@@ -223,7 +552,46 @@ class Storage {
     Storage(Storage&&) = delete;
     Storage& operator=(Storage&&) = delete;
 
-    ~Storage() = default;
+    ~Storage() {
+        Kernal::Memory::track_deallocation(tag_, buffers_.size() * kBufferHeaderBytes +
+                                                     committed_bytes_.load(std::memory_order_relaxed));
+        release_buffers();
+    }
+
+    /**
+     * @brief 是否为文件映射的持久化 Storage
+     */
+    CFW_FORCE_INLINE
+    bool is_persistent() const {
+        return file_ != Kernal::Memory::kInvalidFileHandle;
+    }
+
+    /**
+     * @brief 将持久化 Storage 的修改同步写回文件（阻塞直到落盘）
+     *
+     * @return 全部写回成功返回 true；非持久化 Storage 返回 false
+     *
+     * @note 与并发写入同时进行时，写回的是某一时刻各页的内容，不保证跨对象的一致性
+     */
+    bool flush() {
+        if (!is_persistent()) {
+            return false;
+        }
+        std::shared_lock lock(list_mutex_);
+        bool ok = Kernal::Memory::flush_mapped_file(file_header_, file_header_bytes_);
+        for (std::size_t i = 0; i < buffers_.size(); ++i) {
+            ok &= Kernal::Memory::flush_mapped_file(buffers_[i]->image(), file_segment_bytes_);
+        }
+        return ok;
+    }
+
+    /**
+     * @brief 获取 buffer 内存计入的 MemoryTracker 标签
+     */
+    CFW_FORCE_INLINE
+    Kernal::Memory::MemoryTag memory_tag() const {
+        return tag_;
+    }
 
     /**
      * @brief 获取对象池的总容量
@@ -237,6 +605,18 @@ class Storage {
         return buffer_count_.load(std::memory_order_relaxed) * BufferCapacity;
     }
 
+    /**
+     * @brief 获取所有 buffer 已提交的槽位区字节数
+     *
+     * @return 槽位锁与对象存储实际提交的内存（不含 StaticBuffer 自身），空闲的 Storage 为 0
+     *
+     * @note 槽位区随分配按页提交，缩容回收 buffer 时归还；返回值为瞬时快照
+     */
+    CFW_FORCE_INLINE
+    std::size_t committed_bytes() const {
+        return committed_bytes_.load(std::memory_order_relaxed);
+    }
+
     /**
      * @brief 获取当前已占用的槽位数量
      *
@@ -270,25 +650,24 @@ class Storage {
      * @note 检查流程：
      *       1. 通过 get_parent_buffer() 查找槽位所属的 StaticBuffer
      *       2. 若找不到对应的 buffer，返回 false
-     *       3. 计算槽位在 buffer 内的索引，检查 occupied 原子标志
+     *       3. 从 ID 低位取出槽位索引，检查 occupied 原子标志
      *
      * @note 线程安全，使用原子操作检查槽位占用状态
      * @note 返回值为瞬时快照，多线程环境下可能在返回后立即变化
      */
     CFW_FORCE_INLINE
     bool contains(ObjectId id) const {
-        auto [_, parent_buffer] = const_cast<Storage*>(this)->get_parent_buffer(id);
+        auto [_, parent_buffer] = get_parent_buffer(id);
         if (!parent_buffer) {
             return false;
         }
-        std::size_t index = (id - reinterpret_cast<ObjectId>(&(parent_buffer->buffer[0]))) / sizeof(T);
-        return parent_buffer->occupied[index].load(std::memory_order_acquire);
+        return parent_buffer->is_occupied(slot_index(id));
     }
 
     /**
      * @brief 根据对象 ID 计算全局唯一的序列号
      *
-     * @param id 对象 ID（内存地址）
+     * @param id 对象 ID
      * @return 成功返回非负序列号（0 ~ capacity-1），失败返回 -1
      *
      * @note 序列号计算公式：buffer_index * BufferCapacity + slot_index
@@ -296,10 +675,9 @@ class Storage {
      */
     CFW_FORCE_INLINE
     std::int64_t seq_id(std::uintptr_t id) const {
-        auto [index, buffer] = const_cast<Storage*>(this)->get_parent_buffer(id);
+        auto [index, buffer] = get_parent_buffer(id);
         if (index >= 0 && buffer) {
-            return index * BufferCapacity +
-                   (id - reinterpret_cast<std::uintptr_t>(&(buffer->buffer[0]))) / sizeof(T);
+            return index * static_cast<std::int64_t>(BufferCapacity) + static_cast<std::int64_t>(slot_index(id));
         }
         CFW_LOG_FLUSH();
         throw std::runtime_error("Parent buffer not found during seq_id calculation");
@@ -312,12 +690,12 @@ class Storage {
      * @param handle 只读访问句柄
      * @return 若句柄有效则返回非负序列号（0 ~ capacity-1），否则返回 -1
      *
-     * @note 该方法是 seq_id(ObjectId) 的便捷重载，自动从 handle 中提取对象指针并转换为 ID
+     * @note 该方法是 seq_id(ObjectId) 的便捷重载，使用 handle 中记录的对象 ID
      */
     CFW_FORCE_INLINE
     std::int64_t seq_id(const ReadHandle& handle) const {
         if (handle.valid()) {
-            return seq_id(reinterpret_cast<std::uintptr_t>(handle.get()));
+            return seq_id(handle.id());
         }
         return -1;
     }
@@ -328,12 +706,12 @@ class Storage {
      * @param handle 读写访问句柄
      * @return 若句柄有效则返回非负序列号（0 ~ capacity-1），否则返回 -1
      *
-     * @note 该方法是 seq_id(ObjectId) 的便捷重载，自动从 handle 中提取对象指针并转换为 ID
+     * @note 该方法是 seq_id(ObjectId) 的便捷重载，使用 handle 中记录的对象 ID
      */
     CFW_FORCE_INLINE
     std::int64_t seq_id(const WriteHandle& handle) const {
         if (handle.valid()) {
-            return seq_id(reinterpret_cast<std::uintptr_t>(handle.get()));
+            return seq_id(handle.id());
         }
         return -1;
     }
@@ -341,53 +719,60 @@ class Storage {
     /**
      * @brief 分配一个槽位并初始化
      *
-     * @return 成功返回槽位 ID（内存地址），失败返回 0
+     * @return 成功返回槽位 ID，失败返回 0
      *
      * @note 分配流程：
-     *       1. 从空闲队列获取槽位 ID
-     *       2. 若队列为空，则扩容（创建新 buffer 并入队所有新槽位）
-     *       3. 通过 get_parent_buffer() 查找槽位所属的 StaticBuffer
-     *       4. 计算槽位在 buffer 内的索引，加锁后初始化并标记为已占用
+     *       1. 从非满 buffer 链表的栈顶 buffer 中取出一个空闲槽位
+     *       2. 若没有非满 buffer，则扩容（创建新 buffer 并登记到目录）
+     *       3. 必要时提交槽位所在的页，加锁后原地构造对象并标记为已占用，返回编码了 buffer 索引与槽位索引的 ID
      *
      * @note 线程安全，扩容时使用独占锁保护 buffer 列表
-     * @throws std::runtime_error 若无法找到槽位所属的 buffer（理论上不应发生）
      */
     [[nodiscard]]
     ObjectId allocate() {
-        // 1. Try to allocate from existing buffers (prefer head)
-        {
-            std::shared_lock lock(list_mutex_);
-            for (auto& buffer : buffers_) {
-                if (!buffer.is_full.load(std::memory_order_acquire)) {
-                    if (ObjectId id = allocate_from_buffer(buffer)) {
-                        return id;
-                    }
+        ObjectId id = 0;
+        allocate_n(std::span<ObjectId>(&id, 1));
+        return id;
+    }
+
+    /**
+     * @brief 批量分配槽位并初始化
+     *
+     * @param ids 输出：写入 ids.size() 个新分配的 ID
+     *
+     * @note 每个 buffer 只加一次 alloc_mutex 取出一整段空闲索引；空闲槽位不足时一次扩容所需数量的 buffer
+     * @note 线程安全；若 T 的构造抛出异常，本次已分配的槽位全部释放后重新抛出
+     *
+     * @note 使用示例：
+     * @code
+     * std::vector<Storage<Particle>::ObjectId> ids(1024);
+     * particles.allocate_n(ids);
+     * @endcode
+     */
+    void allocate_n(std::span<ObjectId> ids) {
+        std::size_t filled = 0;
+        try {
+            while (filled < ids.size()) {
+                {
+                    std::shared_lock lock(list_mutex_);
+                    allocate_from_free_list_locked(ids, filled);
+                }
+                if (filled == ids.size()) {
+                    break;
                 }
-            }
-        }
 
-        // 2. All buffers full, expand
-        std::unique_lock lock(list_mutex_);
-        // Double check
-        for (auto& buffer : buffers_) {
-            if (!buffer.is_full.load(std::memory_order_acquire)) {
-                if (ObjectId id = allocate_from_buffer(buffer)) {
-                    return id;
+                std::unique_lock lock(list_mutex_);
+                // Double check
+                allocate_from_free_list_locked(ids, filled);
+                if (filled < ids.size()) {
+                    expand_locked((ids.size() - filled + BufferCapacity - 1) / BufferCapacity);
+                    allocate_from_free_list_locked(ids, filled);
                 }
             }
+        } catch (...) {
+            deallocate_n(ids.first(filled));
+            throw;
         }
-
-        buffers_.emplace_back();
-        buffer_count_.fetch_add(1, std::memory_order_relaxed);
-        CFW_LOG_TRACE("Storage<{},{},{}> expanded: new capacity = BufferCount:{} * BufferCapacity:{} = {}",
-                      typeid(T).name(),
-                      BufferCapacity,
-                      InitialBuffers,
-                      buffer_count_.load(std::memory_order_relaxed),
-                      BufferCapacity,
-                      capacity());
-
-        return allocate_from_buffer(buffers_.back());
     }
 
     /**
@@ -397,70 +782,49 @@ class Storage {
      *
      * @note 释放流程：
      *       1. 通过 get_parent_buffer() 查找槽位所属的 StaticBuffer
-     *       2. 计算槽位在 buffer 内的索引
-     *       3. 加独占锁后标记槽位为未占用
-     *       4. 将 ID 重新加入空闲队列以供复用
+     *       2. 从 ID 低位取出槽位索引
+     *       3. 加独占锁后析构对象并标记槽位为未占用
+     *       4. 将槽位索引重新加入空闲队列以供复用，buffer 由满变为非满时重新挂入非满链表
      *
      * @note 线程安全，使用独占锁保护槽位状态
-     * @throws std::runtime_error 若无法找到槽位所属的 buffer（可能是无效 ID）
+     * @throws std::runtime_error 若无法找到槽位所属的 buffer（可能是无效 ID）或重复释放
      */
-    void deallocate(ObjectId id) {
-        T* ptr = reinterpret_cast<T*>(id);
-        auto [_, parent_buffer] = get_parent_buffer(id);
-
-        if (parent_buffer) {
-            std::size_t index = (id - reinterpret_cast<std::uint64_t>(&(parent_buffer->buffer[0]))) / sizeof(T);
+    void deallocate(ObjectId id) { deallocate_n(std::span<const ObjectId>(&id, 1)); }
 
-            {
-                std::unique_lock slot_lock(parent_buffer->mutexes[index]);
-                if (parent_buffer->occupied[index].load(std::memory_order_acquire) == false) {
-                    CFW_LOG_CRITICAL("Double free detected for object ID: {}", id);
-                    CFW_LOG_FLUSH();
-                    throw std::runtime_error("Double free detected");
+    /**
+     * @brief 批量释放槽位
+     *
+     * @param ids 要释放的 ID（由 allocate()/allocate_n() 返回）
+     *
+     * @note 位于同一 buffer 的连续 ID 合并处理：逐槽标记空闲后，只加一次 alloc_mutex 归还整段索引，
+     *       按 allocate_n() 返回的顺序释放时效果最好
+     * @note 线程安全
+     * @throws std::runtime_error 若某个 ID 无效或重复释放（其之前的 ID 已被释放）
+     */
+    void deallocate_n(std::span<const ObjectId> ids) {
+        bool emptied = false;
+        std::size_t begin = 0;
+        while (begin < ids.size()) {
+            auto [_, parent_buffer] = get_parent_buffer(ids[begin]);
+            if (!parent_buffer) {
+                if (emptied) {
+                    try_shrink();
                 }
-                parent_buffer->occupied[index].store(false, std::memory_order_release);
+                CFW_LOG_FLUSH();
+                throw std::runtime_error("Parent buffer not found during deallocation");
             }
 
-            occupied_count_.fetch_sub(1, std::memory_order_relaxed);
-
-            {
-                std::unique_lock alloc_lock(parent_buffer->alloc_mutex);
-                parent_buffer->free_indices.push_back(index);
-                parent_buffer->is_full.store(false, std::memory_order_release);
-            }
-
-            std::size_t active = parent_buffer->active_count.fetch_sub(1, std::memory_order_relaxed) - 1;
-
-            if (active == 0) {
-                std::unique_lock list_lock(list_mutex_, std::try_to_lock);
-                if (list_lock.owns_lock()) {
-                    int empty_cnt = 0;
-                    for (auto it = buffers_.rbegin(); it != buffers_.rend(); ++it) {
-                        if (it->active_count.load() == 0) {
-                            empty_cnt++;
-                        } else {
-                            break;
-                        }
-                    }
-
-                    while (empty_cnt > 2 && buffers_.size() > InitialBuffers) {
-                        buffers_.pop_back();
-                        buffer_count_.fetch_sub(1, std::memory_order_relaxed);
-                        empty_cnt--;
-                        CFW_LOG_TRACE("Storage<{},{},{}> shrunk: new capacity = BufferCount:{} * BufferCapacity:{} = {}",
-                                      typeid(T).name(),
-                                      BufferCapacity,
-                                      InitialBuffers,
-                                      buffer_count_.load(std::memory_order_relaxed),
-                                      BufferCapacity,
-                                      capacity());
-                    }
-                }
+            std::size_t end = begin + 1;
+            while (end < ids.size() && (ids[end] >> kSlotBits) == (ids[begin] >> kSlotBits)) {
+                ++end;
             }
-            return;
+            emptied |= release_run(*parent_buffer, ids.subspan(begin, end - begin));
+            begin = end;
+        }
+
+        if (emptied) {
+            try_shrink();
         }
-        CFW_LOG_FLUSH();
-        throw std::runtime_error("Parent buffer not found during deallocation");
     }
 
     /**
@@ -471,7 +835,7 @@ class Storage {
      *
      * @note 访问流程：
      *       1. 通过 get_parent_buffer() 查找槽位所属的 StaticBuffer
-     *       2. 计算槽位在 buffer 内的索引
+     *       2. 从 ID 低位取出槽位索引
      *       3. 加共享锁后检查占用标志，若已占用则返回持有锁的 Handle
      *
      * @note 线程安全，使用共享锁允许多个读者并发访问
@@ -480,32 +844,16 @@ class Storage {
      */
     [[nodiscard]]
     ReadHandle acquire_read(ObjectId id) {
-        T* ptr = reinterpret_cast<T*>(id);
         auto [_, parent_buffer] = get_parent_buffer(id);
 
         if (parent_buffer) {
-            std::size_t index = (id - reinterpret_cast<ObjectId>(&(parent_buffer->buffer[0]))) / sizeof(T);
-            std::shared_lock<std::shared_timed_mutex> slot_lock(parent_buffer->mutexes[index], std::defer_lock);
-
-#if CFW_ENABLE_LOCK_TIMEOUT
-            // 使用超时锁检测死锁
-            constexpr auto timeout = std::chrono::milliseconds(CFW_LOCK_TIMEOUT_MS);
-            if (!slot_lock.try_lock_for(timeout)) {
-                std::string stack_info = capture_stack_trace(2, 15);
-                std::string error_msg =
-                    "Lock timeout during acquire_read for object " + std::to_string(id) +
-                    " after " + std::to_string(CFW_LOCK_TIMEOUT_MS) + "ms - possible deadlock detected\n" +
-                    stack_info;
-                CFW_LOG_CRITICAL("{}", error_msg);
-                CFW_LOG_FLUSH();
-                throw std::runtime_error(error_msg);
-            }
-#else
-            slot_lock.lock();
-#endif
-
-            if (parent_buffer->occupied[index].load(std::memory_order_acquire)) {
-                return ReadHandle(ptr, std::move(slot_lock));
+            const std::size_t index = slot_index(id);
+            if (parent_buffer->is_committed(index)) {
+                auto [block_lock, slot_lock] =
+                    lock_slot<std::shared_lock<SlotLock>>(*parent_buffer, index, id, "acquire_read");
+                if (parent_buffer->is_occupied(index)) {
+                    return ReadHandle(&parent_buffer->value(index), id, std::move(block_lock), std::move(slot_lock));
+                }
             }
             CFW_LOG_FLUSH();
             throw std::runtime_error("Attempt to acquire read handle for unoccupied object ID: " + std::to_string(id));
@@ -538,35 +886,20 @@ class Storage {
      */
     [[nodiscard]]
     ReadHandle try_acquire_read(ObjectId id) {
-        T* ptr = reinterpret_cast<T*>(id);
         auto [_, parent_buffer] = get_parent_buffer(id);
 
         if (!parent_buffer) {
             return ReadHandle();  // 返回无效句柄
         }
 
-        std::size_t index = (id - reinterpret_cast<ObjectId>(&(parent_buffer->buffer[0]))) / sizeof(T);
-        std::shared_lock<std::shared_timed_mutex> slot_lock(parent_buffer->mutexes[index], std::defer_lock);
-
-#if CFW_ENABLE_LOCK_TIMEOUT
-        // 使用超时锁检测死锁
-        constexpr auto timeout = std::chrono::milliseconds(CFW_LOCK_TIMEOUT_MS);
-        if (!slot_lock.try_lock_for(timeout)) {
-            std::string stack_info = capture_stack_trace(2, 15);
-            std::string error_msg =
-                "Lock timeout during try_acquire_read for object " + std::to_string(id) +
-                " after " + std::to_string(CFW_LOCK_TIMEOUT_MS) + "ms - possible deadlock detected\n" +
-                stack_info;
-            CFW_LOG_CRITICAL("{}", error_msg);
-            CFW_LOG_FLUSH();
-            throw std::runtime_error(error_msg);
+        const std::size_t index = slot_index(id);
+        if (!parent_buffer->is_committed(index)) {
+            return ReadHandle();  // 槽位从未分配过
         }
-#else
-        slot_lock.lock();
-#endif
+        auto [block_lock, slot_lock] = lock_slot<std::shared_lock<SlotLock>>(*parent_buffer, index, id, "try_acquire_read");
 
-        if (parent_buffer->occupied[index].load(std::memory_order_acquire)) {
-            return ReadHandle(ptr, std::move(slot_lock));
+        if (parent_buffer->is_occupied(index)) {
+            return ReadHandle(&parent_buffer->value(index), id, std::move(block_lock), std::move(slot_lock));
         }
         return ReadHandle();  // 槽位未占用，返回无效句柄
     }
@@ -579,7 +912,7 @@ class Storage {
      *
      * @note 访问流程：
      *       1. 通过 get_parent_buffer() 查找槽位所属的 StaticBuffer
-     *       2. 计算槽位在 buffer 内的索引
+     *       2. 从 ID 低位取出槽位索引
      *       3. 加独占锁后检查占用标志，若已占用则返回持有锁的 Handle
      *
      * @note 线程安全，使用独占锁确保独占写入
@@ -588,32 +921,16 @@ class Storage {
      */
     [[nodiscard]]
     WriteHandle acquire_write(ObjectId id) {
-        T* ptr = reinterpret_cast<T*>(id);
         auto [_, parent_buffer] = get_parent_buffer(id);
 
         if (parent_buffer) {
-            std::size_t index = (id - reinterpret_cast<ObjectId>(&(parent_buffer->buffer[0]))) / sizeof(T);
-            std::unique_lock<std::shared_timed_mutex> slot_lock(parent_buffer->mutexes[index], std::defer_lock);
-
-#if CFW_ENABLE_LOCK_TIMEOUT
-            // 使用超时锁检测死锁
-            constexpr auto timeout = std::chrono::milliseconds(CFW_LOCK_TIMEOUT_MS);
-            if (!slot_lock.try_lock_for(timeout)) {
-                std::string stack_info = capture_stack_trace(2, 15);
-                std::string error_msg =
-                    "Lock timeout during acquire_write for object " + std::to_string(id) +
-                    " after " + std::to_string(CFW_LOCK_TIMEOUT_MS) + "ms - possible deadlock detected\n" +
-                    stack_info;
-                CFW_LOG_CRITICAL("{}", error_msg);
-                CFW_LOG_FLUSH();
-                throw std::runtime_error(error_msg);
-            }
-#else
-            slot_lock.lock();
-#endif
-
-            if (parent_buffer->occupied[index].load(std::memory_order_acquire)) {
-                return WriteHandle(ptr, std::move(slot_lock));
+            const std::size_t index = slot_index(id);
+            if (parent_buffer->is_committed(index)) {
+                auto [block_lock, slot_lock] =
+                    lock_slot<std::unique_lock<SlotLock>>(*parent_buffer, index, id, "acquire_write");
+                if (parent_buffer->is_occupied(index)) {
+                    return WriteHandle(&parent_buffer->value(index), id, std::move(block_lock), std::move(slot_lock));
+                }
             }
             CFW_LOG_FLUSH();
             throw std::runtime_error("Attempt to acquire write handle for unoccupied object ID: " + std::to_string(id));
@@ -646,39 +963,136 @@ class Storage {
      */
     [[nodiscard]]
     WriteHandle try_acquire_write(ObjectId id) {
-        T* ptr = reinterpret_cast<T*>(id);
         auto [_, parent_buffer] = get_parent_buffer(id);
 
         if (!parent_buffer) {
             return WriteHandle();  // 返回无效句柄
         }
 
-        std::size_t index = (id - reinterpret_cast<ObjectId>(&(parent_buffer->buffer[0]))) / sizeof(T);
-        std::unique_lock<std::shared_timed_mutex> slot_lock(parent_buffer->mutexes[index], std::defer_lock);
-
-#if CFW_ENABLE_LOCK_TIMEOUT
-        // 使用超时锁检测死锁
-        constexpr auto timeout = std::chrono::milliseconds(CFW_LOCK_TIMEOUT_MS);
-        if (!slot_lock.try_lock_for(timeout)) {
-            std::string stack_info = capture_stack_trace(2, 15);
-            std::string error_msg =
-                "Lock timeout during try_acquire_write for object " + std::to_string(id) +
-                " after " + std::to_string(CFW_LOCK_TIMEOUT_MS) + "ms - possible deadlock detected\n" +
-                stack_info;
-            CFW_LOG_CRITICAL("{}", error_msg);
-            CFW_LOG_FLUSH();
-            throw std::runtime_error(error_msg);
+        const std::size_t index = slot_index(id);
+        if (!parent_buffer->is_committed(index)) {
+            return WriteHandle();  // 槽位从未分配过
         }
-#else
-        slot_lock.lock();
-#endif
+        auto [block_lock, slot_lock] = lock_slot<std::unique_lock<SlotLock>>(*parent_buffer, index, id, "try_acquire_write");
 
-        if (parent_buffer->occupied[index].load(std::memory_order_acquire)) {
-            return WriteHandle(ptr, std::move(slot_lock));
+        if (parent_buffer->is_occupied(index)) {
+            return WriteHandle(&parent_buffer->value(index), id, std::move(block_lock), std::move(slot_lock));
         }
         return WriteHandle();  // 槽位未占用，返回无效句柄
     }
 
+    /**
+     * @brief 读取对象的副本（不抛异常版本）
+     *
+     * @param id 对象 ID
+     * @param out 成功时写入对象副本
+     * @return 若 ID 有效且槽位已占用则返回 true，否则返回 false（out 保持不变）
+     *
+     * @note 当 SlotLock 支持乐观读（如 RwSpinLock）且 T 可平凡复制时，不加锁读取：
+     *       记录块锁与槽位锁版本号 -> 复制对象 -> 校验版本号未变且期间无写者，失败则重试；
+     *       连续 kOptimisticReadRetries 次失败后退化为共享锁读取，保证写入频繁时也能完成
+     * @note 其他情况等价于 try_acquire_read() 后复制对象
+     *
+     * @note 使用示例：
+     * @code
+     * Storage<Transform, 128, 2, RwSpinLock> transforms;
+     * Transform value;
+     * if (transforms.try_read(id, value)) {
+     *     // value 是某一时刻完整一致的副本
+     * }
+     * @endcode
+     */
+    [[nodiscard]]
+    bool try_read(ObjectId id, T& out) {
+        if constexpr (kOptimisticReads) {
+            auto [_, parent_buffer] = get_parent_buffer(id);
+            if (!parent_buffer) {
+                return false;
+            }
+
+            const std::size_t index = slot_index(id);
+            if (!parent_buffer->is_committed(index)) {
+                return false;
+            }
+            const SlotLock& slot_lock = parent_buffer->slot_lock(index);
+            const RwSpinLock& block_lock = parent_buffer->block_lock;
+            alignas(T) std::byte copy[sizeof(T)];
+            for (std::size_t attempt = 0; attempt < kOptimisticReadRetries; ++attempt) {
+                const std::uint64_t block_version = block_lock.read_begin();
+                const std::uint64_t version = slot_lock.read_begin();
+                const bool occupied = parent_buffer->is_occupied(index);
+                optimistic_copy(*parent_buffer->slot_storage(index), copy);
+                if (slot_lock.read_validate(version) && block_lock.read_validate(block_version)) {
+                    if (!occupied) {
+                        return false;
+                    }
+                    std::memcpy(&out, copy, sizeof(T));
+                    return true;
+                }
+                spin_pause();
+            }
+        }
+
+        auto handle = try_acquire_read(id);
+        if (!handle) {
+            return false;
+        }
+        out = *handle;
+        return true;
+    }
+
+    /**
+     * @brief 遍历所有对象（只读）
+     *
+     * @param func 回调函数 void(const T&) 或 void(ObjectId, const T&)
+     *
+     * @note 逐个 buffer 独占块锁后按占用位图遍历（count-trailing-zeros 跳过空槽位），不逐槽加锁，
+     *       与迭代器相比每个 buffer 只需一次原子操作
+     * @note 块内仍有句柄存活时先跳过该 buffer，其余 buffer 遍历完后释放列表锁、让出并重试，不阻塞扩容
+     * @note 回调中不得访问同一 Storage（acquire/allocate/deallocate/try_read），否则会与自身持有的块锁死锁
+     */
+    template <typename Func>
+    void for_each_read(Func&& func) const {
+        sweep_buffers<const T>(0, kAllBuffers, func);
+    }
+
+    /**
+     * @brief 遍历所有对象（可写）
+     *
+     * @param func 回调函数 void(T&) 或 void(ObjectId, T&)
+     *
+     * @note 加锁方式与限制同 for_each_read()
+     */
+    template <typename Func>
+    void for_each_write(Func&& func) {
+        sweep_buffers<T>(0, kAllBuffers, func);
+    }
+
+    /**
+     * @brief 并行遍历所有对象（只读）
+     *
+     * @param func 回调函数 void(const T&) 或 void(ObjectId, const T&)，会在多个 TBB 工作线程上并发调用
+     *
+     * @note 按 buffer 划分给 TBB 工作线程，每个 buffer 独占块锁后遍历，同一 buffer 内的对象由同一线程顺序访问
+     * @note 只遍历调用时已存在的 buffer；其余限制同 for_each_read()
+     */
+    template <typename Func>
+    void parallel_for_each_read(Func&& func) const {
+        parallel_sweep<const T>(func);
+    }
+
+    /**
+     * @brief 并行遍历所有对象（可写）
+     *
+     * @param func 回调函数 void(T&) 或 void(ObjectId, T&)，会在多个 TBB 工作线程上并发调用
+     *
+     * @note 加锁方式与限制同 parallel_for_each_read()
+     */
+    template <typename Func>
+    void parallel_for_each_write(Func&& func) {
+        parallel_sweep<T>(func);
+    }
+
     /**
      * @brief 线程安全的迭代器 (Input Iterator)
      *
@@ -715,19 +1129,6 @@ class Storage {
         bool operator==(const Iterator& other) const { return is_end_ == other.is_end_; }
 
        private:
-        /**
-         * @brief 根据索引获取对应的 buffer 指针
-         * @param index buffer 索引
-         * @return buffer 指针，如果索引超出范围则返回 nullptr
-         * @note 必须在持有 list_mutex_ 共享锁时调用
-         */
-        StaticBuffer<T, BufferCapacity>* get_buffer_at(std::size_t index) {
-            auto it = storage_->buffers_.begin();
-            for (std::size_t i = 0; i < index && it != storage_->buffers_.end(); ++i, ++it) {
-            }
-            return (it != storage_->buffers_.end()) ? &(*it) : nullptr;
-        }
-
         void advance() {
             while (true) {
                 if (!retry_mode_) {
@@ -737,32 +1138,34 @@ class Storage {
                         slot_index_ = 0;
                     }
 
-                    // 获取当前 buffer
-                    StaticBuffer<T, BufferCapacity>* buffer = nullptr;
-                    {
-                        std::shared_lock lock(storage_->list_mutex_);
-                        buffer = get_buffer_at(buffer_index_);
-                        if (!buffer) {
-                            // 已经遍历完所有 buffer，进入重试模式
-                            retry_mode_ = true;
-                            continue;
-                        }
+                    // 获取当前 buffer（持有列表共享锁，防止检查期间 buffer 被缩容回收）
+                    std::shared_lock list_lock(storage_->list_mutex_);
+                    Buffer* buffer = storage_->buffer_at(buffer_index_);
+                    if (!buffer) {
+                        // 已经遍历完所有 buffer，进入重试模式
+                        retry_mode_ = true;
+                        continue;
                     }
 
-                    // 检查当前槽位是否被占用
-                    if (buffer->occupied[slot_index_].load(std::memory_order_acquire)) {
-                        std::unique_lock slot_lock(buffer->mutexes[slot_index_], std::try_to_lock);
-                        if (slot_lock.owns_lock()) {
-                            // 再次检查占用状态（double-check）
-                            if (buffer->occupied[slot_index_].load(std::memory_order_acquire)) {
-                                handle_ = WriteHandle(&buffer->buffer[slot_index_], std::move(slot_lock));
-                                ++slot_index_;
-                                return;
-                            }
-                        } else {
-                            // 锁定失败，加入跳过队列稍后重试
-                            skipped_items_.push({buffer, slot_index_});
+                    // 通过占用位图跳到下一个已占用槽位
+                    slot_index_ = buffer->next_occupied(slot_index_);
+                    if (slot_index_ >= BufferCapacity) {
+                        continue;
+                    }
+
+                    const ObjectId id = make_id(buffer_index_, slot_index_);
+                    std::shared_lock block_lock(buffer->block_lock, std::try_to_lock);
+                    std::unique_lock slot_lock(buffer->slot_lock(slot_index_), std::defer_lock);
+                    if (block_lock.owns_lock() && slot_lock.try_lock()) {
+                        // 再次检查占用状态（double-check）
+                        if (buffer->is_occupied(slot_index_)) {
+                            handle_ = WriteHandle(&buffer->value(slot_index_), id, std::move(block_lock), std::move(slot_lock));
+                            ++slot_index_;
+                            return;
                         }
+                    } else {
+                        // 锁定失败，加入跳过队列稍后重试
+                        skipped_items_.push(id);
                     }
                     ++slot_index_;
                 } else {
@@ -771,14 +1174,33 @@ class Storage {
                         is_end_ = true;
                         return;
                     }
-                    auto [buffer, index] = skipped_items_.front();
+                    const ObjectId id = skipped_items_.front();
                     skipped_items_.pop();
 
-                    // 阻塞等待获取锁
-                    std::unique_lock slot_lock(buffer->mutexes[index]);
-                    if (buffer->occupied[index].load(std::memory_order_acquire)) {
-                        handle_ = WriteHandle(&buffer->buffer[index], std::move(slot_lock));
-                        return;
+                    // 等待获取锁：持有列表共享锁时只 try_lock，未成功则释放列表锁后让出重试，
+                    // 避免在列表锁下阻塞（持锁方可能正在等待扩容）
+                    const std::size_t index = slot_index(id);
+                    while (true) {
+                        std::shared_lock list_lock(storage_->list_mutex_);
+                        auto [_, buffer] = storage_->get_parent_buffer(id);
+                        if (!buffer || !buffer->is_occupied(index)) {
+                            break;  // 槽位已被释放或 buffer 已被回收
+                        }
+                        std::shared_lock block_lock(buffer->block_lock, std::try_to_lock);
+                        std::unique_lock slot_lock(buffer->slot_lock(index), std::defer_lock);
+                        if (block_lock.owns_lock() && slot_lock.try_lock()) {
+                            if (!buffer->is_occupied(index)) {
+                                break;
+                            }
+                            handle_ = WriteHandle(&buffer->value(index), id, std::move(block_lock), std::move(slot_lock));
+                            return;
+                        }
+                        // 块锁必须先于列表锁释放：释放列表锁后 buffer 可能被缩容回收
+                        if (block_lock.owns_lock()) {
+                            block_lock.unlock();
+                        }
+                        list_lock.unlock();
+                        std::this_thread::yield();
                     }
                     // 如果槽位已被释放，继续处理下一个跳过的项
                 }
@@ -788,7 +1210,7 @@ class Storage {
         Storage* storage_ = nullptr;
         std::size_t buffer_index_ = 0;  ///< 当前 buffer 索引（替代迭代器）
         std::size_t slot_index_ = 0;
-        std::queue<std::pair<StaticBuffer<T, BufferCapacity>*, std::size_t>> skipped_items_;
+        std::queue<ObjectId> skipped_items_;
         WriteHandle handle_;
         bool is_end_ = true;
         bool retry_mode_ = false;
@@ -830,19 +1252,6 @@ class Storage {
         bool operator==(const ConstIterator& other) const { return is_end_ == other.is_end_; }
 
        private:
-        /**
-         * @brief 根据索引获取对应的 buffer 指针
-         * @param index buffer 索引
-         * @return buffer 指针，如果索引超出范围则返回 nullptr
-         * @note 必须在持有 list_mutex_ 共享锁时调用
-         */
-        const StaticBuffer<T, BufferCapacity>* get_buffer_at(std::size_t index) const {
-            auto it = storage_->buffers_.begin();
-            for (std::size_t i = 0; i < index && it != storage_->buffers_.end(); ++i, ++it) {
-            }
-            return (it != storage_->buffers_.end()) ? &(*it) : nullptr;
-        }
-
         void advance() {
             while (true) {
                 if (!retry_mode_) {
@@ -852,32 +1261,34 @@ class Storage {
                         slot_index_ = 0;
                     }
 
-                    // 获取当前 buffer
-                    const StaticBuffer<T, BufferCapacity>* buffer = nullptr;
-                    {
-                        std::shared_lock lock(storage_->list_mutex_);
-                        buffer = get_buffer_at(buffer_index_);
-                        if (!buffer) {
-                            // 已经遍历完所有 buffer，进入重试模式
-                            retry_mode_ = true;
-                            continue;
-                        }
+                    // 获取当前 buffer（持有列表共享锁，防止检查期间 buffer 被缩容回收）
+                    std::shared_lock list_lock(storage_->list_mutex_);
+                    const Buffer* buffer = storage_->buffer_at(buffer_index_);
+                    if (!buffer) {
+                        // 已经遍历完所有 buffer，进入重试模式
+                        retry_mode_ = true;
+                        continue;
                     }
 
-                    // 检查当前槽位是否被占用
-                    if (buffer->occupied[slot_index_].load(std::memory_order_acquire)) {
-                        std::shared_lock slot_lock(buffer->mutexes[slot_index_], std::try_to_lock);
-                        if (slot_lock.owns_lock()) {
-                            // 再次检查占用状态（double-check）
-                            if (buffer->occupied[slot_index_].load(std::memory_order_acquire)) {
-                                handle_ = ReadHandle(&buffer->buffer[slot_index_], std::move(slot_lock));
-                                ++slot_index_;
-                                return;
-                            }
-                        } else {
-                            // 锁定失败，加入跳过队列稍后重试
-                            skipped_items_.push({buffer, slot_index_});
+                    // 通过占用位图跳到下一个已占用槽位
+                    slot_index_ = buffer->next_occupied(slot_index_);
+                    if (slot_index_ >= BufferCapacity) {
+                        continue;
+                    }
+
+                    const ObjectId id = make_id(buffer_index_, slot_index_);
+                    std::shared_lock block_lock(buffer->block_lock, std::try_to_lock);
+                    std::shared_lock slot_lock(buffer->slot_lock(slot_index_), std::defer_lock);
+                    if (block_lock.owns_lock() && slot_lock.try_lock()) {
+                        // 再次检查占用状态（double-check）
+                        if (buffer->is_occupied(slot_index_)) {
+                            handle_ = ReadHandle(&buffer->value(slot_index_), id, std::move(block_lock), std::move(slot_lock));
+                            ++slot_index_;
+                            return;
                         }
+                    } else {
+                        // 锁定失败，加入跳过队列稍后重试
+                        skipped_items_.push(id);
                     }
                     ++slot_index_;
                 } else {
@@ -886,14 +1297,29 @@ class Storage {
                         is_end_ = true;
                         return;
                     }
-                    auto [buffer, index] = skipped_items_.front();
+                    const ObjectId id = skipped_items_.front();
                     skipped_items_.pop();
 
-                    // 阻塞等待获取锁
-                    std::shared_lock slot_lock(buffer->mutexes[index]);
-                    if (buffer->occupied[index].load(std::memory_order_acquire)) {
-                        handle_ = ReadHandle(&buffer->buffer[index], std::move(slot_lock));
-                        return;
+                    // 等待获取锁：持有列表共享锁时只 try_lock，未成功则释放列表锁后让出重试，
+                    // 避免在列表锁下阻塞（持锁方可能正在等待扩容）
+                    const std::size_t index = slot_index(id);
+                    while (true) {
+                        std::shared_lock list_lock(storage_->list_mutex_);
+                        auto [_, buffer] = storage_->get_parent_buffer(id);
+                        if (!buffer || !buffer->is_occupied(index)) {
+                            break;  // 槽位已被释放或 buffer 已被回收
+                        }
+                        std::shared_lock block_lock(buffer->block_lock, std::try_to_lock);
+                        std::shared_lock slot_lock(buffer->slot_lock(index), std::defer_lock);
+                        if (block_lock.owns_lock() && slot_lock.try_lock()) {
+                            if (!buffer->is_occupied(index)) {
+                                break;
+                            }
+                            handle_ = ReadHandle(&buffer->value(index), id, std::move(block_lock), std::move(slot_lock));
+                            return;
+                        }
+                        list_lock.unlock();
+                        std::this_thread::yield();
                     }
                     // 如果槽位已被释放，继续处理下一个跳过的项
                 }
@@ -903,7 +1329,7 @@ class Storage {
         const Storage* storage_ = nullptr;
         std::size_t buffer_index_ = 0;  ///< 当前 buffer 索引（替代迭代器）
         std::size_t slot_index_ = 0;
-        mutable std::queue<std::pair<const StaticBuffer<T, BufferCapacity>*, std::size_t>> skipped_items_;
+        mutable std::queue<ObjectId> skipped_items_;
         mutable ReadHandle handle_;
         bool is_end_ = true;
         bool retry_mode_ = false;
@@ -917,72 +1343,671 @@ class Storage {
     ConstIterator cend() const { return ConstIterator(this, true); }
 
    private:
+    /// 是否启用 try_read() 的乐观读路径
+    static constexpr bool kOptimisticReads =
+        CFW_ENABLE_OPTIMISTIC_READS && OptimisticReadLock<SlotLock> && std::is_trivially_copyable_v<T>;
+
+    /// 乐观读连续失败多少次后改用共享锁
+    static constexpr std::size_t kOptimisticReadRetries = 16;
+
+    /**
+     * @brief 以原子加载逐字复制对象（乐观读与写者并发时，保证每次加载本身不构成数据竞争）
+     *
+     * @note 复制结果仅在随后的版本校验通过时才有意义
+     */
+    static void optimistic_copy(const T& source, std::byte* target) noexcept {
+        using Word = std::conditional_t<
+            alignof(T) % sizeof(std::uint64_t) == 0 && sizeof(T) % sizeof(std::uint64_t) == 0, std::uint64_t,
+            std::conditional_t<alignof(T) % sizeof(std::uint32_t) == 0 && sizeof(T) % sizeof(std::uint32_t) == 0,
+                               std::uint32_t, unsigned char>>;
+        auto* words = reinterpret_cast<Word*>(const_cast<T*>(&source));
+        for (std::size_t i = 0; i < sizeof(T) / sizeof(Word); ++i) {
+            const Word word = std::atomic_ref<Word>(words[i]).load(std::memory_order_relaxed);
+            std::memcpy(target + i * sizeof(Word), &word, sizeof(Word));
+        }
+    }
+
+    /// sweep_buffers() 的上界：遍历到第一个不存在的 buffer 为止
+    static constexpr std::size_t kAllBuffers = ~std::size_t{0};
+
+    /// 并行遍历时每个任务至少处理的 buffer 数
+    static constexpr std::size_t kSweepGrainSize = 4;
+
+    /**
+     * @brief 依次获取块共享锁与槽位锁
+     *
+     * @tparam SlotGuard std::shared_lock<SlotLock> 或 std::unique_lock<SlotLock>
+     * @param operation 操作名称（用于超时诊断信息）
+     *
+     * @note CFW_ENABLE_LOCK_TIMEOUT 打开时改用超时加锁，超时后记录调用栈并抛出异常
+     * @throws std::runtime_error 若锁获取超时（可能存在死锁）
+     */
+    template <typename SlotGuard>
+    static std::pair<std::shared_lock<RwSpinLock>, SlotGuard> lock_slot(const Buffer& buffer, std::size_t index,
+                                                                        ObjectId id, const char* operation) {
+        std::shared_lock<RwSpinLock> block_lock(buffer.block_lock, std::defer_lock);
+        SlotGuard slot_lock(buffer.slot_lock(index), std::defer_lock);
+
+#if CFW_ENABLE_LOCK_TIMEOUT
+        // 使用超时锁检测死锁
+        constexpr auto timeout = std::chrono::milliseconds(CFW_LOCK_TIMEOUT_MS);
+        if (!block_lock.try_lock_for(timeout) || !slot_lock.try_lock_for(timeout)) {
+            std::string stack_info = capture_stack_trace(3, 15);
+            std::string error_msg = std::string("Lock timeout during ") + operation + " for object " +
+                                    std::to_string(id) + " after " + std::to_string(CFW_LOCK_TIMEOUT_MS) +
+                                    "ms - possible deadlock detected\n" + stack_info;
+            CFW_LOG_CRITICAL("{}", error_msg);
+            CFW_LOG_FLUSH();
+            throw std::runtime_error(error_msg);
+        }
+#else
+        (void)id;
+        (void)operation;
+        block_lock.lock();
+        slot_lock.lock();
+#endif
+        return {std::move(block_lock), std::move(slot_lock)};
+    }
+
+    /// 调用遍历回调（回调可选择是否接收 ObjectId）
+    template <typename Value, typename Func>
+    static void visit_slot(Func& func, ObjectId id, Value& value) {
+        if constexpr (std::is_invocable_v<Func&, ObjectId, Value&>) {
+            func(id, value);
+        } else {
+            func(value);
+        }
+    }
+
+    /**
+     * @brief 尝试独占一个 buffer 的块锁并遍历其中的对象（需持有 list_mutex_ 共享锁）
+     *
+     * @return 已完成（包括 buffer 不存在）返回 true，块锁被占用返回 false
+     */
+    template <typename Value, typename Func>
+    bool try_sweep_buffer_locked(std::size_t buffer_index, Func& func) const {
+        Buffer* buffer = buffer_at(buffer_index);
+        if (!buffer) {
+            return true;
+        }
+        std::unique_lock block_lock(buffer->block_lock, std::try_to_lock);
+        if (!block_lock.owns_lock()) {
+            return false;
+        }
+
+        // 块锁排除了所有槽位访问者，占用位图在遍历期间保持不变
+        for (std::size_t word = 0; word < Buffer::kOccupancyWords; ++word) {
+            std::uint64_t bits = buffer->occupancy_word(word).load(std::memory_order_relaxed);
+            while (bits != 0) {
+                const std::size_t slot = word * 64 + static_cast<std::size_t>(std::countr_zero(bits));
+                bits &= bits - 1;
+                visit_slot<Value>(func, make_id(buffer_index, slot), buffer->value(slot));
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief 遍历 [first, last) 范围内的 buffer，块锁被占用的 buffer 稍后重试
+     *
+     * @note 重试前释放列表锁并让出，持有句柄的线程可以完成扩容等操作后释放句柄
+     */
+    template <typename Value, typename Func>
+    void sweep_buffers(std::size_t first, std::size_t last, Func& func) const {
+        std::vector<std::size_t> deferred;
+        {
+            std::shared_lock list_lock(list_mutex_);
+            for (std::size_t i = first; i < last && buffer_at(i); ++i) {
+                if (!try_sweep_buffer_locked<Value>(i, func)) {
+                    deferred.push_back(i);
+                }
+            }
+        }
+
+        while (!deferred.empty()) {
+            std::this_thread::yield();
+            std::shared_lock list_lock(list_mutex_);
+            std::erase_if(deferred, [&](std::size_t i) { return try_sweep_buffer_locked<Value>(i, func); });
+        }
+    }
+
+    /// 按 buffer 划分给 TBB 工作线程并行遍历
+    template <typename Value, typename Func>
+    void parallel_sweep(Func& func) const {
+        const std::size_t count = buffer_count_.load(std::memory_order_acquire);
+        tbb::parallel_for(tbb::blocked_range<std::size_t>(0, count, kSweepGrainSize),
+                          [&](const tbb::blocked_range<std::size_t>& range) {
+                              sweep_buffers<Value>(range.begin(), range.end(), func);
+                          });
+    }
+
+    /// 槽位索引占用的 ID 低位数
+    static constexpr std::size_t kSlotBits = std::countr_zero(BufferCapacity);
+
+    /// buffer 目录段数（第 k 段容纳 2^k 个 buffer）
+    static constexpr std::size_t kDirectorySegments = 32;
+
+    /// 由 buffer 索引与槽位索引构造 ID（buffer 索引加 1，保证有效 ID 非 0）
+    [[nodiscard]] static constexpr ObjectId make_id(std::size_t buffer_index, std::size_t slot) noexcept {
+        return (static_cast<ObjectId>(buffer_index + 1) << kSlotBits) | static_cast<ObjectId>(slot);
+    }
+
+    /// 从 ID 取出槽位索引
+    [[nodiscard]] static constexpr std::size_t slot_index(ObjectId id) noexcept {
+        return static_cast<std::size_t>(id & (BufferCapacity - 1));
+    }
+
+    /// buffer 索引在目录中的位置：{段号, 段内偏移}
+    [[nodiscard]] static constexpr std::pair<std::size_t, std::size_t> directory_position(
+        std::size_t buffer_index) noexcept {
+        const std::size_t n = buffer_index + 1;
+        const std::size_t segment = static_cast<std::size_t>(std::bit_width(n)) - 1;
+        return {segment, n - (std::size_t{1} << segment)};
+    }
+
+    /**
+     * @brief 通过目录查找 buffer（无锁）
+     *
+     * @param buffer_index buffer 索引
+     * @return buffer 指针，不存在（未创建或已回收）返回 nullptr
+     */
+    [[nodiscard]]
+    Buffer* buffer_at(std::size_t buffer_index) const noexcept {
+        const auto [segment, offset] = directory_position(buffer_index);
+        if (segment >= kDirectorySegments) {
+            return nullptr;
+        }
+        const auto* entries = directory_[segment].load(std::memory_order_acquire);
+        return entries ? entries[offset].load(std::memory_order_acquire) : nullptr;
+    }
+
     /**
      * @brief 根据槽位 ID 查找其所属的 StaticBuffer 及其索引
      *
-     * @param id 槽位 ID（内存地址）
+     * @param id 槽位 ID
      * @return std::pair<std::int64_t, StaticBuffer*>
      *         - first: buffer 在列表中的索引，未找到返回 -1
      *         - second: 指向 StaticBuffer 的指针，未找到返回 nullptr
      *
-     * @note 查找逻辑：
-     *       1. 加 buffer 列表共享锁
-     *       2. 遍历所有 buffer，检查 id 是否在该 buffer 的地址范围内
-     *       3. 地址范围：[&buffer[0], &buffer[BufferCapacity-1]]
+     * @note 查找逻辑：ID 高位即 buffer 索引 + 1，经一次移位后在分段目录中原子读取 buffer 指针
      *
-     * @note 线程安全，使用共享锁保护 buffer 列表
+     * @note 无锁：只有空 buffer 会被回收，持有有效 ID 的调用者不会与回收竞争
      */
     [[nodiscard]]
-    std::pair<std::int64_t, StaticBuffer<T, BufferCapacity>*> get_parent_buffer(ObjectId id) {
-        std::int64_t index = 0;
-        std::shared_lock lock(list_mutex_);
-        for (auto& buffer : buffers_) {
-            if (id >= reinterpret_cast<ObjectId>(&(buffer.buffer[0])) &&
-                id <= reinterpret_cast<ObjectId>(&(buffer.buffer[BufferCapacity - 1]))) {
-                return {index, &buffer};
+    std::pair<std::int64_t, Buffer*> get_parent_buffer(ObjectId id) const noexcept {
+        const ObjectId encoded = id >> kSlotBits;
+        if (encoded == 0) {
+            return {-1, nullptr};
+        }
+        const auto buffer_index = static_cast<std::size_t>(encoded - 1);
+        Buffer* buffer = buffer_at(buffer_index);
+        if (!buffer) {
+            return {-1, nullptr};
+        }
+        return {static_cast<std::int64_t>(buffer_index), buffer};
+    }
+
+    /**
+     * @brief 在末尾追加一个 buffer 并登记到目录（需持有 list_mutex_ 独占锁或处于构造阶段）
+     */
+    void append_buffer_locked() {
+        const std::size_t buffer_index = buffers_.size();
+        const auto [segment, offset] = directory_position(buffer_index);
+        if (segment >= kDirectorySegments) {
+            CFW_LOG_FLUSH();
+            throw std::length_error("Storage buffer directory exhausted");
+        }
+
+        auto* entries = directory_[segment].load(std::memory_order_relaxed);
+        if (!entries) {
+            entries = new std::atomic<Buffer*>[std::size_t{1} << segment]();
+            directory_[segment].store(entries, std::memory_order_release);
+        }
+        buffers_.push_back(is_persistent() ? map_buffer_locked(buffer_index) : std::make_unique<Buffer>());
+        buffers_.back()->free_list_node.index = buffer_index;
+        entries[offset].store(buffers_.back().get(), std::memory_order_release);
+        if (is_persistent()) {
+            file_header_->buffer_count = buffers_.size();
+        }
+    }
+
+    /**
+     * @brief 从目录注销并释放末尾的 buffer（需持有 list_mutex_ 独占锁）
+     */
+    void remove_last_buffer_locked() {
+        const auto [segment, offset] = directory_position(buffers_.size() - 1);
+        directory_[segment].load(std::memory_order_relaxed)[offset].store(nullptr, std::memory_order_release);
+        buffers_.pop_back();
+        if (is_persistent()) {
+            // 先更新文件头再截断：中途崩溃时文件只会比记录的更长
+            file_header_->buffer_count = buffers_.size();
+            Kernal::Memory::resize_mapped_file(file_, file_header_bytes_ + buffers_.size() * file_segment_bytes_);
+        }
+    }
+
+    /**
+     * @brief 释放所有 buffer、目录与文件映射（析构或构造失败时调用）
+     */
+    void release_buffers() noexcept {
+        buffers_.clear();
+        for (auto& segment : directory_) {
+            delete[] segment.load(std::memory_order_relaxed);
+            segment.store(nullptr, std::memory_order_relaxed);
+        }
+        if (file_header_) {
+            Kernal::Memory::unmap_file(file_header_, file_header_bytes_);
+            file_header_ = nullptr;
+        }
+        Kernal::Memory::close_mapped_file(std::exchange(file_, Kernal::Memory::kInvalidFileHandle));
+    }
+
+    // ========================================
+    // 持久化（文件映射）
+    // ========================================
+
+    /// 持久化文件头（位于文件起始处，占一个映射粒度）
+    struct FileHeader {
+        std::uint64_t magic;
+        std::uint32_t version;
+        std::uint32_t header_bytes;    ///< 文件头占用的字节数（= 映射粒度）
+        std::uint64_t value_size;      ///< sizeof(T)
+        std::uint64_t value_alignment;  ///< alignof(T)
+        std::uint64_t buffer_capacity;  ///< BufferCapacity
+        std::uint64_t segment_bytes;    ///< 每个 buffer 映像在文件中占用的字节数
+        std::uint64_t buffer_count;     ///< 文件中的 buffer 数量
+    };
+
+    static constexpr std::uint64_t kFileMagic = 0x3152'4F54'5357'4643;  ///< "CFWSTOR1"
+    static constexpr std::uint32_t kFileVersion = 1;
+
+    /**
+     * @brief 打开映射文件，新文件写入文件头，已有文件校验文件头（构造阶段调用）
+     *
+     * @throws std::runtime_error 若文件无法打开/映射或校验失败
+     */
+    void open_file(const std::string& path) {
+        const std::size_t granularity = Kernal::Memory::file_mapping_granularity();
+        file_header_bytes_ = Kernal::Memory::align_up(sizeof(FileHeader), granularity);
+        file_segment_bytes_ = Kernal::Memory::align_up(Buffer::kImageBytes, granularity);
+
+        std::size_t file_size = 0;
+        file_ = Kernal::Memory::open_mapped_file(path.c_str(), file_size);
+        if (file_ == Kernal::Memory::kInvalidFileHandle) {
+            CFW_LOG_FLUSH();
+            throw std::runtime_error("Failed to open storage file (missing permissions or locked by another process): " +
+                                     path);
+        }
+
+        const bool created = file_size == 0;
+        if (created && !Kernal::Memory::resize_mapped_file(file_, file_header_bytes_)) {
+            CFW_LOG_FLUSH();
+            throw std::runtime_error("Failed to initialize storage file: " + path);
+        }
+        if (!created && file_size < file_header_bytes_) {
+            CFW_LOG_FLUSH();
+            throw std::runtime_error("Storage file is not a valid storage image: " + path);
+        }
+
+        file_header_ = static_cast<FileHeader*>(Kernal::Memory::map_file(file_, 0, file_header_bytes_));
+        if (!file_header_) {
+            CFW_LOG_FLUSH();
+            throw std::runtime_error("Failed to map storage file header: " + path);
+        }
+
+        FileHeader& header = *file_header_;
+        if (created) {
+            header.magic = kFileMagic;
+            header.version = kFileVersion;
+            header.header_bytes = static_cast<std::uint32_t>(file_header_bytes_);
+            header.value_size = sizeof(T);
+            header.value_alignment = alignof(T);
+            header.buffer_capacity = BufferCapacity;
+            header.segment_bytes = file_segment_bytes_;
+            header.buffer_count = 0;
+            return;
+        }
+
+        if (header.magic != kFileMagic || header.version != kFileVersion) {
+            CFW_LOG_FLUSH();
+            throw std::runtime_error("Storage file is not a valid storage image: " + path);
+        }
+        if (header.header_bytes != file_header_bytes_ || header.value_size != sizeof(T) ||
+            header.value_alignment != alignof(T) || header.buffer_capacity != BufferCapacity ||
+            header.segment_bytes != file_segment_bytes_) {
+            CFW_LOG_CRITICAL("Storage file layout mismatch: value size {} (expected {}), capacity {} (expected {})",
+                             header.value_size,
+                             sizeof(T),
+                             header.buffer_capacity,
+                             BufferCapacity);
+            CFW_LOG_FLUSH();
+            throw std::runtime_error("Storage file layout does not match the storage type: " + path);
+        }
+        if (file_size < file_header_bytes_ + header.buffer_count * file_segment_bytes_) {
+            CFW_LOG_FLUSH();
+            throw std::runtime_error("Storage file is truncated: " + path);
+        }
+    }
+
+    /**
+     * @brief 映射第 buffer_index 个 buffer 的文件映像，必要时扩展文件（需持有 list_mutex_ 独占锁或处于构造阶段）
+     *
+     * @note 扩展部分由系统填零，新 buffer 的占用位图全空
+     */
+    std::unique_ptr<Buffer> map_buffer_locked(std::size_t buffer_index) {
+        const std::size_t offset = file_header_bytes_ + buffer_index * file_segment_bytes_;
+        if (buffer_index >= file_header_->buffer_count &&
+            !Kernal::Memory::resize_mapped_file(file_, offset + file_segment_bytes_)) {
+            CFW_LOG_FLUSH();
+            throw std::runtime_error("Failed to extend storage file");
+        }
+        auto* image = static_cast<std::byte*>(Kernal::Memory::map_file(file_, offset, file_segment_bytes_));
+        if (!image) {
+            CFW_LOG_FLUSH();
+            throw std::runtime_error("Failed to map storage file segment");
+        }
+        return std::make_unique<Buffer>(image, file_segment_bytes_);
+    }
+
+    /**
+     * @brief 根据文件中的占用位图重建 buffer 的分配状态（构造阶段调用）
+     *
+     * @note 高水位线取最后一个已占用槽位之后，其下的空闲槽位放入 recycled（小索引优先复用）
+     */
+    void restore_buffer_locked(Buffer& buffer) {
+        std::size_t live = 0;
+        std::size_t high_water = 0;
+        for (std::size_t i = buffer.next_occupied(0); i < BufferCapacity; i = buffer.next_occupied(i + 1)) {
+            ++live;
+            high_water = i + 1;
+        }
+        if (high_water == 0) {
+            return;
+        }
+
+        for (std::size_t i = high_water; i-- > 0;) {
+            if (!buffer.is_occupied(i)) {
+                buffer.recycled.push_back(static_cast<std::uint32_t>(i));
             }
-            ++index;
         }
-        return {-1, nullptr};
+        buffer.high_water = high_water;
+        buffer.active_count.store(live, std::memory_order_relaxed);
+        occupied_count_.fetch_add(live, std::memory_order_relaxed);
+
+        const std::size_t bytes = buffer.commit(high_water);
+        if (!buffer.is_committed(high_water - 1)) {
+            CFW_LOG_FLUSH();
+            throw std::bad_alloc();
+        }
+        committed_bytes_.fetch_add(bytes, std::memory_order_relaxed);
+        Kernal::Memory::track_allocation(tag_, bytes);
     }
 
-    [[nodiscard]]
-    ObjectId allocate_from_buffer(StaticBuffer<T, BufferCapacity>& buffer) {
-        std::unique_lock alloc_lock(buffer.alloc_mutex);
-        if (buffer.free_indices.empty()) return 0;
+    /**
+     * @brief 将 buffer 挂入非满链表（需持有 buffer.alloc_mutex，或 buffer 尚未对其他线程可见）
+     *
+     * @note 调用时 buffer 必须仍有存活槽位或持有 list_mutex_，保证缩容不会在入栈后释放它
+     */
+    void list_if_needed_locked(Buffer& buffer) noexcept {
+        if (!buffer.in_free_list) {
+            buffer.in_free_list = true;
+            free_list_.push(&buffer.free_list_node);
+        }
+    }
+
+    /**
+     * @brief 从非满链表分配，直到填满 ids 或链表为空（需持有 list_mutex_）
+     *
+     * @param filled 输入输出：ids 中已分配的数量
+     */
+    void allocate_from_free_list_locked(std::span<ObjectId> ids, std::size_t& filled) {
+        while (filled < ids.size()) {
+            Kernal::Memory::LockFreeNode* node = free_list_.peek();
+            if (!node) {
+                return;
+            }
+            auto* list_node = static_cast<typename Buffer::FreeListNode*>(node);
+            if (!allocate_run_from_buffer(*list_node->owner, list_node->index, ids, filled)) {
+                drop_full_head_locked();
+            }
+        }
+    }
 
-        std::size_t idx = buffer.free_indices.back();
-        buffer.free_indices.pop_back();
-        if (buffer.free_indices.empty()) {
-            buffer.is_full.store(true, std::memory_order_release);
+    /**
+     * @brief 弹出栈顶 buffer：已满则移出链表，否则放回（需持有 list_mutex_）
+     */
+    void drop_full_head_locked() {
+        Kernal::Memory::LockFreeNode* node = free_list_.pop();
+        if (!node) {
+            return;
         }
-        buffer.active_count.fetch_add(1, std::memory_order_relaxed);
-        alloc_lock.unlock();
+        Buffer& buffer = *static_cast<typename Buffer::FreeListNode*>(node)->owner;
+        std::lock_guard alloc_lock(buffer.alloc_mutex);
+        if (buffer.free_count() == 0) {
+            buffer.in_free_list = false;
+        } else {
+            free_list_.push(node);
+        }
+    }
 
-        T* ptr = &buffer.buffer[idx];
-        ObjectId id = reinterpret_cast<ObjectId>(ptr);
+    /**
+     * @brief 从一个 buffer 取出一段空闲槽位并初始化（需持有 list_mutex_）
+     *
+     * @param filled 输入输出：ids 中已分配的数量，每初始化一个槽位递增
+     * @return buffer 没有空闲槽位时返回 false
+     */
+    bool allocate_run_from_buffer(Buffer& buffer, std::size_t buffer_index, std::span<ObjectId> ids,
+                                  std::size_t& filled) {
+        // ids 中尚未分配的部分用作暂存区
+        std::size_t run = 0;
+        {
+            std::lock_guard alloc_lock(buffer.alloc_mutex);
+            run = std::min(buffer.free_count(), ids.size() - filled);
+            if (run == 0) {
+                return false;
+            }
 
-        std::unique_lock slot_lock(buffer.mutexes[idx]);
+            // 先复用释放过的槽位，不足部分从高水位线取，必要时提交新页
+            const std::size_t reused = std::min(buffer.recycled.size(), run);
+            const std::size_t high_water = buffer.high_water + (run - reused);
+            if (high_water > 0 && !buffer.is_committed(high_water - 1)) {
+                const std::size_t bytes = buffer.commit(high_water);
+                if (!buffer.is_committed(high_water - 1)) {
+                    CFW_LOG_FLUSH();
+                    throw std::bad_alloc();
+                }
+                committed_bytes_.fetch_add(bytes, std::memory_order_relaxed);
+                Kernal::Memory::track_allocation(tag_, bytes);
+            }
+
+            for (std::size_t i = 0; i < reused; ++i) {
+                ids[filled + i] = make_id(buffer_index, buffer.recycled.back());
+                buffer.recycled.pop_back();
+            }
+            for (std::size_t i = reused; i < run; ++i) {
+                ids[filled + i] = make_id(buffer_index, buffer.high_water++);
+            }
+            buffer.active_count.fetch_add(run, std::memory_order_relaxed);
+        }
+
+        std::size_t constructed = 0;
         try {
-            *ptr = T{};
+            for (; constructed < run; ++constructed) {
+                const ObjectId id = ids[filled + constructed];
+                const std::size_t idx = slot_index(id);
+                auto [block_lock, slot_lock] = lock_slot<std::unique_lock<SlotLock>>(buffer, idx, id, "allocate");
+                std::construct_at(buffer.slot_storage(idx));
+                buffer.set_occupied(idx);
+            }
         } catch (...) {
-            std::unique_lock rb_lock(buffer.alloc_mutex);
-            buffer.free_indices.push_back(idx);
-            buffer.is_full.store(false, std::memory_order_release);
-            buffer.active_count.fetch_sub(1, std::memory_order_relaxed);
+            // 归还尚未初始化的槽位，已初始化的由调用者释放
+            {
+                std::lock_guard rb_lock(buffer.alloc_mutex);
+                for (std::size_t i = constructed; i < run; ++i) {
+                    buffer.recycled.push_back(static_cast<std::uint32_t>(slot_index(ids[filled + i])));
+                }
+                list_if_needed_locked(buffer);
+            }
+            buffer.active_count.fetch_sub(run - constructed, std::memory_order_release);
+            occupied_count_.fetch_add(constructed, std::memory_order_relaxed);
+            filled += constructed;
             CFW_LOG_FLUSH();
             throw;
         }
-        buffer.occupied[idx].store(true, std::memory_order_release);
-        occupied_count_.fetch_add(1, std::memory_order_relaxed);
-        return id;
+
+        occupied_count_.fetch_add(run, std::memory_order_relaxed);
+        filled += run;
+        return true;
+    }
+
+    /**
+     * @brief 释放同一 buffer 中的一段槽位
+     *
+     * @return buffer 是否因此变空
+     * @throws std::runtime_error 若检测到重复释放（此前的槽位已归还）
+     */
+    bool release_run(Buffer& buffer, std::span<const ObjectId> run) {
+        std::size_t cleared = 0;
+        for (; cleared < run.size(); ++cleared) {
+            const ObjectId id = run[cleared];
+            const std::size_t index = slot_index(id);
+            if (!buffer.is_committed(index)) {
+                break;  // 槽位从未分配过
+            }
+            auto [block_lock, slot_lock] = lock_slot<std::unique_lock<SlotLock>>(buffer, index, id, "deallocate");
+            if (!buffer.is_occupied(index)) {
+                break;
+            }
+            std::destroy_at(&buffer.value(index));
+            buffer.clear_occupied(index);
+        }
+
+        bool emptied = false;
+        if (cleared > 0) {
+            occupied_count_.fetch_sub(cleared, std::memory_order_relaxed);
+            {
+                std::lock_guard alloc_lock(buffer.alloc_mutex);
+                for (std::size_t i = 0; i < cleared; ++i) {
+                    buffer.recycled.push_back(static_cast<std::uint32_t>(slot_index(run[i])));
+                }
+                list_if_needed_locked(buffer);
+            }
+            // 入栈先于计数递减：缩容观察到计数归零时，入栈必然可见
+            emptied = buffer.active_count.fetch_sub(cleared, std::memory_order_acq_rel) == cleared;
+        }
+
+        if (cleared < run.size()) {
+            if (emptied) {
+                try_shrink();
+            }
+            CFW_LOG_CRITICAL("Double free detected for object ID: {}", run[cleared]);
+            CFW_LOG_FLUSH();
+            throw std::runtime_error("Double free detected");
+        }
+        return emptied;
+    }
+
+    /**
+     * @brief 扩容 count 个 buffer 并挂入非满链表（需持有 list_mutex_ 独占锁）
+     */
+    void expand_locked(std::size_t count) {
+        for (std::size_t i = 0; i < count; ++i) {
+            append_buffer_locked();
+            list_if_needed_locked(*buffers_.back());  // 新 buffer 尚未对其他线程可见
+        }
+        buffer_count_.fetch_add(count, std::memory_order_relaxed);
+        Kernal::Memory::track_allocation(tag_, count * kBufferHeaderBytes);
+        CFW_LOG_TRACE("Storage<{},{},{}> expanded: new capacity = BufferCount:{} * BufferCapacity:{} = {}",
+                      typeid(T).name(),
+                      BufferCapacity,
+                      InitialBuffers,
+                      buffer_count_.load(std::memory_order_relaxed),
+                      BufferCapacity,
+                      capacity());
+    }
+
+    /**
+     * @brief 尝试缩容：末尾连续空 buffer 超过 2 个时释放多余部分，且不少于 InitialBuffers
+     *
+     * @note 只尝试获取独占锁，失败则放弃（由之后的释放再次触发）
+     */
+    void try_shrink() {
+        std::unique_lock list_lock(list_mutex_, std::try_to_lock);
+        if (!list_lock.owns_lock()) {
+            return;
+        }
+
+        std::size_t empty_cnt = 0;
+        for (auto it = buffers_.rbegin(); it != buffers_.rend(); ++it) {
+            if ((*it)->active_count.load(std::memory_order_acquire) == 0) {
+                empty_cnt++;
+            } else {
+                break;
+            }
+        }
+
+        std::size_t keep = buffers_.size();
+        while (empty_cnt > 2 && keep > InitialBuffers) {
+            --keep;
+            --empty_cnt;
+        }
+        if (keep == buffers_.size()) {
+            return;
+        }
+
+        // 先将要释放的 buffer 移出非满链表：持有独占锁时没有并发出栈，链上节点只会被并发入栈
+        Kernal::Memory::LockFreeNode* node = free_list_.take_all();
+        Kernal::Memory::LockFreeNode* first = nullptr;
+        Kernal::Memory::LockFreeNode* last = nullptr;
+        while (node) {
+            Kernal::Memory::LockFreeNode* next = node->next.load(std::memory_order_relaxed);
+            if (static_cast<typename Buffer::FreeListNode*>(node)->index < keep) {
+                if (last) {
+                    last->next.store(node, std::memory_order_relaxed);
+                } else {
+                    first = node;
+                }
+                last = node;
+            }
+            node = next;
+        }
+        free_list_.push_list(first, last);
+
+        while (buffers_.size() > keep) {
+            // 独占列表锁期间没有分配者，buffer 不会再提交新页
+            const std::size_t bytes = buffers_.back()->committed_bytes;
+            remove_last_buffer_locked();
+            buffer_count_.fetch_sub(1, std::memory_order_relaxed);
+            committed_bytes_.fetch_sub(bytes, std::memory_order_relaxed);
+            Kernal::Memory::track_deallocation(tag_, kBufferHeaderBytes + bytes);
+            CFW_LOG_TRACE("Storage<{},{},{}> shrunk: new capacity = BufferCount:{} * BufferCapacity:{} = {}",
+                          typeid(T).name(),
+                          BufferCapacity,
+                          InitialBuffers,
+                          buffer_count_.load(std::memory_order_relaxed),
+                          BufferCapacity,
+                          capacity());
+        }
     }
 
    private:
+    /// 单个 StaticBuffer 的固定内存占用（含所有权指针与目录项，槽位区按提交量另计）
+    static constexpr std::size_t kBufferHeaderBytes = sizeof(Buffer) + 2 * sizeof(void*);
+
+    Kernal::Memory::MemoryTag tag_;                           ///< MemoryTracker 标签
     std::atomic<std::size_t> occupied_count_{0};             ///< 已占用槽位计数
+    std::atomic<std::size_t> committed_bytes_{0};            ///< 所有 buffer 已提交的槽位区字节数
     mutable std::shared_mutex list_mutex_;                   ///< 保护 buffers_ 列表的锁（mutable 允许 const 方法加锁）
-    std::list<StaticBuffer<T, BufferCapacity>> buffers_;     ///< 底层 buffer 列表
+    std::vector<std::unique_ptr<Buffer>> buffers_;           ///< 底层 buffer（按索引排列，持有所有权）
     std::atomic<std::size_t> buffer_count_{InitialBuffers};  ///< 当前 buffer 数量
+    Kernal::Memory::LockFreeStack free_list_;                ///< 非满 buffer 链表（无锁栈）
+
+    Kernal::Memory::FileHandle file_ = Kernal::Memory::kInvalidFileHandle;  ///< 持久化映射文件
+    FileHeader* file_header_ = nullptr;                                      ///< 映射的文件头
+    std::size_t file_header_bytes_ = 0;
+    std::size_t file_segment_bytes_ = 0;  ///< 每个 buffer 映像在文件中占用的字节数
+
+    /// 分段 buffer 目录：ID -> buffer 的无锁查找表（段在析构前不释放）
+    std::array<std::atomic<std::atomic<Buffer*>*>, kDirectorySegments> directory_{};
 };
 
 }  // namespace Corona::Kernel::Utils
\ No newline at end of file
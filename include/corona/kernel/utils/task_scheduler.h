@@ -1,7 +1,17 @@
 #pragma once
 
+#include <corona/kernel/utils/event_count.h>
 #include <corona/kernel/utils/work_stealing_queue.h>
 
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <stop_token>
+#include <thread>
+#include <vector>
+
 namespace Corona::Kernal::Utils {
 
 /**
@@ -12,8 +22,10 @@ namespace Corona::Kernal::Utils {
  *
  * @details 核心特性：
  * - 工作窃取 (Work-Stealing)：空闲线程可以从其他线程的队列中窃取任务
- * - 负载均衡：任务提交采用轮询分配，运行时通过窃取实现动态平衡
- * - 线程休眠：使用条件变量，空闲时休眠节省 CPU 资源
+ * - 无锁本地队列：工作线程提交的任务进入自己的 Chase-Lev 队列，所有者 LIFO 执行、窃取者 FIFO 窃取
+ * - 负载均衡：外部线程提交的任务轮询分配到各工作线程的收件箱，运行时通过窃取实现动态平衡
+ * - 线程休眠：空闲时先短暂自旋，再通过 EventCount 休眠；提交任务时唤醒一个休眠线程，
+ *   没有休眠线程时提交路径不加锁、不进入内核
  * - 优雅关闭：使用 C++20 stop_token 实现协作式取消
  *
  * @details 使用场景：
@@ -46,7 +58,8 @@ class TaskScheduler final {
     /**
      * @brief 提交任务到调度器
      *
-     * 任务会被分配到某个工作线程的队列中，采用轮询策略实现负载均衡。
+     * 从工作线程提交（如任务内嵌套提交）时推入该线程自己的无锁队列；
+     * 从其他线程提交时以轮询策略放入某个工作线程的收件箱。
      * 提交后会唤醒一个休眠的工作线程（如果有）。
      *
      * @param task 要执行的任务（移动语义，避免拷贝）
@@ -90,11 +103,12 @@ class TaskScheduler final {
      * @brief 工作线程的主循环
      *
      * 每个线程的执行逻辑：
-     * 1. 尝试从自己的队列中取任务
-     * 2. 如果自己队列为空，尝试从其他线程窃取任务
-     * 3. 如果窃取失败，进入休眠等待新任务或停止信号
+     * 1. 尝试从自己的无锁队列中取任务（LIFO）
+     * 2. 尝试从自己的收件箱中取任务（FIFO）
+     * 3. 如果都为空，尝试从其他线程窃取任务
+     * 4. 如果窃取失败，自旋 kIdleSpinRounds 轮后进入休眠，等待新任务或停止信号
      *
-     * @param index 当前线程的索引（对应 task_queues_ 的索引）
+     * @param index 当前线程的索引（对应 workers_ 的索引）
      * @param stop_token 停止令牌，用于协作式取消
      */
     void worker_loop(std::uint32_t index, std::stop_token stop_token);
@@ -102,7 +116,8 @@ class TaskScheduler final {
     /**
      * @brief 尝试从其他线程窃取并执行任务
      *
-     * 随机选择一个起始队列，然后遍历所有其他线程的队列尝试窃取。
+     * 以线程本地的 xorshift 随机数选择起始线程，遍历其他线程的无锁队列尝试窃取，
+     * 都为空时再尝试其他线程的收件箱（只 try_lock，不阻塞）。
      * 随机起始位置避免所有线程总是从同一个队列窃取。
      *
      * @param index 调用线程的索引（可选）。如果提供，会跳过自己的队列
@@ -113,22 +128,42 @@ class TaskScheduler final {
     /**
      * @brief 检查是否还有任务待执行
      *
-     * @return 当前实现简化为始终返回 true
-     * @todo 未来可以优化为实际检查所有队列是否为空
+     * @return 任一工作线程的无锁队列或收件箱非空时返回 true（并发修改时为近似值）
+     * @note 只读取各队列的计数，不加锁；用于休眠前的最终检查
      */
     bool has_any_task() const;
 
+    /// 工作线程连续找不到任务多少轮后休眠
+    static constexpr std::uint32_t kIdleSpinRounds = 64;
+
+    /**
+     * @brief 每个工作线程的任务来源
+     */
+    struct alignas(Memory::CacheLineSize) Worker {
+        WorkStealingQueue local;  ///< 本线程提交的任务（Chase-Lev，仅本线程 push / try_pop）
+
+        std::mutex inbox_mutex;                   ///< 保护收件箱
+        std::deque<Task> inbox;                   ///< 外部线程提交的任务
+        std::atomic<std::size_t> inbox_size{0};  ///< 收件箱任务数，避免检查空收件箱时加锁
+    };
+
+    /**
+     * @brief 从收件箱取出最早的任务
+     *
+     * @param blocking false 时只 try_lock，锁被占用则直接返回 std::nullopt
+     */
+    static std::optional<Task> take_from_inbox(Worker& worker, bool blocking);
+
    private:
-    const uint32_t thread_count_;                 ///< 工作线程数量（等于 CPU 核心数）
-    std::vector<std::jthread> threads_;           ///< 工作线程池（C++20 jthread 自动 join）
-    std::vector<WorkStealingQueue> task_queues_;  ///< 每个线程对应一个任务队列
-    std::atomic<uint32_t> submission_index_{0};   ///< 任务提交轮询计数器（原子操作保证线程安全）
+    const uint32_t thread_count_;                ///< 工作线程数量（等于 CPU 核心数）
+    std::vector<Worker> workers_;                ///< 每个线程对应一组任务队列
+    std::atomic<uint32_t> submission_index_{0};  ///< 外部提交轮询计数器（原子操作保证线程安全）
 
     std::stop_source stop_source_;  ///< 停止源，用于请求所有线程停止
 
-    // 线程休眠与唤醒机制
-    std::condition_variable cv_;  ///< 条件变量，用于线程休眠和唤醒
-    std::mutex cv_mutex_;         ///< 保护条件变量的互斥锁
+    EventCount idle_;  ///< 空闲工作线程的休眠与唤醒
+
+    std::vector<std::jthread> threads_;  ///< 工作线程池（最后声明、最先析构：线程退出后才销毁队列）
 };
 
 }  // namespace Corona::Kernal::Utils
\ No newline at end of file
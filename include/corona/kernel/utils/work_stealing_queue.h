@@ -1,9 +1,14 @@
 #pragma once
 
-#include <deque>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
-#include <mutex>
+#include <memory>
 #include <optional>
+#include <vector>
+
+#include "corona/kernel/memory/cache_aligned_allocator.h"
 
 namespace Corona::Kernal::Utils {
 
@@ -13,58 +18,108 @@ using Task = std::function<void()>;
 /**
  * @brief 工作窃取队列 (Work-Stealing Queue)
  *
- * 用于多线程任务调度的双端队列实现。支持从队列头部弹出任务（所有者线程），
- * 以及从队列尾部窃取任务（其他线程）。这种设计可以有效平衡多线程负载。
+ * Chase-Lev 无锁双端队列：所有者线程在底部推入和弹出任务，其他线程从顶部窃取任务。
  *
  * @details 工作窃取算法原理：
  * - 每个工作线程拥有自己的任务队列
- * - 线程优先从自己队列的头部取任务（FIFO）
- * - 当自己的队列为空时，随机选择其他线程的队列，从尾部窃取任务
- * - 头部和尾部操作减少了锁竞争的概率
+ * - 所有者从底部取任务（LIFO）：刚推入的任务及其数据仍在本核缓存中
+ * - 窃取者从顶部取任务（FIFO）：取走最早推入的任务，与所有者在队列两端工作
+ * - 所有者的 push / try_pop 只读写自己的 bottom 索引，仅在争夺最后一个任务时与窃取者 CAS 竞争 top
+ *
+ * @details 实现细节：
+ * - 环形缓冲区容量为 2 的幂次，满时由所有者扩容为两倍并复制现有任务
+ * - 旧缓冲区保留到队列析构：窃取者可能仍在读取旧缓冲区（累计不超过当前缓冲区大小）
+ * - 槽位存放 Task*（任务对象分配在堆上）：窃取者可能读取到随后 CAS 失败的槽位，
+ *   只有指针能被安全地原子读取，std::function 本身不能
  *
  * @note 标记为 final 防止继承，确保类的行为不被改变
- * @thread_safety 所有公共方法都是线程安全的
+ * @thread_safety push() 与 try_pop() 只能由所有者线程调用；try_steal()、empty()、size() 可由任意线程调用
  */
 class WorkStealingQueue final {
    public:
-    WorkStealingQueue() = default;
-    ~WorkStealingQueue() = default;
+    /// 默认初始容量
+    static constexpr std::size_t kDefaultCapacity = 256;
+
+    /**
+     * @brief 构造函数
+     *
+     * @param initial_capacity 初始容量（向上取整为 2 的幂次）
+     */
+    explicit WorkStealingQueue(std::size_t initial_capacity = kDefaultCapacity);
 
     /**
-     * @brief 将任务推入队列尾部
+     * @brief 析构函数，销毁队列中剩余的任务
      *
-     * 通常由队列的所有者线程调用，将新任务添加到队列。
+     * @note 析构时不得有并发访问
+     */
+    ~WorkStealingQueue();
+
+    WorkStealingQueue(const WorkStealingQueue&) = delete;
+    WorkStealingQueue& operator=(const WorkStealingQueue&) = delete;
+    WorkStealingQueue(WorkStealingQueue&&) = delete;
+    WorkStealingQueue& operator=(WorkStealingQueue&&) = delete;
+
+    /**
+     * @brief 将任务推入队列底部（所有者操作）
      *
      * @param task 要添加的任务（移动语义）
-     * @thread_safety 线程安全，内部使用互斥锁保护
+     * @thread_safety 仅所有者线程调用
      */
     void push(Task task);
 
     /**
-     * @brief 尝试从队列头部弹出任务（所有者操作）
-     *
-     * 由队列的所有者线程调用，从队列头部获取任务。
-     * 采用 FIFO 顺序，优先执行最早添加的任务。
+     * @brief 尝试从队列底部弹出任务（所有者操作，LIFO）
      *
-     * @return 如果队列非空，返回队列头部的任务；否则返回 std::nullopt
-     * @thread_safety 线程安全，内部使用互斥锁保护
+     * @return 如果队列非空，返回最近推入的任务；否则返回 std::nullopt
+     * @thread_safety 仅所有者线程调用
      */
     [[nodiscard]] std::optional<Task> try_pop();
 
     /**
-     * @brief 尝试从队列尾部窃取任务（窃取者操作）
-     *
-     * 由其他工作线程调用，从队列尾部获取任务。
-     * 采用 LIFO 顺序，从尾部窃取最近添加的任务，减少与 try_pop 的竞争。
+     * @brief 尝试从队列顶部窃取任务（窃取者操作，FIFO）
      *
-     * @return 如果队列非空，返回队列尾部的任务；否则返回 std::nullopt
-     * @thread_safety 线程安全，内部使用互斥锁保护
+     * @return 窃取到的任务；队列为空或与其他线程竞争失败时返回 std::nullopt
+     * @thread_safety 线程安全，可从任意线程调用
      */
     [[nodiscard]] std::optional<Task> try_steal();
 
+    /**
+     * @brief 队列是否为空（并发修改时为近似值）
+     */
+    [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+
+    /**
+     * @brief 当前任务数（并发修改时为近似值）
+     */
+    [[nodiscard]] std::size_t size() const noexcept;
+
    private:
-    std::deque<Task> tasks_;  ///< 任务双端队列，支持高效的头尾操作
-    std::mutex mutex_;        ///< 互斥锁，保护任务队列的并发访问
+    /// 环形缓冲区
+    struct Ring {
+        explicit Ring(std::size_t capacity)
+            : mask(capacity - 1), slots(std::make_unique<std::atomic<Task*>[]>(capacity)) {}
+
+        [[nodiscard]] std::size_t capacity() const noexcept { return mask + 1; }
+
+        [[nodiscard]] Task* load(std::int64_t index) const noexcept {
+            return slots[static_cast<std::size_t>(index) & mask].load(std::memory_order_relaxed);
+        }
+
+        void store(std::int64_t index, Task* task) noexcept {
+            slots[static_cast<std::size_t>(index) & mask].store(task, std::memory_order_relaxed);
+        }
+
+        std::size_t mask;
+        std::unique_ptr<std::atomic<Task*>[]> slots;
+    };
+
+    /// 扩容为两倍大小，复制 [top, bottom) 的任务（所有者操作）
+    Ring* grow(Ring* ring, std::int64_t top, std::int64_t bottom);
+
+    alignas(Memory::CacheLineSize) std::atomic<std::int64_t> top_{0};  ///< 窃取端索引（窃取者 CAS 递增）
+    alignas(Memory::CacheLineSize) std::atomic<std::int64_t> bottom_{0};  ///< 所有者端索引（仅所有者写入）
+    std::atomic<Ring*> ring_{nullptr};                                      ///< 当前环形缓冲区
+    std::vector<std::unique_ptr<Ring>> rings_;  ///< 当前及已退役的缓冲区（仅所有者修改）
 };
 
-}  // namespace Corona::Kernal::Utils
\ No newline at end of file
+}  // namespace Corona::Kernal::Utils
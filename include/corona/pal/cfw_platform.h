@@ -273,6 +273,19 @@ static constexpr size_t CFW_CACHE_LINE_SIZE = 64;  // 保守值
 #define CFW_RESTRICT
 #endif
 
+// 软件预取（提示 CPU 提前把缓存行加载到 L1）
+#if defined(CFW_COMPILER_GCC) || defined(CFW_COMPILER_CLANG)
+#define CFW_PREFETCH(addr) __builtin_prefetch((addr), 0, 3)
+#define CFW_PREFETCH_WRITE(addr) __builtin_prefetch((addr), 1, 3)
+#elif defined(CFW_COMPILER_MSVC) && (defined(_M_X64) || defined(_M_IX86))
+#include <xmmintrin.h>
+#define CFW_PREFETCH(addr) _mm_prefetch(reinterpret_cast<const char*>(addr), _MM_HINT_T0)
+#define CFW_PREFETCH_WRITE(addr) _mm_prefetch(reinterpret_cast<const char*>(addr), _MM_HINT_T0)
+#else
+#define CFW_PREFETCH(addr) ((void)(addr))
+#define CFW_PREFETCH_WRITE(addr) ((void)(addr))
+#endif
+
 // 纯函数（无副作用）
 #if defined(CFW_COMPILER_GCC) || defined(CFW_COMPILER_CLANG)
 #define CFW_PURE __attribute__((pure))
@@ -24,6 +24,7 @@ Archetype::Archetype(Archetype&& other) noexcept
       signature_(std::move(other.signature_)),
       layout_(std::move(other.layout_)),
       chunks_(std::move(other.chunks_)),
+      chunk_data_(std::move(other.chunk_data_)),
       allocator_(other.allocator_) {
     other.id_ = kInvalidArchetypeId;
     other.allocator_ = nullptr;
@@ -42,6 +43,7 @@ Archetype& Archetype::operator=(Archetype&& other) noexcept {
         signature_ = std::move(other.signature_);
         layout_ = std::move(other.layout_);
         chunks_ = std::move(other.chunks_);
+        chunk_data_ = std::move(other.chunk_data_);
         allocator_ = other.allocator_;
 
         other.id_ = kInvalidArchetypeId;
@@ -84,6 +86,19 @@ EntityLocation Archetype::allocate_entity() {
     return EntityLocation{static_cast<std::size_t>(chunk_index), index_in_chunk};
 }
 
+EntityLocation Archetype::allocate_entity(EntityId entity) {
+    EntityLocation location = allocate_entity();
+    chunks_[location.chunk_index]->set_entity(location.index_in_chunk, entity);
+    return location;
+}
+
+EntityId Archetype::entity_at(const EntityLocation& location) const {
+    if (location.chunk_index >= chunks_.size()) {
+        return kInvalidEntity;
+    }
+    return chunks_[location.chunk_index]->entity_at(location.index_in_chunk);
+}
+
 std::optional<EntityLocation> Archetype::deallocate_entity(const EntityLocation& location) {
     if (location.chunk_index >= chunks_.size()) {
         return std::nullopt;  // 无效的 chunk 索引
@@ -118,6 +133,44 @@ const void* Archetype::get_component(const EntityLocation& location,
     return const_cast<Archetype*>(this)->get_component(location, type_id);
 }
 
+void* Archetype::get_field(const EntityLocation& location, ComponentTypeId type_id,
+                           std::size_t field_index) {
+    if (location.chunk_index >= chunks_.size()) {
+        return nullptr;
+    }
+
+    auto& chunk = *chunks_[location.chunk_index];
+    if (location.index_in_chunk >= chunk.size()) {
+        return nullptr;
+    }
+
+    const auto* comp_layout = layout_.find_component(type_id);
+    if (!comp_layout || field_index >= comp_layout->fields.size()) {
+        return nullptr;
+    }
+
+    auto* column = static_cast<std::byte*>(chunk.get_field_array(type_id, field_index));
+    return column + location.index_in_chunk * comp_layout->fields[field_index].size;
+}
+
+bool Archetype::read_split_component(const EntityLocation& location, ComponentTypeId type_id,
+                                     void* dst) const {
+    if (location.chunk_index >= chunks_.size()) {
+        return false;
+    }
+    return chunks_[location.chunk_index]->read_split_component(type_id, location.index_in_chunk,
+                                                               dst);
+}
+
+bool Archetype::write_split_component(const EntityLocation& location, ComponentTypeId type_id,
+                                      const void* src) {
+    if (location.chunk_index >= chunks_.size()) {
+        return false;
+    }
+    return chunks_[location.chunk_index]->write_split_component(type_id, location.index_in_chunk,
+                                                                src);
+}
+
 Chunk& Archetype::get_chunk(std::size_t index) {
     assert(index < chunks_.size() && "Invalid chunk index");
     return *chunks_[index];
@@ -128,6 +181,12 @@ const Chunk& Archetype::get_chunk(std::size_t index) const {
     return *chunks_[index];
 }
 
+void Archetype::ensure_chunk_count(std::size_t count) {
+    while (chunks_.size() < count) {
+        create_chunk();
+    }
+}
+
 void Archetype::ensure_capacity() {
     if (find_available_chunk() < 0) {
         create_chunk();
@@ -137,6 +196,7 @@ void Archetype::ensure_capacity() {
 Chunk& Archetype::create_chunk() {
     // 使用内存分配器创建 Chunk
     auto chunk = std::make_unique<Chunk>(layout_, layout_.entities_per_chunk, allocator_);
+    chunk_data_.push_back(chunk->data());
     chunks_.push_back(std::move(chunk));
     return *chunks_.back();
 }
@@ -55,27 +55,50 @@ ArchetypeLayout ArchetypeLayout::calculate(const ArchetypeSignature& signature,
 
     // 计算 SoA 布局中每个组件数组的偏移
     // 布局：[CompA * N][CompB * N][CompC * N]...
-    std::size_t current_offset = 0;
-    layout.components.reserve(type_infos.size());
-
-    for (const auto* info : type_infos) {
-        // 对齐到组件的对齐要求
-        current_offset = align_up(current_offset, info->alignment);
-
-        ComponentLayout comp_layout;
-        comp_layout.type_id = info->id;
-        comp_layout.array_offset = current_offset;
-        comp_layout.size = info->size;
-        comp_layout.alignment = info->alignment;
-        comp_layout.type_info = info;
-
-        layout.components.push_back(comp_layout);
-
-        // 移动到下一个组件数组的起始位置
-        current_offset += info->size * layout.entities_per_chunk;
+    // 拆分组件按字段展开：[CompA.f0 * N][CompA.f1 * N]...
+    auto place_arrays = [&](std::size_t entities) {
+        layout.components.clear();
+        layout.components.reserve(type_infos.size());
+
+        std::size_t current_offset = 0;
+        for (const auto* info : type_infos) {
+            ComponentLayout comp_layout;
+            comp_layout.type_id = info->id;
+            comp_layout.size = info->size;
+            comp_layout.alignment = info->alignment;
+            comp_layout.type_info = info;
+
+            if (info->is_split()) {
+                comp_layout.fields.reserve(info->fields.size());
+                for (const auto& field : info->fields) {
+                    current_offset = align_up(current_offset, field.alignment);
+                    comp_layout.fields.push_back(
+                        FieldLayout{field.offset, current_offset, field.size});
+                    current_offset += field.size * entities;
+                }
+                comp_layout.array_offset = comp_layout.fields.front().array_offset;
+            } else {
+                // 对齐到组件的对齐要求
+                current_offset = align_up(current_offset, info->alignment);
+                comp_layout.array_offset = current_offset;
+
+                // 移动到下一个组件数组的起始位置
+                current_offset += info->size * entities;
+            }
+
+            layout.components.push_back(std::move(comp_layout));
+        }
+        return current_offset;
+    };
+
+    // 子列各自对齐会引入填充，超出 Chunk 大小时减少容量
+    std::size_t data_size = place_arrays(layout.entities_per_chunk);
+    while (data_size > chunk_size && layout.entities_per_chunk > 1) {
+        --layout.entities_per_chunk;
+        data_size = place_arrays(layout.entities_per_chunk);
     }
 
-    layout.chunk_data_size = current_offset;
+    layout.chunk_data_size = data_size;
 
     return layout;
 }
@@ -89,6 +112,14 @@ const ComponentLayout* ArchetypeLayout::find_component(ComponentTypeId type_id)
     return nullptr;
 }
 
+std::ptrdiff_t ArchetypeLayout::component_index(ComponentTypeId type_id) const {
+    const auto* comp = find_component(type_id);
+    if (comp) {
+        return comp - components.data();
+    }
+    return -1;
+}
+
 std::ptrdiff_t ArchetypeLayout::get_array_offset(ComponentTypeId type_id) const {
     const auto* comp = find_component(type_id);
     if (comp) {
@@ -46,8 +46,8 @@ Chunk::Chunk(const ArchetypeLayout& layout, std::size_t capacity)
         // 分配对齐内存（使用 64 字节对齐以优化缓存）
         constexpr std::size_t kChunkAlignment = 64;
         data_ = static_cast<std::byte*>(aligned_alloc_impl(layout_->chunk_data_size, kChunkAlignment));
-        init_memory();
     }
+    init_memory();
 }
 
 Chunk::Chunk(const ArchetypeLayout& layout, std::size_t capacity, ChunkAllocator* allocator)
@@ -55,8 +55,8 @@ Chunk::Chunk(const ArchetypeLayout& layout, std::size_t capacity, ChunkAllocator
     if (capacity_ > 0 && layout_->chunk_data_size > 0 && allocator_) {
         // 从分配器获取内存
         data_ = static_cast<std::byte*>(allocator_->allocate());
-        init_memory();
     }
+    init_memory();
 }
 
 void Chunk::init_memory() {
@@ -64,6 +64,8 @@ void Chunk::init_memory() {
         // 零初始化
         std::memset(data_, 0, layout_->chunk_data_size);
     }
+    entities_.assign(capacity_, kInvalidEntity);
+    column_versions_.assign(layout_->components.size(), 0);
 }
 
 Chunk::~Chunk() {
@@ -89,7 +91,10 @@ Chunk::Chunk(Chunk&& other) noexcept
       capacity_(other.capacity_),
       layout_(other.layout_),
       allocator_(other.allocator_),
-      owns_memory_(other.owns_memory_) {
+      owns_memory_(other.owns_memory_),
+      entities_(std::move(other.entities_)),
+      column_versions_(std::move(other.column_versions_)),
+      structure_version_(other.structure_version_) {
     other.data_ = nullptr;
     other.count_ = 0;
     other.capacity_ = 0;
@@ -121,6 +126,9 @@ Chunk& Chunk::operator=(Chunk&& other) noexcept {
         layout_ = other.layout_;
         allocator_ = other.allocator_;
         owns_memory_ = other.owns_memory_;
+        entities_ = std::move(other.entities_);
+        column_versions_ = std::move(other.column_versions_);
+        structure_version_ = other.structure_version_;
 
         other.data_ = nullptr;
         other.count_ = 0;
@@ -138,7 +146,7 @@ void* Chunk::get_component_array(ComponentTypeId type_id) {
     }
 
     const auto* comp_layout = layout_->find_component(type_id);
-    if (!comp_layout) {
+    if (!comp_layout || comp_layout->is_split()) {
         return nullptr;
     }
 
@@ -159,7 +167,7 @@ void* Chunk::get_component_at(ComponentTypeId type_id, std::size_t index) {
     }
 
     const auto* comp_layout = layout_->find_component(type_id);
-    if (!comp_layout) {
+    if (!comp_layout || comp_layout->is_split()) {
         return nullptr;
     }
 
@@ -171,6 +179,61 @@ const void* Chunk::get_component_at(ComponentTypeId type_id, std::size_t index)
     return const_cast<Chunk*>(this)->get_component_at(type_id, index);
 }
 
+void* Chunk::get_field_array(ComponentTypeId type_id, std::size_t field_index) {
+    if (!data_ || !layout_) {
+        return nullptr;
+    }
+
+    const auto* comp_layout = layout_->find_component(type_id);
+    if (!comp_layout || field_index >= comp_layout->fields.size()) {
+        return nullptr;
+    }
+
+    return data_ + comp_layout->fields[field_index].array_offset;
+}
+
+const void* Chunk::get_field_array(ComponentTypeId type_id, std::size_t field_index) const {
+    return const_cast<Chunk*>(this)->get_field_array(type_id, field_index);
+}
+
+bool Chunk::read_split_component(ComponentTypeId type_id, std::size_t index, void* dst) const {
+    if (index >= count_ || !data_ || !layout_ || !dst) {
+        return false;
+    }
+
+    const auto* comp_layout = layout_->find_component(type_id);
+    if (!comp_layout || !comp_layout->is_split()) {
+        return false;
+    }
+
+    // 先用原型填充（保留未拆分的填充字节），再逐字段聚合
+    std::memcpy(dst, comp_layout->type_info->default_value, comp_layout->size);
+    auto* out = static_cast<std::byte*>(dst);
+    for (const auto& field : comp_layout->fields) {
+        std::memcpy(out + field.offset_in_component, data_ + field.array_offset + index * field.size,
+                    field.size);
+    }
+    return true;
+}
+
+bool Chunk::write_split_component(ComponentTypeId type_id, std::size_t index, const void* src) {
+    if (index >= count_ || !data_ || !layout_ || !src) {
+        return false;
+    }
+
+    const auto* comp_layout = layout_->find_component(type_id);
+    if (!comp_layout || !comp_layout->is_split()) {
+        return false;
+    }
+
+    const auto* in = static_cast<const std::byte*>(src);
+    for (const auto& field : comp_layout->fields) {
+        std::memcpy(data_ + field.array_offset + index * field.size, in + field.offset_in_component,
+                    field.size);
+    }
+    return true;
+}
+
 std::size_t Chunk::allocate() {
     assert(!is_full() && "Chunk is full, cannot allocate");
     assert(layout_ != nullptr && "Layout is null");
@@ -180,10 +243,26 @@ std::size_t Chunk::allocate() {
 
     // 构造所有组件
     construct_components_at(index);
+    entities_[index] = kInvalidEntity;
 
     return index;
 }
 
+void Chunk::resize(std::size_t count) {
+    assert(count <= capacity_ && "Chunk resize exceeds capacity");
+    assert(layout_ != nullptr && "Layout is null");
+
+    while (count_ > count) {
+        --count_;
+        destruct_components_at(count_);
+    }
+    while (count_ < count) {
+        construct_components_at(count_);
+        entities_[count_] = kInvalidEntity;
+        ++count_;
+    }
+}
+
 std::optional<std::size_t> Chunk::deallocate(std::size_t index) {
     if (index >= count_ || layout_ == nullptr) {
         return std::nullopt;  // 无效的索引或布局
@@ -203,6 +282,7 @@ std::optional<std::size_t> Chunk::deallocate(std::size_t index) {
         // 3. 析构源位置（移动后的残留对象）
         destruct_components_at(count_ - 1);
 
+        entities_[index] = entities_[count_ - 1];
         moved_from = count_ - 1;
     } else {
         // 是最后一个元素，直接析构
@@ -219,7 +299,14 @@ void Chunk::construct_components_at(std::size_t index) {
     }
 
     for (const auto& comp : layout_->components) {
-        if (comp.type_info && comp.type_info->construct) {
+        if (comp.is_split()) {
+            // SoA 组件没有整体对象，按字段从默认值原型拷贝
+            const auto* proto = static_cast<const std::byte*>(comp.type_info->default_value);
+            for (const auto& field : comp.fields) {
+                std::memcpy(data_ + field.array_offset + index * field.size,
+                            proto + field.offset_in_component, field.size);
+            }
+        } else if (comp.type_info && comp.type_info->construct) {
             void* ptr = data_ + comp.array_offset + index * comp.size;
             comp.type_info->construct(ptr);
         }
@@ -232,6 +319,10 @@ void Chunk::destruct_components_at(std::size_t index) {
     }
 
     for (const auto& comp : layout_->components) {
+        // SoA 组件要求 trivially destructible，无需析构
+        if (comp.is_split()) {
+            continue;
+        }
         if (comp.type_info && comp.type_info->destruct && !comp.type_info->is_trivially_destructible) {
             void* ptr = data_ + comp.array_offset + index * comp.size;
             comp.type_info->destruct(ptr);
@@ -245,6 +336,11 @@ void Chunk::move_construct_components(std::size_t dst, std::size_t src) {
     }
 
     for (const auto& comp : layout_->components) {
+        if (comp.is_split()) {
+            copy_split_fields(comp, dst, src);
+            continue;
+        }
+
         void* dst_ptr = data_ + comp.array_offset + dst * comp.size;
         void* src_ptr = data_ + comp.array_offset + src * comp.size;
 
@@ -264,6 +360,11 @@ void Chunk::move_assign_components(std::size_t dst, std::size_t src) {
     }
 
     for (const auto& comp : layout_->components) {
+        if (comp.is_split()) {
+            copy_split_fields(comp, dst, src);
+            continue;
+        }
+
         void* dst_ptr = data_ + comp.array_offset + dst * comp.size;
         void* src_ptr = data_ + comp.array_offset + src * comp.size;
 
@@ -277,4 +378,11 @@ void Chunk::move_assign_components(std::size_t dst, std::size_t src) {
     }
 }
 
+void Chunk::copy_split_fields(const ComponentLayout& comp, std::size_t dst, std::size_t src) {
+    for (const auto& field : comp.fields) {
+        std::memcpy(data_ + field.array_offset + dst * field.size,
+                    data_ + field.array_offset + src * field.size, field.size);
+    }
+}
+
 }  // namespace Corona::Kernel::ECS
@@ -1,6 +1,8 @@
 #include "corona/kernel/ecs/chunk_allocator.h"
 
+#include <algorithm>
 #include <cassert>
+#include <cstdint>
 #include <cstdlib>
 #include <cstring>
 
@@ -10,6 +12,14 @@ namespace Corona::Kernel::ECS {
 
 namespace {
 
+using Kernal::Memory::MemoryTag;
+using Kernal::Memory::PageBackend;
+using Kernal::Memory::track_allocation;
+using Kernal::Memory::track_deallocation;
+
+/// 页后端每次提交的最小步长（256KB），避免逐 Chunk 调用 mprotect
+constexpr std::size_t kMinCommitStep = 256 * 1024;
+
 /// 计算对齐大小
 [[nodiscard]] constexpr std::size_t align_up(std::size_t size, std::size_t alignment) {
     return (size + alignment - 1) & ~(alignment - 1);
@@ -29,6 +39,11 @@ namespace {
 #endif
 }
 
+/// 向下对齐
+[[nodiscard]] constexpr std::size_t align_down(std::size_t size, std::size_t alignment) {
+    return size & ~(alignment - 1);
+}
+
 /// 释放对齐内存
 void aligned_free_impl(void* ptr) {
     if (!ptr) {
@@ -44,11 +59,14 @@ void aligned_free_impl(void* ptr) {
 
 }  // namespace
 
-ChunkAllocator::ChunkAllocator(std::size_t chunk_size, std::size_t arena_size, bool thread_safe)
+ChunkAllocator::ChunkAllocator(std::size_t chunk_size, std::size_t arena_size, bool thread_safe,
+                               PageBackend backend, MemoryTag tag)
     : chunk_size_(chunk_size),
       arena_size_(arena_size),
       aligned_chunk_size_(align_up(chunk_size, kDefaultAlignment)),
-      thread_safe_(thread_safe) {
+      thread_safe_(thread_safe),
+      backend_(Kernal::Memory::virtual_memory_supported() ? backend : PageBackend::Heap),
+      tag_(tag) {
     // 确保至少能容纳一个 Chunk
     if (arena_size_ < aligned_chunk_size_) {
         arena_size_ = aligned_chunk_size_ * 16;  // 默认预分配 16 个 Chunk 的空间
@@ -57,13 +75,7 @@ ChunkAllocator::ChunkAllocator(std::size_t chunk_size, std::size_t arena_size, b
 
 ChunkAllocator::~ChunkAllocator() {
     // 释放所有 Arena 内存
-    for (auto& arena : arenas_) {
-        aligned_free_impl(arena.data);
-    }
-    arenas_.clear();
-    free_list_ = nullptr;
-    allocated_count_ = 0;
-    free_count_ = 0;
+    release_all_arenas();
 }
 
 ChunkAllocator::ChunkAllocator(ChunkAllocator&& other) noexcept
@@ -71,35 +83,41 @@ ChunkAllocator::ChunkAllocator(ChunkAllocator&& other) noexcept
       arena_size_(other.arena_size_),
       aligned_chunk_size_(other.aligned_chunk_size_),
       thread_safe_(other.thread_safe_),
+      backend_(other.backend_),
+      tag_(other.tag_),
       arenas_(std::move(other.arenas_)),
       free_list_(other.free_list_),
       allocated_count_(other.allocated_count_),
-      free_count_(other.free_count_) {
+      free_count_(other.free_count_),
+      decommitted_bytes_(other.decommitted_bytes_) {
     other.free_list_ = nullptr;
     other.allocated_count_ = 0;
     other.free_count_ = 0;
+    other.decommitted_bytes_ = 0;
 }
 
 ChunkAllocator& ChunkAllocator::operator=(ChunkAllocator&& other) noexcept {
     if (this != &other) {
         // 释放当前资源
-        for (auto& arena : arenas_) {
-            aligned_free_impl(arena.data);
-        }
+        release_all_arenas();
 
         // 移动数据
         chunk_size_ = other.chunk_size_;
         arena_size_ = other.arena_size_;
         aligned_chunk_size_ = other.aligned_chunk_size_;
         thread_safe_ = other.thread_safe_;
+        backend_ = other.backend_;
+        tag_ = other.tag_;
         arenas_ = std::move(other.arenas_);
         free_list_ = other.free_list_;
         allocated_count_ = other.allocated_count_;
         free_count_ = other.free_count_;
+        decommitted_bytes_ = other.decommitted_bytes_;
 
         other.free_list_ = nullptr;
         other.allocated_count_ = 0;
         other.free_count_ = 0;
+        other.decommitted_bytes_ = 0;
     }
     return *this;
 }
@@ -188,6 +206,22 @@ std::size_t ChunkAllocator::used_memory() const {
     return allocated_count_ * aligned_chunk_size_;
 }
 
+std::size_t ChunkAllocator::committed_memory() const {
+    if (thread_safe_) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return committed_memory_impl();
+    }
+    return committed_memory_impl();
+}
+
+std::size_t ChunkAllocator::committed_memory_impl() const {
+    std::size_t committed = 0;
+    for (const auto& arena : arenas_) {
+        committed += arena.committed;
+    }
+    return committed - decommitted_bytes_;
+}
+
 void ChunkAllocator::reset() {
     if (thread_safe_) {
         std::lock_guard<std::mutex> lock(mutex_);
@@ -199,13 +233,7 @@ void ChunkAllocator::reset() {
 
 void ChunkAllocator::reset_impl() {
     // 释放所有 Arena
-    for (auto& arena : arenas_) {
-        aligned_free_impl(arena.data);
-    }
-    arenas_.clear();
-    free_list_ = nullptr;
-    allocated_count_ = 0;
-    free_count_ = 0;
+    release_all_arenas();
 }
 
 void ChunkAllocator::shrink() {
@@ -218,12 +246,97 @@ void ChunkAllocator::shrink() {
 }
 
 void ChunkAllocator::shrink_impl() {
-    // 简单实现：只清空空闲列表中的内存，不真正释放 Arena
-    // 更高级的实现可以追踪每个 Arena 的使用情况并释放完全空闲的 Arena
-    // 这里暂时不做，因为需要更复杂的记账
+    if (arenas_.empty() || free_count_ == 0) {
+        return;
+    }
+
+    // 按地址排序的 Arena 索引，用于 O(log n) 定位空闲 Chunk 所属 Arena
+    std::vector<std::size_t> order(arenas_.size());
+    for (std::size_t i = 0; i < order.size(); ++i) {
+        order[i] = i;
+    }
+    std::sort(order.begin(), order.end(),
+              [this](std::size_t a, std::size_t b) { return arenas_[a].data < arenas_[b].data; });
+
+    auto arena_of = [&](const void* ptr) {
+        auto it = std::upper_bound(order.begin(), order.end(), static_cast<const std::byte*>(ptr),
+                                   [this](const std::byte* p, std::size_t index) { return p < arenas_[index].data; });
+        assert(it != order.begin());
+        return *(it - 1);
+    };
+
+    // 统计每个 Arena 的空闲 Chunk 数量
+    std::vector<std::size_t> free_per_arena(arenas_.size(), 0);
+    for (FreeNode* node = free_list_; node; node = node->next) {
+        ++free_per_arena[arena_of(node)];
+    }
+
+    // 已划分的 Chunk 全部空闲的 Arena 可以整体释放
+    std::vector<bool> releasable(arenas_.size(), false);
+    bool any_releasable = false;
+    for (std::size_t i = 0; i < arenas_.size(); ++i) {
+        const std::size_t carved = arenas_[i].offset / aligned_chunk_size_;
+        if (carved > 0 && free_per_arena[i] == carved) {
+            releasable[i] = true;
+            any_releasable = true;
+        }
+    }
+
+    // 重建空闲链表：跳过将被释放的 Arena，VirtualMemory 后端顺带归还其余空闲 Chunk 的物理页
+    const bool decommit = backend_ == PageBackend::VirtualMemory;
+    std::vector<std::size_t> released_pages(arenas_.size(), 0);  // 被释放 Arena 中此前已归还的字节数
+    if (any_releasable || decommit) {
+        FreeNode** link = &free_list_;
+        while (FreeNode* node = *link) {
+            const bool was_decommitted = node->decommitted;
+            const auto [begin, end] = decommit_range(node);
+            const auto bytes = static_cast<std::size_t>(end - begin);
+            const std::size_t arena = arena_of(node);
+            if (releasable[arena]) {
+                *link = node->next;
+                --free_count_;
+                if (was_decommitted) {
+                    decommitted_bytes_ -= bytes;
+                    released_pages[arena] += bytes;
+                }
+                continue;
+            }
+            if (decommit && !was_decommitted && bytes > 0) {
+                Kernal::Memory::decommit_pages(begin, bytes);
+                node->decommitted = true;
+                decommitted_bytes_ += bytes;
+                track_deallocation(tag_, bytes);
+            }
+            link = &node->next;
+        }
+    }
+
+    if (any_releasable) {
+        std::size_t index = 0;
+        std::erase_if(arenas_, [&](Arena& arena) {
+            const std::size_t i = index++;
+            if (!releasable[i]) {
+                return false;
+            }
+            track_deallocation(tag_, arena.committed - released_pages[i]);
+            release_arena(arena);
+            return true;
+        });
+    }
 }
 
 void ChunkAllocator::create_arena() {
+    if (backend_ != PageBackend::Heap) {
+        // 只保留地址空间，物理页在 allocate_from_arena 中按需提交（新提交的页已清零）
+        void* memory = Kernal::Memory::reserve_pages(reserved_arena_size(), backend_);
+        if (!memory) {
+            return;  // 保留失败
+        }
+        std::size_t chunk_capacity = arena_size_ / aligned_chunk_size_;
+        arenas_.emplace_back(static_cast<std::byte*>(memory), arena_size_, chunk_capacity);
+        return;
+    }
+
     void* memory = aligned_alloc_impl(arena_size_, kDefaultAlignment);
     if (!memory) {
         return;  // 分配失败
@@ -234,32 +347,48 @@ void ChunkAllocator::create_arena() {
 
     std::size_t chunk_capacity = arena_size_ / aligned_chunk_size_;
     arenas_.emplace_back(static_cast<std::byte*>(memory), arena_size_, chunk_capacity);
+    arenas_.back().committed = arena_size_;
+    track_allocation(tag_, arena_size_);
 }
 
 void* ChunkAllocator::allocate_from_arena() {
+    auto carve = [this](Arena& arena) -> void* {
+        const std::size_t end = arena.offset + aligned_chunk_size_;
+        if (end > arena.committed) {
+            // 页后端：按步长提交，不超过保留范围
+            const std::size_t granularity = Kernal::Memory::page_granularity(backend_);
+            const std::size_t step = align_up(kMinCommitStep, granularity);
+            const std::size_t target =
+                std::min(align_up(std::max(end, arena.committed + step), granularity), reserved_arena_size());
+            if (!Kernal::Memory::commit_pages(arena.data + arena.committed, target - arena.committed)) {
+                return nullptr;
+            }
+            track_allocation(tag_, target - arena.committed);
+            arena.committed = target;
+        }
+        void* ptr = arena.data + arena.offset;
+        arena.offset = end;
+        ++arena.allocated;
+        return ptr;
+    };
+
     // 查找有空间的 Arena
     for (auto& arena : arenas_) {
         std::size_t remaining = arena.size - arena.offset;
         if (remaining >= aligned_chunk_size_) {
-            void* ptr = arena.data + arena.offset;
-            arena.offset += aligned_chunk_size_;
-            ++arena.allocated;
-            return ptr;
+            return carve(arena);
         }
     }
 
     // 没有可用空间，创建新 Arena
+    const std::size_t arena_count = arenas_.size();
     create_arena();
-    if (arenas_.empty()) {
+    if (arenas_.size() == arena_count) {
         return nullptr;  // Arena 创建失败
     }
 
     // 从新 Arena 分配
-    auto& arena = arenas_.back();
-    void* ptr = arena.data + arena.offset;
-    arena.offset += aligned_chunk_size_;
-    ++arena.allocated;
-    return ptr;
+    return carve(arenas_.back());
 }
 
 void* ChunkAllocator::pop_free_list() {
@@ -268,6 +397,15 @@ void* ChunkAllocator::pop_free_list() {
     }
 
     FreeNode* node = free_list_;
+    if (node->decommitted) {
+        // shrink 归还过物理页，使用前重新提交
+        const auto [begin, end] = decommit_range(node);
+        if (!Kernal::Memory::commit_pages(begin, static_cast<std::size_t>(end - begin))) {
+            return nullptr;
+        }
+        decommitted_bytes_ -= static_cast<std::size_t>(end - begin);
+        track_allocation(tag_, static_cast<std::size_t>(end - begin));
+    }
     free_list_ = node->next;
     --free_count_;
 
@@ -277,10 +415,47 @@ void* ChunkAllocator::pop_free_list() {
 void ChunkAllocator::push_free_list(void* ptr) {
     auto* node = static_cast<FreeNode*>(ptr);
     node->next = free_list_;
+    node->decommitted = false;
     free_list_ = node;
     ++free_count_;
 }
 
+void ChunkAllocator::release_arena(Arena& arena) {
+    if (backend_ != PageBackend::Heap) {
+        Kernal::Memory::release_pages(arena.data, reserved_arena_size());
+    } else {
+        aligned_free_impl(arena.data);
+    }
+    arena.data = nullptr;
+}
+
+void ChunkAllocator::release_all_arenas() {
+    track_deallocation(tag_, committed_memory_impl());
+    for (auto& arena : arenas_) {
+        release_arena(arena);
+    }
+    arenas_.clear();
+    free_list_ = nullptr;
+    allocated_count_ = 0;
+    free_count_ = 0;
+    decommitted_bytes_ = 0;
+}
+
+std::size_t ChunkAllocator::reserved_arena_size() const {
+    return align_up(arena_size_, Kernal::Memory::page_granularity(backend_));
+}
+
+std::pair<std::byte*, std::byte*> ChunkAllocator::decommit_range(void* chunk) const {
+    const std::size_t page = Kernal::Memory::system_page_size();
+    const auto address = reinterpret_cast<std::uintptr_t>(chunk);
+    const std::uintptr_t begin = align_up(address + sizeof(FreeNode), page);
+    const std::uintptr_t end = align_down(address + aligned_chunk_size_, page);
+    if (begin >= end) {
+        return {nullptr, nullptr};
+    }
+    return {reinterpret_cast<std::byte*>(begin), reinterpret_cast<std::byte*>(end)};
+}
+
 // 全局分配器（懒初始化）
 ChunkAllocator& get_global_chunk_allocator() {
     static ChunkAllocator instance(kDefaultChunkSize, ChunkAllocator::kDefaultArenaSize, true);
@@ -1,5 +1,6 @@
 #include "corona/kernel/ecs/entity_manager.h"
 
+#include <algorithm>
 #include <cassert>
 
 namespace Corona::Kernel::ECS {
@@ -8,7 +9,56 @@ EntityManager::EntityManager(std::size_t initial_capacity) {
     reserve(initial_capacity);
 }
 
+EntityManager::EntityManager(EntityManager&& other) noexcept
+    : records_(std::move(other.records_)),
+      free_list_(std::move(other.free_list_)),
+      alive_count_(other.alive_count_),
+      next_index_(other.next_index_.load(std::memory_order_relaxed)),
+      reservations_pending_(other.reservations_pending_.load(std::memory_order_relaxed)),
+      recycled_taken_(other.recycled_taken_),
+      returned_(std::move(other.returned_)),
+      accounted_end_(other.accounted_end_),
+      created_beyond_accounted_(other.created_beyond_accounted_) {
+    other.alive_count_ = 0;
+    other.next_index_.store(0, std::memory_order_relaxed);
+    other.reservations_pending_.store(false, std::memory_order_relaxed);
+    other.recycled_taken_ = 0;
+    other.accounted_end_ = 0;
+    other.created_beyond_accounted_ = 0;
+}
+
+EntityManager& EntityManager::operator=(EntityManager&& other) noexcept {
+    if (this != &other) {
+        records_ = std::move(other.records_);
+        free_list_ = std::move(other.free_list_);
+        alive_count_ = other.alive_count_;
+        next_index_.store(other.next_index_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        reservations_pending_.store(other.reservations_pending_.load(std::memory_order_relaxed),
+                                    std::memory_order_relaxed);
+        recycled_taken_ = other.recycled_taken_;
+        returned_ = std::move(other.returned_);
+        accounted_end_ = other.accounted_end_;
+        created_beyond_accounted_ = other.created_beyond_accounted_;
+
+        other.alive_count_ = 0;
+        other.next_index_.store(0, std::memory_order_relaxed);
+        other.reservations_pending_.store(false, std::memory_order_relaxed);
+        other.recycled_taken_ = 0;
+        other.accounted_end_ = 0;
+        other.created_beyond_accounted_ = 0;
+    }
+    return *this;
+}
+
 EntityId EntityManager::create() {
+    // 与工作线程的预留共享空闲列表、新索引计数器与记录数组，全程持有预留锁
+    std::lock_guard<std::mutex> lock(reserve_mutex_);
+
+    // 先为工作线程已预留的 ID 建立记录
+    if (has_pending_reservations()) {
+        materialize_reserved_locked();
+    }
+
     EntityId::IndexType index;
     EntityId::GenerationType generation;
 
@@ -21,13 +71,22 @@ EntityId EntityManager::create() {
         // 版本号已在 destroy 时递增
         generation = record.generation;
     } else {
-        // 分配新索引
-        index = static_cast<EntityId::IndexType>(records_.size());
-        records_.emplace_back();
+        // 分配新索引：与工作线程一样经由原子计数器划出，不会与进行中的预留冲突
+        const std::size_t fresh = next_index_.fetch_add(1, std::memory_order_seq_cst);
+        assert(fresh < EntityId::kInvalidIndex && "Entity index overflow");
+        index = static_cast<EntityId::IndexType>(fresh);
+
+        // 中间被工作线程预留的索引一并建立记录（初始版本号为 1，0 表示无效）
+        while (records_.size() <= fresh) {
+            records_.emplace_back().generation = 1;
+        }
+        generation = records_[index].generation;
 
-        auto& record = records_[index];
-        record.generation = 1;  // 初始版本号为 1（0 表示无效）
-        generation = record.generation;
+        if (fresh == accounted_end_) {
+            ++accounted_end_;
+        } else {
+            ++created_beyond_accounted_;  // 前面还有未 materialize 的预留，留待 materialize 时扣除
+        }
     }
 
     // 标记为已分配（archetype_id 将由外部设置）
@@ -42,6 +101,7 @@ bool EntityManager::destroy(EntityId id) {
         return false;
     }
 
+    std::lock_guard<std::mutex> lock(reserve_mutex_);
     auto& record = records_[id.index()];
 
     // 重置记录
@@ -112,7 +172,143 @@ EntityId EntityManager::find_entity_at(ArchetypeId archetype_id,
     return kInvalidEntity;
 }
 
+bool EntityManager::restore(EntityId id, ArchetypeId archetype_id,
+                            const EntityLocation& location) {
+    if (!id.is_valid()) {
+        return false;
+    }
+
+    if (has_pending_reservations()) {
+        materialize_reserved();
+    }
+
+    std::lock_guard<std::mutex> lock(reserve_mutex_);
+    const std::size_t index = id.index();
+    while (records_.size() <= index) {
+        // 中间新增的索引视为已销毁，放入空闲列表
+        free_list_.push_back(static_cast<EntityId::IndexType>(records_.size()));
+        records_.emplace_back().generation = 1;
+    }
+    if (next_index_.load(std::memory_order_relaxed) < records_.size()) {
+        next_index_.store(records_.size(), std::memory_order_relaxed);
+        accounted_end_ = records_.size();
+    }
+
+    auto& record = records_[index];
+    if (!record.is_alive()) {
+        // 原为空闲索引：移出空闲列表并计入存活
+        auto it = std::find(free_list_.begin(), free_list_.end(), id.index());
+        if (it != free_list_.end()) {
+            *it = free_list_.back();
+            free_list_.pop_back();
+        }
+        ++alive_count_;
+    }
+
+    record.generation = id.generation();
+    record.archetype_id = archetype_id;
+    record.location = location;
+    return true;
+}
+
+// 预留者总是先划出索引、再置位标志：materialize 在清除标志之后读取计数器，
+// 若未看到某次划出，则该预留者的置位必然晚于这次清除，留待下一次 materialize 处理
+
+EntityId EntityManager::reserve_id() {
+    {
+        std::lock_guard<std::mutex> lock(reserve_mutex_);
+        if (!free_list_.empty()) {
+            // 复用空闲索引（版本号已在 destroy 时递增）
+            auto index = free_list_.back();
+            free_list_.pop_back();
+            ++recycled_taken_;
+            reservations_pending_.store(true, std::memory_order_seq_cst);
+            return EntityId(index, records_[index].generation);
+        }
+    }
+
+    auto index = next_index_.fetch_add(1, std::memory_order_seq_cst);
+    assert(index < EntityId::kInvalidIndex && "Entity index overflow");
+    reservations_pending_.store(true, std::memory_order_seq_cst);
+    return EntityId(static_cast<EntityId::IndexType>(index), 1);
+}
+
+EntityManager::ReservedRange EntityManager::reserve_range(std::size_t count) {
+    auto first = next_index_.fetch_add(count, std::memory_order_seq_cst);
+    assert(first + count <= EntityId::kInvalidIndex && "Entity index overflow");
+    reservations_pending_.store(true, std::memory_order_seq_cst);
+    return ReservedRange{static_cast<EntityId::IndexType>(first), count};
+}
+
+void EntityManager::take_reserved(std::vector<EntityId>& out, std::size_t count) {
+    std::size_t taken = 0;
+    {
+        std::lock_guard<std::mutex> lock(reserve_mutex_);
+        while (taken < count && !free_list_.empty()) {
+            auto index = free_list_.back();
+            free_list_.pop_back();
+            out.push_back(EntityId(index, records_[index].generation));
+            ++taken;
+        }
+        if (taken > 0) {
+            recycled_taken_ += taken;
+            reservations_pending_.store(true, std::memory_order_seq_cst);
+        }
+    }
+
+    if (taken < count) {
+        // 空闲索引不足，原子地划出一段新索引
+        ReservedRange range = reserve_range(count - taken);
+        for (std::size_t i = 0; i < range.count; ++i) {
+            out.push_back(range[i]);
+        }
+    }
+}
+
+void EntityManager::return_reserved(std::span<const EntityId> ids) {
+    if (ids.empty()) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(reserve_mutex_);
+    returned_.insert(returned_.end(), ids.begin(), ids.end());
+    reservations_pending_.store(true, std::memory_order_seq_cst);  // 归还可能晚于上一次 materialize
+}
+
+void EntityManager::materialize_reserved() {
+    if (!has_pending_reservations()) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(reserve_mutex_);
+    materialize_reserved_locked();
+}
+
+void EntityManager::materialize_reserved_locked() {
+    // 先清除标志再读取计数器（均为 seq_cst）：此处未读到的新索引，其预留者的置位必然晚于清除
+    reservations_pending_.store(false, std::memory_order_seq_cst);
+
+    // 为新索引建立记录（create() 已为其分配的索引之前可能已建立部分记录）
+    const std::size_t fresh_end = next_index_.load(std::memory_order_seq_cst);
+    const std::size_t fresh_taken = fresh_end - accounted_end_ - created_beyond_accounted_;
+    records_.reserve(fresh_end);
+    while (records_.size() < fresh_end) {
+        records_.emplace_back().generation = 1;
+    }
+
+    // 未使用的预留 ID 回到空闲列表
+    for (EntityId id : returned_) {
+        free_list_.push_back(id.index());
+    }
+
+    alive_count_ += fresh_taken + recycled_taken_ - returned_.size();
+    returned_.clear();
+    recycled_taken_ = 0;
+    accounted_end_ = fresh_end;
+    created_beyond_accounted_ = 0;
+}
+
 void EntityManager::reserve(std::size_t capacity) {
+    std::lock_guard<std::mutex> lock(reserve_mutex_);
     if (capacity > records_.size()) {
         records_.reserve(capacity);
         free_list_.reserve(capacity);
@@ -120,7 +316,10 @@ void EntityManager::reserve(std::size_t capacity) {
 }
 
 void EntityManager::clear() {
+    materialize_reserved();
+
     // 保留容量但重置所有状态
+    std::lock_guard<std::mutex> lock(reserve_mutex_);
     for (auto& record : records_) {
         record.clear();
     }
@@ -144,4 +343,55 @@ bool EntityManager::is_valid_id(EntityId id) const {
     return true;
 }
 
+// ========================================
+// Reserver
+// ========================================
+
+EntityManager::Reserver::Reserver(EntityManager& manager, std::size_t batch_size)
+    : manager_(&manager), batch_size_(batch_size > 0 ? batch_size : 1) {
+    cache_.reserve(batch_size_);
+}
+
+EntityManager::Reserver::~Reserver() {
+    flush();
+}
+
+EntityId EntityManager::Reserver::reserve_id() {
+    if (cache_.empty()) {
+        refill();
+    }
+    EntityId id = cache_.back();
+    cache_.pop_back();
+    ++reserved_count_;
+    return id;
+}
+
+void EntityManager::Reserver::reserve_ids(std::span<EntityId> out) {
+    for (auto& id : out) {
+        id = reserve_id();
+    }
+}
+
+void EntityManager::Reserver::release(EntityId id) {
+    if (!id.is_valid()) {
+        return;
+    }
+    cache_.push_back(id);
+    if (reserved_count_ > 0) {
+        --reserved_count_;
+    }
+}
+
+void EntityManager::Reserver::flush() {
+    manager_->return_reserved(cache_);
+    cache_.clear();
+}
+
+void EntityManager::Reserver::refill() {
+    const auto old_size = cache_.size();
+    manager_->take_reserved(cache_, batch_size_);
+    // cache_ 从尾部弹出：翻转新取得的部分，使复用索引优先交付
+    std::reverse(cache_.begin() + static_cast<std::ptrdiff_t>(old_size), cache_.end());
+}
+
 }  // namespace Corona::Kernel::ECS
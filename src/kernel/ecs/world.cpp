@@ -10,7 +10,8 @@ World::World(World&& other) noexcept
     : entity_manager_(std::move(other.entity_manager_)),
       archetypes_(std::move(other.archetypes_)),
       archetype_by_id_(std::move(other.archetype_by_id_)),
-      next_archetype_id_(other.next_archetype_id_) {
+      next_archetype_id_(other.next_archetype_id_),
+      change_tick_(other.change_tick_) {
     other.next_archetype_id_ = 0;
 }
 
@@ -20,6 +21,7 @@ World& World::operator=(World&& other) noexcept {
         archetypes_ = std::move(other.archetypes_);
         archetype_by_id_ = std::move(other.archetype_by_id_);
         next_archetype_id_ = other.next_archetype_id_;
+        change_tick_ = other.change_tick_;
         other.next_archetype_id_ = 0;
     }
     return *this;
@@ -43,14 +45,7 @@ bool World::destroy_entity(EntityId entity) {
     if (record->archetype_id != kInvalidArchetypeId) {
         Archetype* archetype = get_archetype(record->archetype_id);
         if (archetype) {
-            ArchetypeId arch_id = record->archetype_id;
-            EntityLocation old_loc = record->location;
-            auto moved_from = archetype->deallocate_entity(old_loc);
-
-            // 处理 swap-and-pop 影响
-            if (moved_from.has_value()) {
-                handle_swap_and_pop(arch_id, *moved_from, old_loc);
-            }
+            release_slot(*archetype, record->location);
         }
     }
 
@@ -116,19 +111,15 @@ bool World::migrate_entity(EntityId entity, const ArchetypeSignature& new_signat
     }
 
     // 分配新槽位
-    EntityLocation new_location = target->allocate_entity();
+    EntityLocation new_location = target->allocate_entity(entity);
+    mark_structure_changed(*target, new_location);
 
     // 拷贝共有组件
     if (current) {
         copy_common_components(*current, record->location, *target, new_location);
 
         // 释放旧槽位
-        ArchetypeId arch_id = current->id();
-        EntityLocation old_loc = record->location;
-        auto moved_from = current->deallocate_entity(old_loc);
-        if (moved_from.has_value()) {
-            handle_swap_and_pop(arch_id, *moved_from, old_loc);
-        }
+        release_slot(*current, record->location);
     }
 
     // 更新记录
@@ -151,11 +142,29 @@ std::vector<Archetype*> World::find_archetypes_with(const ArchetypeSignature& re
 
 void World::handle_swap_and_pop(ArchetypeId archetype_id, const EntityLocation& from,
                                 const EntityLocation& to) {
-    // 查找被移动的实体（它原来在 from 位置，现在被移到了 to 位置）
-    EntityId moved_entity = entity_manager_.find_entity_at(archetype_id, from);
+    // 被移动的实体原来在 from 位置，现在被移到了 to 位置。
+    // Chunk 记录了行所属实体，优先 O(1) 读取；未记录时回退到线性查找
+    EntityId moved_entity = kInvalidEntity;
+    if (const Archetype* archetype = get_archetype(archetype_id)) {
+        moved_entity = archetype->entity_at(to);
+    }
+    if (!moved_entity.is_valid()) {
+        moved_entity = entity_manager_.find_entity_at(archetype_id, from);
+    }
     if (moved_entity.is_valid()) {
         entity_manager_.update_location(moved_entity, archetype_id, to);
     }
 }
 
+void World::release_slot(Archetype& archetype, const EntityLocation& location) {
+    // 拷贝一份：location 可能引用即将被更新的实体记录
+    EntityLocation old_loc = location;
+    mark_structure_changed(archetype, old_loc);
+
+    auto moved_from = archetype.deallocate_entity(old_loc);
+    if (moved_from.has_value()) {
+        handle_swap_and_pop(archetype.id(), *moved_from, old_loc);
+    }
+}
+
 }  // namespace Corona::Kernel::ECS
@@ -0,0 +1,333 @@
+#include "corona/kernel/ecs/world_delta.h"
+
+#include <cstring>
+#include <type_traits>
+
+namespace Corona::Kernel::ECS {
+
+namespace {
+
+/// Chunk 记录类型
+enum class ChunkOp : std::uint8_t {
+    Full = 0,     ///< 全量：行数 + 行实体 + 所有可复制列
+    Columns = 1,  ///< 仅变化的列（行数不变）
+};
+
+/// 追加写入的二进制写入器
+class StreamWriter {
+   public:
+    explicit StreamWriter(std::vector<std::byte>& out) : out_(out) {}
+
+    template <typename T>
+    void write(T value) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        write_bytes(&value, sizeof(T));
+    }
+
+    void write_bytes(const void* src, std::size_t size) {
+        if (size == 0) {
+            return;
+        }
+        const auto offset = out_.size();
+        out_.resize(offset + size);
+        std::memcpy(out_.data() + offset, src, size);
+    }
+
+    /// 预留一个 u32 占位，返回其偏移（稍后用 patch 回填）
+    [[nodiscard]] std::size_t reserve_u32() {
+        const auto offset = out_.size();
+        write<std::uint32_t>(0);
+        return offset;
+    }
+
+    void patch_u32(std::size_t offset, std::uint32_t value) {
+        std::memcpy(out_.data() + offset, &value, sizeof(value));
+    }
+
+    [[nodiscard]] std::size_t size() const { return out_.size(); }
+
+    void truncate(std::size_t size) { out_.resize(size); }
+
+   private:
+    std::vector<std::byte>& out_;
+};
+
+/// 带边界检查的二进制读取器
+class StreamReader {
+   public:
+    explicit StreamReader(std::span<const std::byte> data) : data_(data) {}
+
+    template <typename T>
+    bool read(T& value) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        return read_bytes(&value, sizeof(T));
+    }
+
+    bool read_bytes(void* dst, std::size_t size) {
+        if (size > data_.size() - pos_) {
+            return false;
+        }
+        if (size > 0) {
+            std::memcpy(dst, data_.data() + pos_, size);
+        }
+        pos_ += size;
+        return true;
+    }
+
+    [[nodiscard]] std::size_t remaining() const { return data_.size() - pos_; }
+
+   private:
+    std::span<const std::byte> data_;
+    std::size_t pos_ = 0;
+};
+
+/// 组件是否参与复制
+[[nodiscard]] bool is_replicated(const ComponentLayout& comp) {
+    return comp.type_info && comp.type_info->is_trivially_copyable;
+}
+
+/// 写出一列（SoA 组件按字段子列依次写出）
+void write_column(StreamWriter& writer, const Chunk& chunk, const ComponentLayout& comp) {
+    const std::byte* base = chunk.data();
+    if (comp.is_split()) {
+        for (const auto& field : comp.fields) {
+            writer.write_bytes(base + field.array_offset, field.size * chunk.size());
+        }
+    } else {
+        writer.write_bytes(base + comp.array_offset, comp.size * chunk.size());
+    }
+}
+
+/// 读入一列到 Chunk（行数必须已就绪）
+bool read_column(StreamReader& reader, Chunk& chunk, const ComponentLayout& comp) {
+    std::byte* base = chunk.data();
+    if (comp.is_split()) {
+        for (const auto& field : comp.fields) {
+            if (!reader.read_bytes(base + field.array_offset, field.size * chunk.size())) {
+                return false;
+            }
+        }
+        return true;
+    }
+    return reader.read_bytes(base + comp.array_offset, comp.size * chunk.size());
+}
+
+/// 被全量记录覆盖的旧行
+struct DisplacedRow {
+    EntityId entity;
+    ArchetypeId archetype_id;
+    EntityLocation location;
+};
+
+}  // namespace
+
+std::size_t WorldDelta::encode(const World& world, ChangeTick baseline,
+                               std::vector<std::byte>& out) {
+    StreamWriter writer(out);
+    writer.write<std::uint32_t>(kMagic);
+    writer.write<std::uint16_t>(kVersion);
+    writer.write<std::uint16_t>(0);
+    writer.write<std::uint32_t>(baseline);
+    writer.write<std::uint32_t>(world.change_tick());
+    const auto archetype_count_pos = writer.reserve_u32();
+
+    std::uint32_t archetype_count = 0;
+    std::size_t record_total = 0;
+
+    for (const auto& [hash, archetype] : world.archetypes_) {
+        const auto& layout = archetype->layout();
+        const auto archetype_begin = writer.size();
+
+        writer.write<std::uint32_t>(static_cast<std::uint32_t>(layout.components.size()));
+        for (const auto& comp : layout.components) {
+            writer.write<std::uint64_t>(static_cast<std::uint64_t>(comp.type_id));
+            writer.write<std::uint32_t>(static_cast<std::uint32_t>(comp.size));
+            writer.write<std::uint8_t>(is_replicated(comp) ? 1 : 0);
+        }
+        writer.write<std::uint32_t>(static_cast<std::uint32_t>(archetype->chunk_count()));
+        const auto record_count_pos = writer.reserve_u32();
+
+        std::uint32_t record_count = 0;
+        for (std::size_t chunk_idx = 0; chunk_idx < archetype->chunk_count(); ++chunk_idx) {
+            const Chunk& chunk = archetype->get_chunk(chunk_idx);
+            const bool structural = chunk.structure_version() > baseline;
+
+            std::uint32_t changed_columns = 0;
+            for (std::size_t col = 0; col < layout.components.size(); ++col) {
+                if (is_replicated(layout.components[col]) &&
+                    (structural || chunk.column_version(col) > baseline)) {
+                    ++changed_columns;
+                }
+            }
+            if (!structural && changed_columns == 0) {
+                continue;
+            }
+
+            writer.write<std::uint32_t>(static_cast<std::uint32_t>(chunk_idx));
+            writer.write<std::uint8_t>(static_cast<std::uint8_t>(structural ? ChunkOp::Full : ChunkOp::Columns));
+            writer.write<std::uint32_t>(static_cast<std::uint32_t>(chunk.size()));
+            if (structural) {
+                for (EntityId entity : chunk.entities()) {
+                    writer.write<std::uint64_t>(entity.raw());
+                }
+            }
+
+            writer.write<std::uint32_t>(changed_columns);
+            for (std::size_t col = 0; col < layout.components.size(); ++col) {
+                const auto& comp = layout.components[col];
+                if (is_replicated(comp) && (structural || chunk.column_version(col) > baseline)) {
+                    writer.write<std::uint32_t>(static_cast<std::uint32_t>(col));
+                    write_column(writer, chunk, comp);
+                }
+            }
+            ++record_count;
+        }
+
+        if (record_count == 0) {
+            // 该 Archetype 没有变化，撤销已写出的头部
+            writer.truncate(archetype_begin);
+            continue;
+        }
+
+        writer.patch_u32(record_count_pos, record_count);
+        ++archetype_count;
+        record_total += record_count;
+    }
+
+    writer.patch_u32(archetype_count_pos, archetype_count);
+    return record_total;
+}
+
+bool WorldDelta::apply(World& world, std::span<const std::byte> data) {
+    StreamReader reader(data);
+
+    std::uint32_t magic = 0;
+    std::uint16_t version = 0;
+    std::uint16_t reserved = 0;
+    std::uint32_t baseline = 0;
+    std::uint32_t tick = 0;
+    std::uint32_t archetype_count = 0;
+    if (!reader.read(magic) || !reader.read(version) || !reader.read(reserved) ||
+        !reader.read(baseline) || !reader.read(tick) || !reader.read(archetype_count)) {
+        return false;
+    }
+    if (magic != kMagic || version != kVersion) {
+        return false;
+    }
+
+    auto& entities = world.entity_manager_;
+    std::vector<DisplacedRow> displaced;
+
+    for (std::uint32_t a = 0; a < archetype_count; ++a) {
+        // 读取组件列表并重建签名
+        std::uint32_t component_count = 0;
+        if (!reader.read(component_count)) {
+            return false;
+        }
+
+        ArchetypeSignature signature;
+        std::vector<ComponentTypeId> source_columns;
+        source_columns.reserve(component_count);
+        for (std::uint32_t c = 0; c < component_count; ++c) {
+            std::uint64_t type_id = 0;
+            std::uint32_t size = 0;
+            std::uint8_t replicated = 0;
+            if (!reader.read(type_id) || !reader.read(size) || !reader.read(replicated)) {
+                return false;
+            }
+            const auto* info = ComponentRegistry::instance().get_type_info(static_cast<ComponentTypeId>(type_id));
+            if (!info || info->size != size) {
+                return false;  // 组件类型未注册或布局不一致
+            }
+            signature.add(info->id);
+            source_columns.push_back(info->id);
+        }
+
+        std::uint32_t chunk_count = 0;
+        std::uint32_t record_count = 0;
+        if (!reader.read(chunk_count) || !reader.read(record_count)) {
+            return false;
+        }
+
+        Archetype* archetype = world.get_or_create_archetype(signature);
+        if (!archetype) {
+            return false;
+        }
+        archetype->ensure_chunk_count(chunk_count);
+        const auto& layout = archetype->layout();
+
+        for (std::uint32_t r = 0; r < record_count; ++r) {
+            std::uint32_t chunk_idx = 0;
+            std::uint8_t op = 0;
+            std::uint32_t rows = 0;
+            if (!reader.read(chunk_idx) || !reader.read(op) || !reader.read(rows)) {
+                return false;
+            }
+            if (chunk_idx >= archetype->chunk_count() || op > static_cast<std::uint8_t>(ChunkOp::Columns)) {
+                return false;
+            }
+
+            Chunk& chunk = archetype->get_chunk(chunk_idx);
+            if (rows > chunk.capacity()) {
+                return false;
+            }
+
+            if (op == static_cast<std::uint8_t>(ChunkOp::Full)) {
+                if (reader.remaining() / sizeof(std::uint64_t) < rows) {
+                    return false;
+                }
+
+                // 记录被覆盖的旧行，全部记录应用完后再清理未重新出现的实体
+                for (std::size_t i = 0; i < chunk.size(); ++i) {
+                    displaced.push_back({chunk.entity_at(i), archetype->id(), EntityLocation{chunk_idx, i}});
+                }
+
+                chunk.resize(rows);
+                for (std::uint32_t i = 0; i < rows; ++i) {
+                    std::uint64_t raw = 0;
+                    reader.read(raw);
+                    EntityId entity = EntityId::from_raw(raw);
+                    EntityLocation location{chunk_idx, i};
+                    if (!entities.restore(entity, archetype->id(), location)) {
+                        return false;
+                    }
+                    chunk.set_entity(i, entity);
+                }
+                chunk.mark_structure_changed(world.change_tick_);
+            } else if (rows != chunk.size()) {
+                return false;  // 列记录要求行数与副本一致
+            }
+
+            std::uint32_t column_count = 0;
+            if (!reader.read(column_count)) {
+                return false;
+            }
+            for (std::uint32_t c = 0; c < column_count; ++c) {
+                std::uint32_t source_col = 0;
+                if (!reader.read(source_col) || source_col >= source_columns.size()) {
+                    return false;
+                }
+                auto column = layout.component_index(source_columns[source_col]);
+                if (column < 0 || !read_column(reader, chunk, layout.components[column])) {
+                    return false;
+                }
+                chunk.mark_column_changed(static_cast<std::size_t>(column), world.change_tick_);
+            }
+        }
+    }
+
+    // 被覆盖且没有在其他位置重新出现的实体视为已销毁
+    for (const auto& row : displaced) {
+        const auto* record = entities.get_record(row.entity);
+        if (record && record->archetype_id == row.archetype_id && record->location == row.location) {
+            Archetype* archetype = world.get_archetype(row.archetype_id);
+            if (!archetype || archetype->entity_at(row.location) != row.entity) {
+                entities.destroy(row.entity);
+            }
+        }
+    }
+
+    return true;
+}
+
+}  // namespace Corona::Kernel::ECS
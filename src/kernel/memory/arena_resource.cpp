@@ -0,0 +1,35 @@
+#include "corona/kernel/memory/arena_resource.h"
+
+namespace Corona::Kernal::Memory {
+
+void* ArenaResource::do_allocate(std::size_t bytes, std::size_t alignment) {
+    // LinearArena 拒绝 0 字节请求，pmr 要求返回有效指针
+    void* ptr = arena_->allocate(bytes > 0 ? bytes : 1, alignment);
+    if (!ptr) {
+        ptr = upstream_->allocate(bytes, alignment);
+    }
+    return ptr;
+}
+
+void ArenaResource::do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment) {
+    if (!arena_->owns(ptr)) {
+        upstream_->deallocate(ptr, bytes, alignment);
+    }
+}
+
+void* FrameArenaResource::do_allocate(std::size_t bytes, std::size_t alignment) {
+    void* ptr = arena_->allocate(bytes > 0 ? bytes : 1, alignment);
+    if (!ptr) {
+        ptr = upstream_->allocate(bytes, alignment);
+    }
+    return ptr;
+}
+
+void FrameArenaResource::do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment) {
+    // 帧缓冲区内的内存由 begin_frame() 整体回收
+    if (!arena_->owns(ptr)) {
+        upstream_->deallocate(ptr, bytes, alignment);
+    }
+}
+
+}  // namespace Corona::Kernal::Memory
@@ -0,0 +1,217 @@
+#include "corona/kernel/memory/epoch_manager.h"
+
+#include <algorithm>
+#include <cassert>
+#include <thread>
+
+namespace Corona::Kernal::Memory {
+
+namespace {
+
+/// 本线程的注册是否已注销（平凡类型，其他线程本地对象析构时仍可安全读取）
+thread_local bool t_registration_destroyed = false;
+
+}  // namespace
+
+// ============================================================================
+// ThreadRegistration
+// ============================================================================
+
+/// 线程本地状态：首次使用时取得参与者记录，线程退出时归还记录并把待回收对象移入孤儿列表
+class EpochManager::ThreadRegistration {
+   public:
+    explicit ThreadRegistration(EpochManager& manager)
+        : manager_(manager), participant_(manager.acquire_participant()) {}
+
+    ~ThreadRegistration() {
+        manager_.collect();
+        manager_.adopt(retired_);
+        participant_->in_use.store(false, std::memory_order_release);
+        t_registration_destroyed = true;
+    }
+
+    ThreadRegistration(const ThreadRegistration&) = delete;
+    ThreadRegistration& operator=(const ThreadRegistration&) = delete;
+
+    [[nodiscard]] Participant* participant() noexcept { return participant_; }
+    [[nodiscard]] std::vector<Retired>& retired() noexcept { return retired_; }
+
+   private:
+    EpochManager& manager_;
+    Participant* participant_;
+    std::vector<Retired> retired_;
+};
+
+// ============================================================================
+// Guard
+// ============================================================================
+
+void EpochManager::Guard::release() noexcept {
+    if (!participant_) {
+        return;
+    }
+    assert(participant_->owner == std::this_thread::get_id() &&
+           "EpochManager::Guard must be destroyed on the thread that pinned it");
+    if (--participant_->depth == 0) {
+        participant_->epoch.store(kQuiescent, std::memory_order_release);
+        if (owned_) {
+            participant_->in_use.store(false, std::memory_order_release);
+        }
+    }
+    participant_ = nullptr;
+}
+
+// ============================================================================
+// EpochManager
+// ============================================================================
+
+EpochManager& EpochManager::instance() {
+    // 有意泄漏：线程本地状态可能在静态对象析构之后才注销
+    static EpochManager* manager = new EpochManager();
+    return *manager;
+}
+
+EpochManager::ThreadRegistration* EpochManager::local() {
+    if (t_registration_destroyed) {
+        return nullptr;  // 线程退出阶段（其他线程本地对象的析构函数中）
+    }
+    thread_local ThreadRegistration registration(*this);
+    return &registration;
+}
+
+EpochManager::Participant* EpochManager::acquire_participant() {
+    for (Participant* p = participants_.load(std::memory_order_acquire); p; p = p->next) {
+        bool expected = false;
+        if (!p->in_use.load(std::memory_order_relaxed) &&
+            p->in_use.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+            return p;
+        }
+    }
+
+    auto* participant = new Participant();
+    participant->in_use.store(true, std::memory_order_relaxed);
+    Participant* head = participants_.load(std::memory_order_relaxed);
+    do {
+        participant->next = head;
+    } while (!participants_.compare_exchange_weak(head, participant, std::memory_order_release,
+                                                  std::memory_order_relaxed));
+    return participant;
+}
+
+EpochManager::Guard EpochManager::pin() {
+    bool owned = false;
+    Participant* participant = nullptr;
+    if (ThreadRegistration* registration = local()) {
+        participant = registration->participant();
+    } else {
+        participant = acquire_participant();
+        owned = true;
+    }
+
+    if (participant->depth++ == 0) {
+        participant->owner = std::this_thread::get_id();
+        // 写入纪元与之后读取共享数据之间需要 StoreLoad 屏障，否则推进者可能看不到本线程已进入临界区
+        participant->epoch.store(global_epoch_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+    return Guard(participant, owned);
+}
+
+void EpochManager::retire(void* ptr, void (*deleter)(void*)) {
+    if (!ptr) {
+        return;
+    }
+    // 对象在 retire 之前已被摘下，此处读取的纪元不早于任何可能仍持有它的读者所在的纪元
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const Retired retired{ptr, deleter, global_epoch_.load(std::memory_order_relaxed)};
+
+    ThreadRegistration* registration = local();
+    if (!registration) {
+        std::vector<Retired> list{retired};
+        adopt(list);
+        return;
+    }
+
+    registration->retired().push_back(retired);
+    if (registration->retired().size() >= kCollectThreshold) {
+        collect();
+    }
+}
+
+std::size_t EpochManager::collect() {
+    try_advance();
+    const std::uint64_t epoch = global_epoch_.load(std::memory_order_acquire);
+
+    std::size_t freed = 0;
+    if (ThreadRegistration* registration = local()) {
+        freed += reclaim(registration->retired(), epoch);
+    }
+
+    if (orphan_count_.load(std::memory_order_relaxed) > 0) {
+        std::vector<Retired> orphans;
+        {
+            std::unique_lock lock(orphan_mutex_, std::try_to_lock);
+            if (lock.owns_lock()) {
+                orphans.swap(orphans_);
+                orphan_count_.store(0, std::memory_order_relaxed);
+            }
+        }
+        // 在锁外删除：删除函数可能再次 retire
+        freed += reclaim(orphans, epoch);
+        adopt(orphans);
+    }
+    return freed;
+}
+
+void EpochManager::synchronize() {
+    const std::uint64_t target = global_epoch_.load(std::memory_order_acquire) + 2;
+    while (global_epoch_.load(std::memory_order_acquire) < target) {
+        if (!try_advance()) {
+            std::this_thread::yield();
+        }
+    }
+    collect();
+}
+
+std::size_t EpochManager::pending() {
+    ThreadRegistration* registration = local();
+    return registration ? registration->retired().size() : 0;
+}
+
+bool EpochManager::try_advance() {
+    std::uint64_t epoch = global_epoch_.load(std::memory_order_seq_cst);
+    for (Participant* p = participants_.load(std::memory_order_acquire); p; p = p->next) {
+        const std::uint64_t observed = p->epoch.load(std::memory_order_seq_cst);
+        if (observed != kQuiescent && observed != epoch) {
+            return false;  // 仍有读者停留在上一个纪元
+        }
+    }
+    // CAS 失败说明其他线程已推进，同样视为成功
+    global_epoch_.compare_exchange_strong(epoch, epoch + 1, std::memory_order_acq_rel);
+    return true;
+}
+
+std::size_t EpochManager::reclaim(std::vector<Retired>& list, std::uint64_t epoch) {
+    // 孤儿列表合并自多个线程，不保证按纪元排序
+    const auto end = std::stable_partition(list.begin(), list.end(),
+                                           [epoch](const Retired& retired) { return retired.epoch + 2 <= epoch; });
+    std::vector<Retired> expired(list.begin(), end);
+    list.erase(list.begin(), end);
+    // 先移出再删除：删除函数可能再次 retire
+    for (const Retired& retired : expired) {
+        retired.deleter(retired.ptr);
+    }
+    return expired.size();
+}
+
+void EpochManager::adopt(std::vector<Retired>& list) {
+    if (list.empty()) {
+        return;
+    }
+    std::lock_guard lock(orphan_mutex_);
+    orphans_.insert(orphans_.end(), list.begin(), list.end());
+    orphan_count_.store(orphans_.size(), std::memory_order_relaxed);
+    list.clear();
+}
+
+}  // namespace Corona::Kernal::Memory
@@ -3,10 +3,97 @@
 #include <algorithm>
 #include <cassert>
 #include <cstring>
+#include <functional>
+#include <memory>
+#include <vector>
 
 namespace Corona::Kernal::Memory {
 
+// ============================================================================
+// 线程本地弹匣
+// ============================================================================
+
+/// 单个线程在单个池上的私有空闲块缓存
+struct FixedPool::Magazine {
+    std::atomic<FixedPool*> pool{nullptr};       ///< 所属池（池析构/移动后置空）
+    FreeBlock* head = nullptr;                   ///< 本地空闲链表（仅拥有者线程访问）
+    std::atomic<std::size_t> count{0};           ///< 本地空闲块数（供统计读取）
+    std::atomic<std::size_t> allocations{0};     ///< 本地分配次数（未并入池统计的部分）
+    std::atomic<std::size_t> deallocations{0};   ///< 本地释放次数（未并入池统计的部分）
+    Magazine* next = nullptr;                    ///< 池内登记链表（受池 mutex_ 保护）
+
+    void push(FreeBlock* block) noexcept {
+        block->next = head;
+        head = block;
+        count.store(count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] FreeBlock* pop() noexcept {
+        FreeBlock* block = head;
+        if (block) {
+            head = block->next;
+            count.store(count.load(std::memory_order_relaxed) - 1, std::memory_order_relaxed);
+        }
+        return block;
+    }
+};
+
+namespace {
+
+/// 保护池与弹匣之间的登记关系（线程退出与池析构可能并发）
+std::mutex& magazine_registry_mutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+
+/// 仅拥有者线程写入的计数器自增
+void bump(std::atomic<std::size_t>& counter) noexcept {
+    counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+}  // namespace
+
+/// 线程持有的所有弹匣，线程退出时归还
+struct FixedPool::ThreadCache {
+    std::vector<std::unique_ptr<Magazine>> magazines;
+    Magazine* last = nullptr;  ///< 最近使用的弹匣（快速路径）
+
+    ~ThreadCache() {
+        std::lock_guard<std::mutex> registry_lock(magazine_registry_mutex());
+        for (auto& magazine : magazines) {
+            FixedPool* pool = magazine->pool.load(std::memory_order_acquire);
+            if (!pool) {
+                continue;
+            }
+
+            std::lock_guard<std::mutex> lock(pool->mutex_);
+            // 从池的登记链表移除
+            for (Magazine** pp = &pool->magazines_; *pp; pp = &(*pp)->next) {
+                if (*pp == magazine.get()) {
+                    *pp = magazine->next;
+                    break;
+                }
+            }
+            // 归还缓存块并合并统计
+            while (FreeBlock* block = magazine->pop()) {
+                block->next = pool->free_list_;
+                pool->free_list_ = block;
+                ++pool->free_blocks_;
+            }
+            pool->allocation_count_ += magazine->allocations.load(std::memory_order_relaxed);
+            pool->deallocation_count_ += magazine->deallocations.load(std::memory_order_relaxed);
+            magazine->pool.store(nullptr, std::memory_order_release);
+        }
+    }
+};
+
 FixedPool::FixedPool(const PoolConfig& config) : config_(config) {
+    // 无锁模式：空闲块内嵌 LockFreeNode，且本身即线程安全
+    if (config_.lock_free) {
+        config_.thread_safe = true;
+        config_.block_alignment = std::max(config_.block_alignment, alignof(LockFreeNode));
+    }
+
     // 确保块大小至少能容纳一个指针（用于空闲链表）
     if (config_.block_size < sizeof(FreeBlock)) {
         config_.block_size = sizeof(FreeBlock);
@@ -15,6 +102,11 @@ FixedPool::FixedPool(const PoolConfig& config) : config_(config) {
     // 确保块大小对齐
     config_.block_size = align_up(config_.block_size, config_.block_alignment);
 
+    // 平台不支持页后端时退回堆分配
+    if (config_.backend != PageBackend::Heap && !virtual_memory_supported()) {
+        config_.backend = PageBackend::Heap;
+    }
+
     // 预分配初始 Chunks
     for (std::size_t i = 0; i < config_.initial_chunks; ++i) {
         ChunkHeader* chunk = allocate_chunk();
@@ -24,48 +116,76 @@ FixedPool::FixedPool(const PoolConfig& config) : config_(config) {
     }
 }
 
-FixedPool::FixedPool(FixedPool&& other) noexcept
-    : config_(other.config_),
-      first_chunk_(other.first_chunk_),
-      free_list_(other.free_list_),
-      total_blocks_(other.total_blocks_),
-      free_blocks_(other.free_blocks_),
-      chunk_count_(other.chunk_count_),
-      allocation_count_(other.allocation_count_),
-      deallocation_count_(other.deallocation_count_),
-      peak_used_blocks_(other.peak_used_blocks_) {
+FixedPool::FixedPool(FixedPool&& other) noexcept : config_(other.config_) {
+    // 弹匣登记的是旧地址：先把缓存块收回共享链表再转移
+    other.detach_magazines(true);
+    if (config_.lock_free) {
+        other.drain_lock_free_list();
+    }
+
+    first_chunk_ = other.first_chunk_;
+    free_list_ = other.free_list_;
+    chunk_index_ = std::move(other.chunk_index_);
+    total_blocks_ = other.total_blocks_;
+    free_blocks_ = other.free_blocks_;
+    chunk_count_ = other.chunk_count_;
+    allocation_count_ = other.allocation_count_;
+    deallocation_count_ = other.deallocation_count_;
+    peak_used_blocks_ = other.peak_used_blocks_;
+    lock_free_allocations_.store(other.lock_free_allocations_.exchange(0), std::memory_order_relaxed);
+    lock_free_deallocations_.store(other.lock_free_deallocations_.exchange(0), std::memory_order_relaxed);
+    lock_free_peak_.store(other.lock_free_peak_.exchange(0), std::memory_order_relaxed);
+
     other.first_chunk_ = nullptr;
     other.free_list_ = nullptr;
+    other.chunk_index_.clear();
     other.total_blocks_ = 0;
     other.free_blocks_ = 0;
     other.chunk_count_ = 0;
     other.allocation_count_ = 0;
     other.deallocation_count_ = 0;
     other.peak_used_blocks_ = 0;
+
+    if (config_.lock_free) {
+        refill_lock_free_list();
+    }
 }
 
 FixedPool& FixedPool::operator=(FixedPool&& other) noexcept {
     if (this != &other) {
         clear();
+        other.detach_magazines(true);
+        if (other.config_.lock_free) {
+            other.drain_lock_free_list();
+        }
 
         config_ = other.config_;
         first_chunk_ = other.first_chunk_;
         free_list_ = other.free_list_;
+        chunk_index_ = std::move(other.chunk_index_);
         total_blocks_ = other.total_blocks_;
         free_blocks_ = other.free_blocks_;
         chunk_count_ = other.chunk_count_;
         allocation_count_ = other.allocation_count_;
         deallocation_count_ = other.deallocation_count_;
         peak_used_blocks_ = other.peak_used_blocks_;
+        lock_free_allocations_.store(other.lock_free_allocations_.exchange(0), std::memory_order_relaxed);
+        lock_free_deallocations_.store(other.lock_free_deallocations_.exchange(0), std::memory_order_relaxed);
+        lock_free_peak_.store(other.lock_free_peak_.exchange(0), std::memory_order_relaxed);
 
         other.first_chunk_ = nullptr;
         other.free_list_ = nullptr;
+        other.chunk_index_.clear();
         other.total_blocks_ = 0;
         other.free_blocks_ = 0;
         other.chunk_count_ = 0;
         other.allocation_count_ = 0;
         other.deallocation_count_ = 0;
         other.peak_used_blocks_ = 0;
+
+        if (config_.lock_free) {
+            refill_lock_free_list();
+        }
     }
     return *this;
 }
@@ -73,6 +193,23 @@ FixedPool& FixedPool::operator=(FixedPool&& other) noexcept {
 FixedPool::~FixedPool() { clear(); }
 
 void* FixedPool::allocate() {
+    if (config_.lock_free) {
+        return allocate_lock_free();
+    }
+
+    if (uses_magazines()) {
+        // 快速路径：只访问本线程弹匣
+        Magazine* magazine = local_magazine();
+        if (!magazine->head) {
+            refill_magazine(magazine);
+        }
+        FreeBlock* block = magazine->pop();
+        if (block) {
+            bump(magazine->allocations);
+        }
+        return block;
+    }
+
     if (config_.thread_safe) {
         std::lock_guard<std::mutex> lock(mutex_);
         return allocate_impl();
@@ -128,6 +265,28 @@ void FixedPool::deallocate(void* ptr) noexcept {
         return;
     }
 
+    if (config_.lock_free) {
+        deallocate_lock_free(ptr);
+        return;
+    }
+
+    if (uses_magazines()) {
+#if defined(_DEBUG) || defined(CFW_ENABLE_MEMORY_DEBUG)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            assert(find_chunk(ptr) && "Attempting to deallocate pointer not from this pool");
+        }
+#endif
+        Magazine* magazine = local_magazine();
+        if (magazine->count.load(std::memory_order_relaxed) >= 2 * config_.magazine_size) {
+            // 弹匣满：批量归还一半，保留余量避免在边界处反复加锁
+            flush_magazine(magazine, config_.magazine_size);
+        }
+        magazine->push(static_cast<FreeBlock*>(ptr));
+        bump(magazine->deallocations);
+        return;
+    }
+
     if (config_.thread_safe) {
         std::lock_guard<std::mutex> lock(mutex_);
         deallocate_impl(ptr);
@@ -155,11 +314,12 @@ void FixedPool::deallocate_impl(void* ptr) noexcept {
 }
 
 void FixedPool::reset() noexcept {
-    if (config_.thread_safe) {
-        std::lock_guard<std::mutex> lock(mutex_);
-    }
+    // 所有块都将重新进入空闲链表，弹匣中的缓存直接丢弃
+    detach_magazines(false);
+    auto lock = lock_if_thread_safe();
 
     // 重新初始化所有 Chunk 的空闲链表
+    lock_free_list_.clear();
     free_list_ = nullptr;
     free_blocks_ = 0;
 
@@ -168,60 +328,88 @@ void FixedPool::reset() noexcept {
         initialize_free_list(chunk);
         chunk = chunk->next_chunk;
     }
+    if (config_.lock_free) {
+        refill_lock_free_list();
+    }
 
     allocation_count_ = 0;
     deallocation_count_ = 0;
+    lock_free_allocations_.store(0, std::memory_order_relaxed);
+    lock_free_deallocations_.store(0, std::memory_order_relaxed);
 }
 
 void FixedPool::shrink_to_fit() {
-    if (config_.thread_safe) {
-        std::lock_guard<std::mutex> lock(mutex_);
+    flush_thread_cache();
+    auto lock = lock_if_thread_safe();
+
+    if (config_.lock_free) {
+        // 先将空闲块移入 free_list_，按常规路径回收后再压回无锁栈
+        drain_lock_free_list();
+        release_empty_chunks_locked();
+        refill_lock_free_list();
+        return;
     }
+    release_empty_chunks_locked();
+}
 
-    // 找出完全空闲的 Chunk 并释放
-    ChunkHeader* prev = nullptr;
-    ChunkHeader* chunk = first_chunk_;
-
-    while (chunk) {
-        ChunkHeader* next = chunk->next_chunk;
+void FixedPool::release_empty_chunks_locked() {
+    if (chunk_index_.empty()) {
+        return;
+    }
 
-        // 检查 Chunk 是否完全空闲
-        if (chunk->free_count == chunk->block_count) {
-            // 从空闲链表中移除该 Chunk 的所有块
-            FreeBlock** pp = &free_list_;
-            while (*pp) {
-                auto* block_ptr = reinterpret_cast<std::byte*>(*pp);
-                if (chunk->contains(block_ptr)) {
-                    *pp = (*pp)->next;
-                    --free_blocks_;
-                } else {
-                    pp = &(*pp)->next;
-                }
-            }
+    // 第一遍：统计每个 Chunk 的空闲块数
+    std::vector<std::size_t> free_counts(chunk_index_.size(), 0);
+    for (FreeBlock* block = free_list_; block; block = block->next) {
+        const std::size_t slot = chunk_slot(block);
+        assert(slot < chunk_index_.size() && "Free block not owned by any chunk");
+        ++free_counts[slot];
+    }
 
-            // 从 Chunk 链表中移除
-            if (prev) {
-                prev->next_chunk = next;
-            } else {
-                first_chunk_ = next;
-            }
+    bool any_empty = false;
+    for (std::size_t i = 0; i < chunk_index_.size(); ++i) {
+        chunk_index_[i]->free_count = free_counts[i];
+        any_empty = any_empty || free_counts[i] == chunk_index_[i]->block_count;
+    }
+    if (!any_empty) {
+        return;
+    }
 
+    // 第二遍：重建空闲链表，跳过将被释放的 Chunk 中的块（保持原有顺序）
+    FreeBlock* head = nullptr;
+    FreeBlock** tail = &head;
+    for (FreeBlock* block = free_list_; block;) {
+        FreeBlock* next = block->next;
+        const ChunkHeader* owner = chunk_index_[chunk_slot(block)];
+        if (owner->free_count == owner->block_count) {
+            --free_blocks_;
+        } else {
+            *tail = block;
+            tail = &block->next;
+        }
+        block = next;
+    }
+    *tail = nullptr;
+    free_list_ = head;
+
+    // 从地址索引和 Chunk 链表中移除并释放完全空闲的 Chunk
+    std::erase_if(chunk_index_, [](const ChunkHeader* chunk) { return chunk->free_count == chunk->block_count; });
+    ChunkHeader** pp = &first_chunk_;
+    while (*pp) {
+        ChunkHeader* chunk = *pp;
+        if (chunk->free_count == chunk->block_count) {
+            *pp = chunk->next_chunk;
             total_blocks_ -= chunk->block_count;
             --chunk_count_;
-
             free_chunk(chunk);
         } else {
-            prev = chunk;
+            pp = &chunk->next_chunk;
         }
-
-        chunk = next;
     }
 }
 
 void FixedPool::clear() noexcept {
-    if (config_.thread_safe) {
-        std::lock_guard<std::mutex> lock(mutex_);
-    }
+    detach_magazines(false);
+    auto lock = lock_if_thread_safe();
 
     // 释放所有 Chunk
     ChunkHeader* chunk = first_chunk_;
@@ -233,72 +421,310 @@ void FixedPool::clear() noexcept {
 
     first_chunk_ = nullptr;
     free_list_ = nullptr;
+    lock_free_list_.clear();
+    chunk_index_.clear();
     total_blocks_ = 0;
     free_blocks_ = 0;
     chunk_count_ = 0;
     allocation_count_ = 0;
     deallocation_count_ = 0;
     peak_used_blocks_ = 0;
+    lock_free_allocations_.store(0, std::memory_order_relaxed);
+    lock_free_deallocations_.store(0, std::memory_order_relaxed);
+    lock_free_peak_.store(0, std::memory_order_relaxed);
 }
 
 std::size_t FixedPool::total_blocks() const noexcept {
-    if (config_.thread_safe) {
-        std::lock_guard<std::mutex> lock(mutex_);
-    }
+    auto lock = lock_if_thread_safe();
     return total_blocks_;
 }
 
 std::size_t FixedPool::free_blocks() const noexcept {
-    if (config_.thread_safe) {
-        std::lock_guard<std::mutex> lock(mutex_);
+    auto lock = lock_if_thread_safe();
+    if (config_.lock_free) {
+        return total_blocks_ - std::min(total_blocks_, lock_free_used_blocks());
     }
-    return free_blocks_;
+    return free_blocks_ + cached_blocks_locked();
 }
 
 std::size_t FixedPool::used_blocks() const noexcept {
-    if (config_.thread_safe) {
-        std::lock_guard<std::mutex> lock(mutex_);
+    auto lock = lock_if_thread_safe();
+    if (config_.lock_free) {
+        return std::min(total_blocks_, lock_free_used_blocks());
     }
-    return total_blocks_ - free_blocks_;
+    return total_blocks_ - free_blocks_ - cached_blocks_locked();
 }
 
 std::size_t FixedPool::chunk_count() const noexcept {
-    if (config_.thread_safe) {
-        std::lock_guard<std::mutex> lock(mutex_);
-    }
+    auto lock = lock_if_thread_safe();
     return chunk_count_;
 }
 
 std::size_t FixedPool::total_memory() const noexcept {
-    if (config_.thread_safe) {
-        std::lock_guard<std::mutex> lock(mutex_);
-    }
+    auto lock = lock_if_thread_safe();
     return chunk_count_ * config_.chunk_size;
 }
 
 PoolStats FixedPool::stats() const noexcept {
-    if (config_.thread_safe) {
-        std::lock_guard<std::mutex> lock(mutex_);
+    auto lock = lock_if_thread_safe();
+
+    std::size_t cached = 0;
+    std::size_t allocations = allocation_count_;
+    std::size_t deallocations = deallocation_count_;
+    for (const Magazine* magazine = magazines_; magazine; magazine = magazine->next) {
+        cached += magazine->count.load(std::memory_order_relaxed);
+        allocations += magazine->allocations.load(std::memory_order_relaxed);
+        deallocations += magazine->deallocations.load(std::memory_order_relaxed);
     }
 
     PoolStats stats;
+    if (config_.lock_free) {
+        const std::size_t used = std::min(total_blocks_, lock_free_used_blocks());
+        stats.total_memory = chunk_count_ * config_.chunk_size;
+        stats.used_memory = used * config_.block_size;
+        stats.peak_memory = lock_free_peak_.load(std::memory_order_relaxed) * config_.block_size;
+        stats.allocation_count = lock_free_allocations_.load(std::memory_order_relaxed);
+        stats.deallocation_count = lock_free_deallocations_.load(std::memory_order_relaxed);
+        stats.chunk_count = chunk_count_;
+        stats.block_count = total_blocks_;
+        stats.free_block_count = total_blocks_ - used;
+        return stats;
+    }
+
     stats.total_memory = chunk_count_ * config_.chunk_size;
-    stats.used_memory = (total_blocks_ - free_blocks_) * config_.block_size;
+    stats.used_memory = (total_blocks_ - free_blocks_ - cached) * config_.block_size;
     stats.peak_memory = peak_used_blocks_ * config_.block_size;
-    stats.allocation_count = allocation_count_;
-    stats.deallocation_count = deallocation_count_;
+    stats.allocation_count = allocations;
+    stats.deallocation_count = deallocations;
     stats.chunk_count = chunk_count_;
     stats.block_count = total_blocks_;
-    stats.free_block_count = free_blocks_;
+    stats.free_block_count = free_blocks_ + cached;
     return stats;
 }
 
+void FixedPool::flush_thread_cache() {
+    if (!uses_magazines()) {
+        return;
+    }
+    Magazine* magazine = local_magazine();
+    flush_magazine(magazine, magazine->count.load(std::memory_order_relaxed));
+}
+
+FixedPool::Magazine* FixedPool::local_magazine() {
+    thread_local ThreadCache cache;
+
+    if (cache.last && cache.last->pool.load(std::memory_order_relaxed) == this) {
+        return cache.last;
+    }
+    for (auto& magazine : cache.magazines) {
+        if (magazine->pool.load(std::memory_order_acquire) == this) {
+            cache.last = magazine.get();
+            return cache.last;
+        }
+    }
+
+    // 首次在本线程使用该池：清理已失效的弹匣并登记新弹匣
+    std::lock_guard<std::mutex> registry_lock(magazine_registry_mutex());
+    std::erase_if(cache.magazines, [](const std::unique_ptr<Magazine>& magazine) {
+        return magazine->pool.load(std::memory_order_relaxed) == nullptr;
+    });
+
+    auto magazine = std::make_unique<Magazine>();
+    magazine->pool.store(this, std::memory_order_release);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        magazine->next = magazines_;
+        magazines_ = magazine.get();
+    }
+    cache.last = magazine.get();
+    cache.magazines.push_back(std::move(magazine));
+    return cache.last;
+}
+
+void FixedPool::refill_magazine(Magazine* magazine) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    std::size_t moved = 0;
+    while (moved < config_.magazine_size) {
+        if (!free_list_) {
+            if (config_.max_chunks > 0 && chunk_count_ >= config_.max_chunks) {
+                break;  // 达到最大 Chunk 数量限制
+            }
+            if (!allocate_chunk()) {
+                break;
+            }
+        }
+        FreeBlock* block = free_list_;
+        free_list_ = block->next;
+        --free_blocks_;
+        magazine->push(block);
+        ++moved;
+    }
+
+    // 峰值按离开共享链表的块数估算（包含弹匣中尚未交付的块）
+    std::size_t used = total_blocks_ - free_blocks_;
+    if (used > peak_used_blocks_) {
+        peak_used_blocks_ = used;
+    }
+}
+
+void FixedPool::flush_magazine(Magazine* magazine, std::size_t count) noexcept {
+    if (count == 0) {
+        return;
+    }
+
+    // 先在锁外摘下 count 个块组成子链表
+    FreeBlock* first = magazine->head;
+    FreeBlock* last = nullptr;
+    std::size_t taken = 0;
+    while (taken < count && magazine->head) {
+        last = magazine->pop();
+        ++taken;
+    }
+    if (!last) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    last->next = free_list_;
+    free_list_ = first;
+    free_blocks_ += taken;
+}
+
+void FixedPool::detach_magazines(bool return_blocks) noexcept {
+    if (!uses_magazines()) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> registry_lock(magazine_registry_mutex());
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (Magazine* magazine = magazines_; magazine; magazine = magazine->next) {
+        while (FreeBlock* block = magazine->pop()) {
+            if (return_blocks) {
+                block->next = free_list_;
+                free_list_ = block;
+                ++free_blocks_;
+            }
+        }
+        allocation_count_ += magazine->allocations.exchange(0, std::memory_order_relaxed);
+        deallocation_count_ += magazine->deallocations.exchange(0, std::memory_order_relaxed);
+        magazine->pool.store(nullptr, std::memory_order_release);
+    }
+    magazines_ = nullptr;
+}
+
+void* FixedPool::allocate_lock_free() {
+    LockFreeNode* node = nullptr;
+    while (!(node = lock_free_list_.pop())) {
+        // 空闲链表耗尽：加锁扩容（其他线程可能已扩容，或新块被抢空后重试）
+        std::lock_guard<std::mutex> lock(mutex_);
+        if ((node = lock_free_list_.pop())) {
+            break;
+        }
+        if (config_.max_chunks > 0 && chunk_count_ >= config_.max_chunks) {
+            return nullptr;  // 达到最大 Chunk 数量限制
+        }
+        if (!allocate_chunk()) {
+            return nullptr;
+        }
+    }
+
+    // 更新统计与峰值（先读释放计数，保证差值不会因读取顺序被高估）
+    const std::size_t deallocations = lock_free_deallocations_.load(std::memory_order_relaxed);
+    const std::size_t allocations = lock_free_allocations_.fetch_add(1, std::memory_order_relaxed) + 1;
+    if (allocations > deallocations) {
+        const std::size_t used = allocations - deallocations;
+        std::size_t peak = lock_free_peak_.load(std::memory_order_relaxed);
+        while (used > peak && !lock_free_peak_.compare_exchange_weak(peak, used, std::memory_order_relaxed)) {
+        }
+    }
+    return node;
+}
+
+void FixedPool::deallocate_lock_free(void* ptr) noexcept {
+#if defined(_DEBUG) || defined(CFW_ENABLE_MEMORY_DEBUG)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        assert(find_chunk(ptr) && "Attempting to deallocate pointer not from this pool");
+    }
+#endif
+    // 不重新构造节点：其他线程的 pop 可能仍在原子地读取该块的 next，push 只以原子写入 next
+    lock_free_list_.push(static_cast<LockFreeNode*>(ptr));
+    lock_free_deallocations_.fetch_add(1, std::memory_order_relaxed);
+}
+
+std::size_t FixedPool::lock_free_used_blocks() const noexcept {
+    const std::size_t deallocations = lock_free_deallocations_.load(std::memory_order_relaxed);
+    const std::size_t allocations = lock_free_allocations_.load(std::memory_order_relaxed);
+    return allocations > deallocations ? allocations - deallocations : 0;
+}
+
+void FixedPool::drain_lock_free_list() noexcept {
+    LockFreeNode* node = lock_free_list_.take_all();
+    while (node) {
+        LockFreeNode* next = node->next.load(std::memory_order_relaxed);
+        auto* block = reinterpret_cast<FreeBlock*>(node);
+        block->next = free_list_;
+        free_list_ = block;
+        ++free_blocks_;
+        node = next;
+    }
+}
+
+void FixedPool::refill_lock_free_list() noexcept {
+    // 在 free_list_ 上原地构建节点链，再一次 CAS 整体压入
+    LockFreeNode* first = nullptr;
+    LockFreeNode* last = nullptr;
+    FreeBlock* block = free_list_;
+    while (block) {
+        FreeBlock* next = block->next;
+        auto* node = new (block) LockFreeNode();
+        if (last) {
+            last->next.store(node, std::memory_order_relaxed);
+        } else {
+            first = node;
+        }
+        last = node;
+        block = next;
+    }
+    free_list_ = nullptr;
+    free_blocks_ = 0;
+    lock_free_list_.push_list(first, last);
+}
+
+std::size_t FixedPool::cached_blocks_locked() const noexcept {
+    std::size_t cached = 0;
+    for (const Magazine* magazine = magazines_; magazine; magazine = magazine->next) {
+        cached += magazine->count.load(std::memory_order_relaxed);
+    }
+    return cached;
+}
+
+std::unique_lock<std::mutex> FixedPool::lock_if_thread_safe() const noexcept {
+    if (config_.thread_safe) {
+        return std::unique_lock<std::mutex>(mutex_);
+    }
+    return std::unique_lock<std::mutex>();
+}
+
 ChunkHeader* FixedPool::allocate_chunk() {
     // 分配对齐的内存
-    void* raw_memory = aligned_malloc(config_.chunk_size, config_.block_alignment);
+    void* raw_memory = nullptr;
+    if (config_.backend == PageBackend::Heap) {
+        raw_memory = aligned_malloc(config_.chunk_size, config_.block_alignment);
+    } else {
+        // 空闲链表初始化会写遍所有块，因此整块提交
+        const std::size_t mapped_size = mapped_chunk_size();
+        raw_memory = reserve_pages(mapped_size, chunk_backend());
+        if (raw_memory && !commit_pages(raw_memory, mapped_size)) {
+            release_pages(raw_memory, mapped_size);
+            raw_memory = nullptr;
+        }
+    }
     if (!raw_memory) {
         return nullptr;
     }
+    track_allocation(config_.tag, chunk_footprint());
 
     // 初始化 Chunk 头部
     auto* chunk = new (raw_memory) ChunkHeader();
@@ -307,7 +733,7 @@ ChunkHeader* FixedPool::allocate_chunk() {
         ChunkHeader::calculate_block_count(config_.chunk_size, config_.block_size, config_.block_alignment);
 
     if (chunk->block_count == 0) {
-        aligned_free(raw_memory);
+        free_chunk(chunk);
         return nullptr;
     }
 
@@ -316,13 +742,19 @@ ChunkHeader* FixedPool::allocate_chunk() {
     chunk->first_block = static_cast<std::byte*>(raw_memory) + header_size;
     chunk->free_count = chunk->block_count;
 
-    // 初始化空闲链表
+    // 初始化空闲链表（无锁模式下整体压入无锁栈）
     initialize_free_list(chunk);
+    if (config_.lock_free) {
+        refill_lock_free_list();
+    }
 
     // 加入 Chunk 链表
     chunk->next_chunk = first_chunk_;
     first_chunk_ = chunk;
 
+    // 加入地址索引
+    chunk_index_.insert(std::upper_bound(chunk_index_.begin(), chunk_index_.end(), chunk, std::less<>{}), chunk);
+
     total_blocks_ += chunk->block_count;
     ++chunk_count_;
 
@@ -346,21 +778,49 @@ void FixedPool::initialize_free_list(ChunkHeader* chunk) {
 }
 
 ChunkHeader* FixedPool::find_chunk(void* ptr) const noexcept {
-    ChunkHeader* chunk = first_chunk_;
-    while (chunk) {
-        if (chunk->contains(ptr)) {
-            return chunk;
-        }
-        chunk = chunk->next_chunk;
+    const std::size_t slot = chunk_slot(ptr);
+    return slot < chunk_index_.size() ? chunk_index_[slot] : nullptr;
+}
+
+std::size_t FixedPool::chunk_slot(const void* ptr) const noexcept {
+    // 最后一个起始地址不大于 ptr 的 Chunk 是唯一可能的归属者
+    auto it = std::upper_bound(chunk_index_.begin(), chunk_index_.end(), ptr,
+                               [](const void* p, const ChunkHeader* chunk) {
+                                   return std::less<const void*>{}(p, chunk);
+                               });
+    if (it == chunk_index_.begin()) {
+        return chunk_index_.size();
     }
-    return nullptr;
+    --it;
+    return (*it)->contains(ptr) ? static_cast<std::size_t>(it - chunk_index_.begin()) : chunk_index_.size();
 }
 
 void FixedPool::free_chunk(ChunkHeader* chunk) noexcept {
     if (chunk) {
         chunk->~ChunkHeader();
-        aligned_free(chunk);
+        if (config_.backend == PageBackend::Heap) {
+            aligned_free(chunk);
+        } else {
+            release_pages(chunk, mapped_chunk_size());
+        }
+        track_deallocation(config_.tag, chunk_footprint());
+    }
+}
+
+PageBackend FixedPool::chunk_backend() const noexcept {
+    // 小于大页的 Chunk 使用大页会放大实际占用
+    if (config_.backend == PageBackend::HugePages && config_.chunk_size < huge_page_size()) {
+        return PageBackend::VirtualMemory;
     }
+    return config_.backend;
+}
+
+std::size_t FixedPool::mapped_chunk_size() const noexcept {
+    return align_up(config_.chunk_size, page_granularity(chunk_backend()));
+}
+
+std::size_t FixedPool::chunk_footprint() const noexcept {
+    return config_.backend == PageBackend::Heap ? config_.chunk_size : mapped_chunk_size();
 }
 
 }  // namespace Corona::Kernal::Memory
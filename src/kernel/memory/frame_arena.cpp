@@ -1,14 +1,126 @@
 #include "corona/kernel/memory/frame_arena.h"
 
+#include <algorithm>
+#include <array>
+
 namespace Corona::Kernal::Memory {
 
-FrameArena::FrameArena(std::size_t buffer_size) : arenas_{LinearArena(buffer_size), LinearArena(buffer_size)} {}
+namespace {
+
+/// 线程持有的子分配器
+struct ThreadSlab {
+    const FrameArena* owner = nullptr;  ///< 所属帧分配器
+    std::uint64_t epoch = 0;            ///< 划分时的有效期标识（0 表示无效）
+    std::byte* cursor = nullptr;
+    std::byte* end = nullptr;
+};
+
+/// 每个线程同时缓存的帧分配器数量（超出时轮换淘汰）
+constexpr std::size_t kThreadSlabSlots = 4;
+
+thread_local std::array<ThreadSlab, kThreadSlabSlots> t_slabs;
+thread_local std::size_t t_next_slot = 0;
+
+/// 全局递增的有效期标识，保证析构后在同一地址重建的分配器不会误用旧子分配器
+std::uint64_t next_epoch() noexcept {
+    static std::atomic<std::uint64_t> counter{1};
+    return counter.fetch_add(1, std::memory_order_relaxed);
+}
+
+/// 在 [cursor, end) 内按对齐分配，空间不足返回 nullptr
+std::byte* bump(std::byte*& cursor, std::byte* end, std::size_t size, std::size_t alignment) noexcept {
+    const auto address = reinterpret_cast<std::uintptr_t>(cursor);
+    std::byte* aligned = cursor + (align_up(address, alignment) - address);
+    if (aligned > end || size > static_cast<std::size_t>(end - aligned)) {
+        return nullptr;
+    }
+    cursor = aligned + size;
+    return aligned;
+}
+
+}  // namespace
+
+// ============================================================================
+// FrameBuffer
+// ============================================================================
+
+FrameArena::FrameBuffer::FrameBuffer(const FrameArenaConfig& config)
+    : arena(config.buffer_size, config.growable, config.backend, config.tag),
+      tag(config.tag),
+      thread_capacity(config.thread_buffer_size) {
+    if (thread_capacity > 0) {
+        thread_region = static_cast<std::byte*>(aligned_malloc(thread_capacity, CacheLineSize));
+        if (!thread_region) {
+            thread_capacity = 0;
+        }
+        track_allocation(tag, thread_capacity);
+    }
+}
+
+FrameArena::FrameBuffer::~FrameBuffer() {
+    if (thread_region) {
+        aligned_free(thread_region);
+        track_deallocation(tag, thread_capacity);
+    }
+}
+
+std::byte* FrameArena::FrameBuffer::carve(std::size_t size) noexcept {
+    const std::size_t offset = thread_offset.fetch_add(size, std::memory_order_relaxed);
+    if (offset > thread_capacity || size > thread_capacity - offset) {
+        return nullptr;  // 线程区域耗尽
+    }
+    return thread_region + offset;
+}
+
+// ============================================================================
+// FrameArena
+// ============================================================================
+
+FrameArena::FrameArena(std::size_t buffer_size, bool growable)
+    : FrameArena(FrameArenaConfig{.buffer_size = buffer_size, .growable = growable}) {}
+
+FrameArena::FrameArena(const FrameArenaConfig& config)
+    : thread_block_size_(align_up(std::max<std::size_t>(config.thread_block_size, CacheLineSize), CacheLineSize)),
+      epoch_(next_epoch()) {
+    const std::size_t count = std::max<std::size_t>(config.buffer_count, 1);
+    buffers_.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        buffers_.push_back(std::make_unique<FrameBuffer>(config));
+    }
+}
+
+FrameArena::FrameArena(FrameArena&& other) noexcept
+    : buffers_(std::move(other.buffers_)),
+      current_index_(other.current_index_),
+      thread_block_size_(other.thread_block_size_),
+      epoch_(next_epoch()) {
+    other.current_index_ = 0;
+}
+
+FrameArena& FrameArena::operator=(FrameArena&& other) noexcept {
+    if (this != &other) {
+        buffers_ = std::move(other.buffers_);
+        current_index_ = other.current_index_;
+        thread_block_size_ = other.thread_block_size_;
+        other.current_index_ = 0;
+        advance_epoch();
+    }
+    return *this;
+}
 
-void FrameArena::swap() noexcept { current_index_ = 1 - current_index_; }
+FrameArena::~FrameArena() = default;
+
+void FrameArena::swap() noexcept {
+    current_index_ = (current_index_ + 1) % buffers_.size();
+    advance_epoch();
+}
 
 void FrameArena::begin_frame() noexcept {
     // 重置当前缓冲区
-    arenas_[current_index_].reset();
+    FrameBuffer& buffer = *buffers_[current_index_];
+    buffer.arena.reset();
+    buffer.thread_offset.store(0, std::memory_order_relaxed);
+    advance_epoch();
 }
 
 void FrameArena::end_frame() noexcept {
@@ -17,13 +129,86 @@ void FrameArena::end_frame() noexcept {
 }
 
 void* FrameArena::allocate(std::size_t size, std::size_t alignment) noexcept {
-    return arenas_[current_index_].allocate(size, alignment);
+    return current().allocate(size, alignment);
+}
+
+void* FrameArena::thread_allocate(std::size_t size, std::size_t alignment) noexcept {
+    FrameBuffer& buffer = *buffers_[current_index_];
+    if (size == 0 || !buffer.thread_region) {
+        return nullptr;
+    }
+
+    const std::uint64_t epoch = epoch_.load(std::memory_order_acquire);
+
+    // 查找本线程在该分配器上的子分配器
+    ThreadSlab* slab = nullptr;
+    for (auto& candidate : t_slabs) {
+        if (candidate.owner == this) {
+            slab = &candidate;
+            break;
+        }
+    }
+    if (!slab) {
+        slab = &t_slabs[t_next_slot++ % kThreadSlabSlots];
+        *slab = ThreadSlab{this, 0, nullptr, nullptr};
+    }
+
+    // 快速路径：子分配器仍属于当前帧
+    if (slab->epoch == epoch) {
+        if (std::byte* ptr = bump(slab->cursor, slab->end, size, alignment)) {
+            return ptr;
+        }
+    }
+
+    // 预留最坏情况下的对齐填充，并按缓存行取整避免线程间伪共享
+    const std::size_t needed = align_up(size + alignment, CacheLineSize);
+    if (needed > thread_block_size_ / 2) {
+        // 大请求单独划分，不替换当前子分配器
+        std::byte* block = buffer.carve(needed);
+        if (!block) {
+            return nullptr;
+        }
+        return bump(block, block + needed, size, alignment);
+    }
+
+    std::byte* block = buffer.carve(thread_block_size_);
+    if (!block) {
+        return nullptr;
+    }
+    slab->epoch = epoch;
+    slab->cursor = block;
+    slab->end = block + thread_block_size_;
+    return bump(slab->cursor, slab->end, size, alignment);
+}
+
+bool FrameArena::owns(const void* ptr) const noexcept {
+    const auto* byte_ptr = static_cast<const std::byte*>(ptr);
+    for (const auto& buffer : buffers_) {
+        if (buffer->arena.owns(ptr)) {
+            return true;
+        }
+        if (buffer->thread_region && byte_ptr >= buffer->thread_region &&
+            byte_ptr < buffer->thread_region + buffer->thread_capacity) {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::size_t FrameArena::current_thread_used() const noexcept {
+    const FrameBuffer& buffer = *buffers_[current_index_];
+    return std::min(buffer.thread_offset.load(std::memory_order_relaxed), buffer.thread_capacity);
 }
 
 void FrameArena::reset_all() noexcept {
-    arenas_[0].reset();
-    arenas_[1].reset();
+    for (auto& buffer : buffers_) {
+        buffer->arena.reset();
+        buffer->thread_offset.store(0, std::memory_order_relaxed);
+    }
     current_index_ = 0;
+    advance_epoch();
 }
 
+void FrameArena::advance_epoch() noexcept { epoch_.store(next_epoch(), std::memory_order_release); }
+
 }  // namespace Corona::Kernal::Memory
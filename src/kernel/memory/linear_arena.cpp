@@ -1,73 +1,307 @@
 #include "corona/kernel/memory/linear_arena.h"
 
+#include <algorithm>
+#include <cstdint>
 #include <cstring>
 #include <utility>
 
 namespace Corona::Kernal::Memory {
 
-LinearArena::LinearArena(std::size_t capacity) : capacity_(capacity) {
-    if (capacity_ > 0) {
+namespace {
+
+/// 页后端下每次至少提交的字节数（减少系统调用次数）
+constexpr std::size_t kMinCommitStep = 64 * 1024;
+
+}  // namespace
+
+LinearArena::LinearArena(std::size_t capacity, bool growable, PageBackend backend, MemoryTag tag)
+    : capacity_(capacity), growable_(growable), backend_(backend), tag_(tag) {
+    if (backend_ != PageBackend::Heap && !virtual_memory_supported()) {
+        backend_ = PageBackend::Heap;
+    }
+    if (capacity_ == 0) {
+        return;
+    }
+
+    if (backend_ == PageBackend::Heap) {
         buffer_ = static_cast<std::byte*>(aligned_malloc(capacity_, CacheLineSize));
-        if (!buffer_) {
-            capacity_ = 0;
-        }
+        committed_ = buffer_ ? capacity_ : 0;
+        track_allocation(tag_, committed_);
+    } else {
+        // 只保留地址空间，分配时逐段提交
+        buffer_ = static_cast<std::byte*>(reserve_pages(align_up(capacity_, page_granularity(backend_)), backend_));
+    }
+    if (!buffer_) {
+        capacity_ = 0;
     }
 }
 
 LinearArena::~LinearArena() {
-    if (buffer_) {
-        aligned_free(buffer_);
-        buffer_ = nullptr;
-    }
+    release_primary();
+    free_blocks(current_block_);
+    free_blocks(cached_blocks_);
+    current_block_ = nullptr;
+    cached_blocks_ = nullptr;
     capacity_ = 0;
     offset_ = 0;
 }
 
 LinearArena::LinearArena(LinearArena&& other) noexcept
-    : buffer_(other.buffer_), capacity_(other.capacity_), offset_(other.offset_) {
+    : buffer_(other.buffer_),
+      capacity_(other.capacity_),
+      offset_(other.offset_),
+      growable_(other.growable_),
+      backend_(other.backend_),
+      tag_(other.tag_),
+      committed_(other.committed_),
+      current_block_(other.current_block_),
+      cached_blocks_(other.cached_blocks_),
+      chained_capacity_(other.chained_capacity_),
+      used_before_(other.used_before_) {
     other.buffer_ = nullptr;
     other.capacity_ = 0;
     other.offset_ = 0;
+    other.committed_ = 0;
+    other.current_block_ = nullptr;
+    other.cached_blocks_ = nullptr;
+    other.chained_capacity_ = 0;
+    other.used_before_ = 0;
 }
 
 LinearArena& LinearArena::operator=(LinearArena&& other) noexcept {
     if (this != &other) {
         // 释放当前资源
-        if (buffer_) {
-            aligned_free(buffer_);
-        }
+        release_primary();
+        free_blocks(current_block_);
+        free_blocks(cached_blocks_);
 
         // 移动资源
         buffer_ = other.buffer_;
         capacity_ = other.capacity_;
         offset_ = other.offset_;
+        growable_ = other.growable_;
+        backend_ = other.backend_;
+        tag_ = other.tag_;
+        committed_ = other.committed_;
+        current_block_ = other.current_block_;
+        cached_blocks_ = other.cached_blocks_;
+        chained_capacity_ = other.chained_capacity_;
+        used_before_ = other.used_before_;
 
         // 清空源对象
         other.buffer_ = nullptr;
         other.capacity_ = 0;
         other.offset_ = 0;
+        other.committed_ = 0;
+        other.current_block_ = nullptr;
+        other.cached_blocks_ = nullptr;
+        other.chained_capacity_ = 0;
+        other.used_before_ = 0;
     }
     return *this;
 }
 
 void* LinearArena::allocate(std::size_t size, std::size_t alignment) noexcept {
-    if (size == 0 || !buffer_) {
+    if (size == 0) {
         return nullptr;
     }
 
-    // 计算对齐后的偏移
-    std::size_t aligned_offset = align_up(offset_, alignment);
+    if (void* ptr = bump(size, alignment)) {
+        return ptr;
+    }
+
+    // 当前块空间不足：可增长模式下链接追加块
+    if (!growable_ || !grow(size, alignment)) {
+        return nullptr;
+    }
+    return bump(size, alignment);
+}
+
+void LinearArena::reset() noexcept {
+    while (current_block_) {
+        retire_current_block();
+    }
+    offset_ = 0;
+    used_before_ = 0;
+}
+
+void LinearArena::rewind(const Marker& marker) noexcept {
+    // 退还标记之后链接的追加块
+    while (current_block_ && current_block_ != marker.block) {
+        retire_current_block();
+    }
+    assert(current_block_ == marker.block && "Marker does not belong to this arena");
+    assert(marker.offset <= offset_ && "Marker is ahead of the current position");
+
+    offset_ = marker.offset;
+    used_before_ = marker.used_before;
+}
+
+void LinearArena::release_cached_blocks() noexcept {
+    free_blocks(cached_blocks_);
+    cached_blocks_ = nullptr;
+}
+
+void LinearArena::shrink_to_fit() noexcept {
+    release_cached_blocks();
+    if (backend_ == PageBackend::Heap || !buffer_) {
+        return;
+    }
+
+    // 已链接追加块时主缓冲区的使用位置未知，保持提交
+    if (current_block_) {
+        return;
+    }
+    const std::size_t keep = align_up(offset_, page_granularity(backend_));
+    if (keep < committed_) {
+        decommit_pages(buffer_ + keep, committed_ - keep);
+        track_deallocation(tag_, committed_ - keep);
+        committed_ = keep;
+    }
+}
+
+std::size_t LinearArena::chained_block_count() const noexcept {
+    std::size_t count = 0;
+    for (const Block* block = current_block_; block; block = block->prev) {
+        ++count;
+    }
+    return count;
+}
+
+std::size_t LinearArena::cached_block_count() const noexcept {
+    std::size_t count = 0;
+    for (const Block* block = cached_blocks_; block; block = block->prev) {
+        ++count;
+    }
+    return count;
+}
 
-    // 检查是否有足够空间
-    if (aligned_offset + size > capacity_) {
+bool LinearArena::owns(const void* ptr) const noexcept {
+    const auto* byte_ptr = static_cast<const std::byte*>(ptr);
+    if (buffer_ && byte_ptr >= buffer_ && byte_ptr < buffer_ + capacity_) {
+        return true;
+    }
+    for (Block* list : {current_block_, cached_blocks_}) {
+        for (Block* block = list; block; block = block->prev) {
+            if (byte_ptr >= block->data() && byte_ptr < block->data() + block->capacity) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+std::byte* LinearArena::Block::data() noexcept {
+    // 数据区按缓存行对齐
+    constexpr std::size_t header_size = (sizeof(Block) + CacheLineSize - 1) / CacheLineSize * CacheLineSize;
+    return reinterpret_cast<std::byte*>(this) + header_size;
+}
+
+void* LinearArena::bump(std::size_t size, std::size_t alignment) noexcept {
+    std::byte* base = current_data();
+    if (!base) {
+        return nullptr;
+    }
+
+    // 按实际地址对齐（对齐要求可以超过块本身的对齐）
+    const auto address = reinterpret_cast<std::uintptr_t>(base + offset_);
+    const std::size_t aligned_offset = offset_ + (align_up(address, alignment) - address);
+    const std::size_t capacity = current_capacity();
+    if (aligned_offset > capacity || size > capacity - aligned_offset) {
         return nullptr;  // 空间不足
     }
+    if (!current_block_ && aligned_offset + size > committed_ && !commit_primary(aligned_offset + size)) {
+        return nullptr;  // 提交失败
+    }
 
-    void* ptr = buffer_ + aligned_offset;
     offset_ = aligned_offset + size;
-    return ptr;
+    return base + aligned_offset;
 }
 
-void LinearArena::reset() noexcept { offset_ = 0; }
+bool LinearArena::grow(std::size_t size, std::size_t alignment) noexcept {
+    // 预留最坏情况下的对齐填充
+    const std::size_t needed = size + alignment;
+
+    // 优先复用块缓存中容量足够的块（首次适配）
+    Block** pp = &cached_blocks_;
+    while (*pp && (*pp)->capacity < needed) {
+        pp = &(*pp)->prev;
+    }
+
+    Block* block = *pp;
+    if (block) {
+        *pp = block->prev;
+    } else {
+        const std::size_t capacity = std::max(capacity_, needed);
+        const std::size_t header_size = align_up(sizeof(Block), CacheLineSize);
+        void* raw = aligned_malloc(header_size + capacity, CacheLineSize);
+        if (!raw) {
+            return false;
+        }
+        block = new (raw) Block{nullptr, capacity};
+        track_allocation(tag_, header_size + capacity);
+    }
+
+    used_before_ += offset_;
+    block->prev = current_block_;
+    current_block_ = block;
+    chained_capacity_ += block->capacity;
+    offset_ = 0;
+    return true;
+}
+
+void LinearArena::retire_current_block() noexcept {
+    Block* block = current_block_;
+    current_block_ = block->prev;
+    chained_capacity_ -= block->capacity;
+
+    block->prev = cached_blocks_;
+    cached_blocks_ = block;
+}
+
+void LinearArena::free_blocks(Block* block) noexcept {
+    while (block) {
+        Block* prev = block->prev;
+        track_deallocation(tag_, align_up(sizeof(Block), CacheLineSize) + block->capacity);
+        block->~Block();
+        aligned_free(block);
+        block = prev;
+    }
+}
+
+bool LinearArena::commit_primary(std::size_t size) noexcept {
+    const std::size_t granularity = page_granularity(backend_);
+    const std::size_t reserved = align_up(capacity_, granularity);
+    const std::size_t step = align_up(kMinCommitStep, granularity);
+    const std::size_t target = std::min(reserved, align_up(std::max(size, committed_ + step), granularity));
+    if (!commit_pages(buffer_ + committed_, target - committed_)) {
+        return false;
+    }
+    track_allocation(tag_, target - committed_);
+    committed_ = target;
+    return true;
+}
+
+void LinearArena::release_primary() noexcept {
+    if (!buffer_) {
+        return;
+    }
+    if (backend_ == PageBackend::Heap) {
+        aligned_free(buffer_);
+    } else {
+        release_pages(buffer_, align_up(capacity_, page_granularity(backend_)));
+    }
+    track_deallocation(tag_, committed_);
+    buffer_ = nullptr;
+    committed_ = 0;
+}
+
+std::byte* LinearArena::current_data() const noexcept {
+    return current_block_ ? current_block_->data() : buffer_;
+}
+
+std::size_t LinearArena::current_capacity() const noexcept {
+    return current_block_ ? current_block_->capacity : capacity_;
+}
 
 }  // namespace Corona::Kernal::Memory
@@ -0,0 +1,270 @@
+#include "corona/kernel/memory/memory_tracker.h"
+
+#include <algorithm>
+#include <memory>
+
+namespace Corona::Kernal::Memory {
+
+namespace {
+
+constexpr std::array<const char*, kMemoryTagCount> kTagNames = {
+    "General", "ECS",   "Events", "Systems", "Storage", "Frame", "Plugins", "VFS",
+    "User0",   "User1", "User2",  "User3",   "User4",   "User5", "User6",   "User7",
+};
+
+/// 单写者计数器递增：只有所属线程写入，无需原子读改写；查询线程读取到的是某一时刻的值
+void add_relaxed(std::atomic<std::uint64_t>& counter, std::uint64_t value) noexcept {
+    counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+/// 本线程的计数器块是否已注销（平凡类型，其他线程本地对象析构时仍可安全读取）
+thread_local bool t_registration_destroyed = false;
+
+}  // namespace
+
+const char* memory_tag_name(MemoryTag tag) noexcept {
+    const auto index = static_cast<std::size_t>(tag);
+    return index < kMemoryTagCount ? kTagNames[index] : "Unknown";
+}
+
+// ============================================================================
+// ThreadRegistration
+// ============================================================================
+
+/// 线程本地计数器的生命周期管理：首次记录时注册，线程退出时并入累计值
+class MemoryTracker::ThreadRegistration {
+   public:
+    explicit ThreadRegistration(MemoryTracker& tracker)
+        : tracker_(tracker), counters_(std::make_unique<ThreadCounters>()) {
+        std::lock_guard<std::mutex> lock(tracker_.mutex_);
+        tracker_.threads_.push_back(counters_.get());
+    }
+
+    ~ThreadRegistration() {
+        tracker_.retire(counters_.get());
+        t_registration_destroyed = true;
+    }
+
+    ThreadRegistration(const ThreadRegistration&) = delete;
+    ThreadRegistration& operator=(const ThreadRegistration&) = delete;
+
+    [[nodiscard]] ThreadCounters& counters() noexcept { return *counters_; }
+
+   private:
+    MemoryTracker& tracker_;
+    std::unique_ptr<ThreadCounters> counters_;
+};
+
+// ============================================================================
+// MemoryTracker
+// ============================================================================
+
+MemoryTracker& MemoryTracker::instance() {
+    // 有意泄漏：线程本地计数器可能在静态对象析构之后才注销
+    static MemoryTracker* tracker = new MemoryTracker();
+    return *tracker;
+}
+
+MemoryTracker::ThreadCounters* MemoryTracker::local_counters() {
+    if (t_registration_destroyed) {
+        return nullptr;  // 线程退出阶段（其他线程本地对象的析构函数中）
+    }
+    thread_local ThreadRegistration registration(*this);
+    return &registration.counters();
+}
+
+void MemoryTracker::record_retired(std::size_t tag, std::size_t bytes, bool allocation) noexcept {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Totals& totals = retired_[tag];
+    if (allocation) {
+        totals.allocated_bytes += bytes;
+        ++totals.allocation_count;
+        flush_pending(tag, static_cast<std::int64_t>(bytes));
+    } else {
+        totals.freed_bytes += bytes;
+        ++totals.deallocation_count;
+        flush_pending(tag, -static_cast<std::int64_t>(bytes));
+    }
+}
+
+void MemoryTracker::record_allocation(MemoryTag tag, std::size_t bytes) noexcept {
+    const auto index = static_cast<std::size_t>(tag);
+    if (index >= kMemoryTagCount || bytes == 0) {
+        return;
+    }
+
+    ThreadCounters* local = local_counters();
+    if (!local) {
+        record_retired(index, bytes, true);
+        return;
+    }
+
+    Counters& counters = local->tags[index];
+    add_relaxed(counters.allocated_bytes, bytes);
+    add_relaxed(counters.allocation_count, 1);
+
+    counters.pending += static_cast<std::int64_t>(bytes);
+    if (counters.pending >= kPeakFlushThreshold) {
+        flush_pending(index, counters.pending);
+        counters.pending = 0;
+    }
+}
+
+void MemoryTracker::record_deallocation(MemoryTag tag, std::size_t bytes) noexcept {
+    const auto index = static_cast<std::size_t>(tag);
+    if (index >= kMemoryTagCount || bytes == 0) {
+        return;
+    }
+
+    ThreadCounters* local = local_counters();
+    if (!local) {
+        record_retired(index, bytes, false);
+        return;
+    }
+
+    Counters& counters = local->tags[index];
+    add_relaxed(counters.freed_bytes, bytes);
+    add_relaxed(counters.deallocation_count, 1);
+
+    counters.pending -= static_cast<std::int64_t>(bytes);
+    if (counters.pending <= -kPeakFlushThreshold) {
+        flush_pending(index, counters.pending);
+        counters.pending = 0;
+    }
+}
+
+TagStats MemoryTracker::stats(MemoryTag tag) const {
+    const auto index = static_cast<std::size_t>(tag);
+    if (index >= kMemoryTagCount) {
+        return {};
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    return make_stats_locked(index);
+}
+
+std::array<TagStats, kMemoryTagCount> MemoryTracker::sample() {
+    std::array<TagStats, kMemoryTagCount> result{};
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto now = std::chrono::steady_clock::now();
+    const double seconds = std::chrono::duration<double>(now - last_sample_).count();
+    last_sample_ = now;
+
+    for (std::size_t i = 0; i < kMemoryTagCount; ++i) {
+        const Totals totals = totals_locked(i);
+        RateSample& rate = rates_[i];
+        if (seconds > 0.0) {
+            rate.allocation_rate = static_cast<double>(totals.allocation_count - rate.allocation_count) / seconds;
+            rate.allocated_bytes_rate = static_cast<double>(totals.allocated_bytes - rate.allocated_bytes) / seconds;
+        }
+        rate.allocation_count = totals.allocation_count;
+        rate.allocated_bytes = totals.allocated_bytes;
+        result[i] = make_stats_locked(i);
+    }
+    return result;
+}
+
+std::size_t MemoryTracker::total_bytes() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::size_t total = 0;
+    for (std::size_t i = 0; i < kMemoryTagCount; ++i) {
+        const Totals totals = totals_locked(i);
+        if (totals.allocated_bytes > totals.freed_bytes) {
+            total += static_cast<std::size_t>(totals.allocated_bytes - totals.freed_bytes);
+        }
+    }
+    return total;
+}
+
+void MemoryTracker::set_budget(MemoryTag tag, std::size_t bytes) noexcept {
+    const auto index = static_cast<std::size_t>(tag);
+    if (index < kMemoryTagCount) {
+        budget_[index].store(bytes, std::memory_order_relaxed);
+    }
+}
+
+std::size_t MemoryTracker::budget(MemoryTag tag) const noexcept {
+    const auto index = static_cast<std::size_t>(tag);
+    return index < kMemoryTagCount ? budget_[index].load(std::memory_order_relaxed) : 0;
+}
+
+bool MemoryTracker::would_exceed_budget(MemoryTag tag, std::size_t additional) const {
+    const std::size_t limit = budget(tag);
+    if (limit == 0) {
+        return false;
+    }
+    return stats(tag).current_bytes + additional > limit;
+}
+
+void MemoryTracker::reset_peaks() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (std::size_t i = 0; i < kMemoryTagCount; ++i) {
+        const Totals totals = totals_locked(i);
+        const std::uint64_t current =
+            totals.allocated_bytes > totals.freed_bytes ? totals.allocated_bytes - totals.freed_bytes : 0;
+        peak_[i].store(static_cast<std::size_t>(current), std::memory_order_relaxed);
+    }
+}
+
+void MemoryTracker::retire(ThreadCounters* counters) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (std::size_t i = 0; i < kMemoryTagCount; ++i) {
+        Counters& source = counters->tags[i];
+        Totals& target = retired_[i];
+        target.allocated_bytes += source.allocated_bytes.load(std::memory_order_relaxed);
+        target.freed_bytes += source.freed_bytes.load(std::memory_order_relaxed);
+        target.allocation_count += source.allocation_count.load(std::memory_order_relaxed);
+        target.deallocation_count += source.deallocation_count.load(std::memory_order_relaxed);
+        if (source.pending != 0) {
+            flush_pending(i, source.pending);
+        }
+    }
+    std::erase(threads_, counters);
+}
+
+MemoryTracker::Totals MemoryTracker::totals_locked(std::size_t tag) const {
+    Totals totals = retired_[tag];
+    for (const ThreadCounters* counters : threads_) {
+        const Counters& source = counters->tags[tag];
+        totals.allocated_bytes += source.allocated_bytes.load(std::memory_order_relaxed);
+        totals.freed_bytes += source.freed_bytes.load(std::memory_order_relaxed);
+        totals.allocation_count += source.allocation_count.load(std::memory_order_relaxed);
+        totals.deallocation_count += source.deallocation_count.load(std::memory_order_relaxed);
+    }
+    return totals;
+}
+
+void MemoryTracker::flush_pending(std::size_t tag, std::int64_t delta) noexcept {
+    const std::int64_t current = approx_current_[tag].fetch_add(delta, std::memory_order_relaxed) + delta;
+    if (current > 0) {
+        raise_peak(tag, static_cast<std::size_t>(current));
+    }
+}
+
+void MemoryTracker::raise_peak(std::size_t tag, std::size_t current) const noexcept {
+    std::size_t peak = peak_[tag].load(std::memory_order_relaxed);
+    while (current > peak && !peak_[tag].compare_exchange_weak(peak, current, std::memory_order_relaxed)) {
+    }
+}
+
+TagStats MemoryTracker::make_stats_locked(std::size_t tag) const {
+    const Totals totals = totals_locked(tag);
+
+    TagStats stats;
+    // 释放可能发生在其他线程，单个线程的计数器相减可能为负，只在汇总后计算占用
+    stats.current_bytes = totals.allocated_bytes > totals.freed_bytes
+                              ? static_cast<std::size_t>(totals.allocated_bytes - totals.freed_bytes)
+                              : 0;
+    raise_peak(tag, stats.current_bytes);
+    stats.peak_bytes = peak_[tag].load(std::memory_order_relaxed);
+    stats.total_allocated_bytes = totals.allocated_bytes;
+    stats.total_freed_bytes = totals.freed_bytes;
+    stats.allocation_count = totals.allocation_count;
+    stats.deallocation_count = totals.deallocation_count;
+    stats.allocation_rate = rates_[tag].allocation_rate;
+    stats.allocated_bytes_rate = rates_[tag].allocated_bytes_rate;
+    stats.budget_bytes = budget_[tag].load(std::memory_order_relaxed);
+    return stats;
+}
+
+}  // namespace Corona::Kernal::Memory
@@ -0,0 +1,93 @@
+#include "corona/kernel/memory/size_class_allocator.h"
+
+#include <new>
+
+namespace Corona::Kernal::Memory {
+
+SizeClassAllocator::SizeClassAllocator(const SizeClassConfig& config)
+    : upstream_(config.upstream ? config.upstream : std::pmr::new_delete_resource()), tag_(config.tag) {
+    for (std::size_t i = 0; i < kClassCount; ++i) {
+        // 各级按需分配 Chunk，未使用的级别不占内存
+        PoolConfig pool_config{
+            .block_size = class_size(i),
+            .block_alignment = class_alignment(i),
+            .chunk_size = config.chunk_size,
+            .initial_chunks = 0,
+            .thread_safe = config.thread_safe,
+            .magazine_size = config.thread_safe ? config.magazine_size : 0,
+            .tag = config.tag,
+        };
+        pools_[i] = std::make_unique<FixedPool>(pool_config);
+    }
+}
+
+SizeClassAllocator::~SizeClassAllocator() = default;
+
+std::size_t SizeClassAllocator::select_class(std::size_t bytes, std::size_t alignment) noexcept {
+    std::size_t index = size_class_index(bytes);
+    if (index < kClassCount && class_alignment(index) < alignment) {
+        // 按对齐向上取整后，2 的幂对齐必然落在自然对齐足够的级别上（超过缓存行除外）
+        index = size_class_index(align_up(bytes, alignment));
+        if (index < kClassCount && class_alignment(index) < alignment) {
+            return kClassCount;
+        }
+    }
+    return index;
+}
+
+void* SizeClassAllocator::do_allocate(std::size_t bytes, std::size_t alignment) {
+    const std::size_t index = select_class(bytes, alignment);
+    if (index < kClassCount) {
+        void* ptr = pools_[index]->allocate();
+        if (!ptr) {
+            throw std::bad_alloc();
+        }
+        return ptr;
+    }
+
+    void* ptr = upstream_->allocate(bytes, alignment);
+    large_bytes_.fetch_add(bytes, std::memory_order_relaxed);
+    large_allocation_count_.fetch_add(1, std::memory_order_relaxed);
+    track_allocation(tag_, bytes);
+    return ptr;
+}
+
+void SizeClassAllocator::do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment) {
+    const std::size_t index = select_class(bytes, alignment);
+    if (index < kClassCount) {
+        pools_[index]->deallocate(ptr);
+        return;
+    }
+
+    upstream_->deallocate(ptr, bytes, alignment);
+    large_bytes_.fetch_sub(bytes, std::memory_order_relaxed);
+    track_deallocation(tag_, bytes);
+}
+
+bool SizeClassAllocator::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+    return this == &other;
+}
+
+PoolStats SizeClassAllocator::stats() const noexcept {
+    PoolStats total;
+    for (const auto& pool : pools_) {
+        const PoolStats stats = pool->stats();
+        total.total_memory += stats.total_memory;
+        total.used_memory += stats.used_memory;
+        total.peak_memory += stats.peak_memory;
+        total.allocation_count += stats.allocation_count;
+        total.deallocation_count += stats.deallocation_count;
+        total.chunk_count += stats.chunk_count;
+        total.block_count += stats.block_count;
+        total.free_block_count += stats.free_block_count;
+    }
+    return total;
+}
+
+void SizeClassAllocator::shrink_to_fit() {
+    for (auto& pool : pools_) {
+        pool->shrink_to_fit();
+    }
+}
+
+}  // namespace Corona::Kernal::Memory
@@ -0,0 +1,312 @@
+#include "corona/kernel/memory/virtual_memory.h"
+
+#include "corona/pal/cfw_platform.h"
+
+// clang-format off
+#if defined(CFW_PLATFORM_WINDOWS)
+#include <windows.h>
+#elif defined(CFW_PLATFORM_POSIX)
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+// clang-format on
+
+namespace Corona::Kernal::Memory {
+
+namespace {
+
+/// Linux 透明大页与 hugetlbfs 的默认大页大小
+[[maybe_unused]] constexpr std::size_t kDefaultHugePageSize = 2 * 1024 * 1024;
+
+}  // namespace
+
+#if defined(CFW_PLATFORM_WINDOWS)
+
+bool virtual_memory_supported() noexcept { return true; }
+
+std::size_t system_page_size() noexcept {
+    static const std::size_t size = [] {
+        SYSTEM_INFO info;
+        GetSystemInfo(&info);
+        return static_cast<std::size_t>(info.dwPageSize);
+    }();
+    return size;
+}
+
+std::size_t huge_page_size() noexcept {
+    static const std::size_t size = [] {
+        const SIZE_T minimum = GetLargePageMinimum();
+        return minimum > 0 ? static_cast<std::size_t>(minimum) : system_page_size();
+    }();
+    return size;
+}
+
+void* reserve_pages(std::size_t size, PageBackend backend) noexcept {
+    if (size == 0) {
+        return nullptr;
+    }
+    if (backend == PageBackend::HugePages && huge_page_size() > system_page_size()) {
+        // 大页必须在保留时一并提交，且需要 SeLockMemoryPrivilege；失败时退回普通页
+        void* ptr = VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE);
+        if (ptr) {
+            return ptr;
+        }
+
+        // 普通页需要手动对齐到大页边界：超额保留后在对齐地址上重新保留
+        for (int attempt = 0; attempt < 8; ++attempt) {
+            void* probe = VirtualAlloc(nullptr, size + huge_page_size(), MEM_RESERVE, PAGE_NOACCESS);
+            if (!probe) {
+                return nullptr;
+            }
+            const auto address = reinterpret_cast<std::uintptr_t>(probe);
+            const auto aligned = (address + huge_page_size() - 1) & ~(huge_page_size() - 1);
+            VirtualFree(probe, 0, MEM_RELEASE);
+            ptr = VirtualAlloc(reinterpret_cast<void*>(aligned), size, MEM_RESERVE, PAGE_NOACCESS);
+            if (ptr) {
+                return ptr;
+            }
+        }
+        return nullptr;
+    }
+    return VirtualAlloc(nullptr, size, MEM_RESERVE, PAGE_NOACCESS);
+}
+
+bool commit_pages(void* ptr, std::size_t size) noexcept {
+    return size == 0 || VirtualAlloc(ptr, size, MEM_COMMIT, PAGE_READWRITE) != nullptr;
+}
+
+void decommit_pages(void* ptr, std::size_t size) noexcept {
+    if (size > 0) {
+        VirtualFree(ptr, size, MEM_DECOMMIT);
+    }
+}
+
+void release_pages(void* ptr, std::size_t size) noexcept {
+    if (ptr) {
+        VirtualFree(ptr, 0, MEM_RELEASE);
+    }
+}
+
+std::size_t file_mapping_granularity() noexcept {
+    static const std::size_t size = [] {
+        SYSTEM_INFO info;
+        GetSystemInfo(&info);
+        return static_cast<std::size_t>(info.dwAllocationGranularity);
+    }();
+    return size;
+}
+
+FileHandle open_mapped_file(const char* path, std::size_t& size) noexcept {
+    // 不共享读写：文件被其他进程打开时直接失败
+    HANDLE file = CreateFileA(path, GENERIC_READ | GENERIC_WRITE, 0, nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL,
+                              nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return kInvalidFileHandle;
+    }
+    LARGE_INTEGER length;
+    if (!GetFileSizeEx(file, &length)) {
+        CloseHandle(file);
+        return kInvalidFileHandle;
+    }
+    size = static_cast<std::size_t>(length.QuadPart);
+    return reinterpret_cast<FileHandle>(file);
+}
+
+bool resize_mapped_file(FileHandle file, std::size_t size) noexcept {
+    LARGE_INTEGER length;
+    length.QuadPart = static_cast<LONGLONG>(size);
+    HANDLE handle = reinterpret_cast<HANDLE>(file);
+    return SetFilePointerEx(handle, length, nullptr, FILE_BEGIN) && SetEndOfFile(handle);
+}
+
+void* map_file(FileHandle file, std::size_t offset, std::size_t size) noexcept {
+    const auto end = static_cast<std::uint64_t>(offset + size);
+    HANDLE mapping = CreateFileMappingA(reinterpret_cast<HANDLE>(file), nullptr, PAGE_READWRITE,
+                                        static_cast<DWORD>(end >> 32), static_cast<DWORD>(end), nullptr);
+    if (!mapping) {
+        return nullptr;
+    }
+    const auto start = static_cast<std::uint64_t>(offset);
+    void* ptr = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, static_cast<DWORD>(start >> 32),
+                              static_cast<DWORD>(start), size);
+    CloseHandle(mapping);  // 视图持有映射对象的引用
+    return ptr;
+}
+
+bool flush_mapped_file(void* ptr, std::size_t size) noexcept { return FlushViewOfFile(ptr, size) != 0; }
+
+void unmap_file(void* ptr, std::size_t) noexcept {
+    if (ptr) {
+        UnmapViewOfFile(ptr);
+    }
+}
+
+void close_mapped_file(FileHandle file) noexcept {
+    if (file != kInvalidFileHandle) {
+        CloseHandle(reinterpret_cast<HANDLE>(file));
+    }
+}
+
+#elif defined(CFW_PLATFORM_POSIX)
+
+bool virtual_memory_supported() noexcept { return true; }
+
+std::size_t system_page_size() noexcept {
+    static const std::size_t size = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+    return size;
+}
+
+std::size_t huge_page_size() noexcept {
+#if defined(CFW_PLATFORM_LINUX)
+    return kDefaultHugePageSize;
+#else
+    return system_page_size();
+#endif
+}
+
+void* reserve_pages(std::size_t size, PageBackend backend) noexcept {
+    if (size == 0) {
+        return nullptr;
+    }
+
+    constexpr int kFlags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE;
+    const std::size_t alignment = page_granularity(backend);
+
+#if defined(MAP_HUGETLB)
+    if (backend == PageBackend::HugePages) {
+        // hugetlbfs 映射天然按大页对齐；不带 MAP_NORESERVE 以便在大页池不足时映射直接失败
+        // （否则首次访问才会收到 SIGBUS），随后退回透明大页
+        void* ptr = mmap(nullptr, size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (ptr != MAP_FAILED) {
+            return ptr;
+        }
+    }
+#endif
+
+    if (alignment <= system_page_size()) {
+        void* ptr = mmap(nullptr, size, PROT_NONE, kFlags, -1, 0);
+        return ptr != MAP_FAILED ? ptr : nullptr;
+    }
+
+    // 超额保留后裁掉首尾，得到按大页对齐的区域
+    void* raw = mmap(nullptr, size + alignment, PROT_NONE, kFlags, -1, 0);
+    if (raw == MAP_FAILED) {
+        return nullptr;
+    }
+    const auto address = reinterpret_cast<std::uintptr_t>(raw);
+    const auto aligned = (address + alignment - 1) & ~(alignment - 1);
+    const std::size_t head = aligned - address;
+    const std::size_t tail = alignment - head;
+    if (head > 0) {
+        munmap(raw, head);
+    }
+    if (tail > 0) {
+        munmap(reinterpret_cast<void*>(aligned + size), tail);
+    }
+
+    void* ptr = reinterpret_cast<void*>(aligned);
+#if defined(MADV_HUGEPAGE)
+    madvise(ptr, size, MADV_HUGEPAGE);
+#endif
+    return ptr;
+}
+
+bool commit_pages(void* ptr, std::size_t size) noexcept {
+    // 物理页在首次访问时才真正分配
+    return size == 0 || mprotect(ptr, size, PROT_READ | PROT_WRITE) == 0;
+}
+
+void decommit_pages(void* ptr, std::size_t size) noexcept {
+    if (size > 0) {
+        madvise(ptr, size, MADV_DONTNEED);
+        mprotect(ptr, size, PROT_NONE);
+    }
+}
+
+void release_pages(void* ptr, std::size_t size) noexcept {
+    if (ptr) {
+        munmap(ptr, size);
+    }
+}
+
+std::size_t file_mapping_granularity() noexcept { return system_page_size(); }
+
+FileHandle open_mapped_file(const char* path, std::size_t& size) noexcept {
+    const int fd = open(path, O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        return kInvalidFileHandle;
+    }
+    // 建议锁：同一文件被其他进程映射时直接失败
+    struct stat info;
+    if (flock(fd, LOCK_EX | LOCK_NB) != 0 || fstat(fd, &info) != 0) {
+        ::close(fd);
+        return kInvalidFileHandle;
+    }
+    size = static_cast<std::size_t>(info.st_size);
+    return fd;
+}
+
+bool resize_mapped_file(FileHandle file, std::size_t size) noexcept {
+    return ftruncate(static_cast<int>(file), static_cast<off_t>(size)) == 0;
+}
+
+void* map_file(FileHandle file, std::size_t offset, std::size_t size) noexcept {
+    void* ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, static_cast<int>(file),
+                     static_cast<off_t>(offset));
+    return ptr != MAP_FAILED ? ptr : nullptr;
+}
+
+bool flush_mapped_file(void* ptr, std::size_t size) noexcept { return msync(ptr, size, MS_SYNC) == 0; }
+
+void unmap_file(void* ptr, std::size_t size) noexcept {
+    if (ptr) {
+        munmap(ptr, size);
+    }
+}
+
+void close_mapped_file(FileHandle file) noexcept {
+    if (file != kInvalidFileHandle) {
+        ::close(static_cast<int>(file));  // 同时释放 flock
+    }
+}
+
+#else
+
+bool virtual_memory_supported() noexcept { return false; }
+
+std::size_t system_page_size() noexcept { return 4096; }
+
+std::size_t huge_page_size() noexcept { return system_page_size(); }
+
+void* reserve_pages(std::size_t, PageBackend) noexcept { return nullptr; }
+
+bool commit_pages(void*, std::size_t) noexcept { return false; }
+
+void decommit_pages(void*, std::size_t) noexcept {}
+
+void release_pages(void*, std::size_t) noexcept {}
+
+std::size_t file_mapping_granularity() noexcept { return system_page_size(); }
+
+FileHandle open_mapped_file(const char*, std::size_t&) noexcept { return kInvalidFileHandle; }
+
+bool resize_mapped_file(FileHandle, std::size_t) noexcept { return false; }
+
+void* map_file(FileHandle, std::size_t, std::size_t) noexcept { return nullptr; }
+
+bool flush_mapped_file(void*, std::size_t) noexcept { return false; }
+
+void unmap_file(void*, std::size_t) noexcept {}
+
+void close_mapped_file(FileHandle) noexcept {}
+
+#endif
+
+std::size_t page_granularity(PageBackend backend) noexcept {
+    return backend == PageBackend::HugePages ? huge_page_size() : system_page_size();
+}
+
+}  // namespace Corona::Kernal::Memory
@@ -1,6 +1,28 @@
 #include "corona/kernel/utils/task_scheduler.h"
 
-#include <random>
+#include <algorithm>
+#include <functional>
+
+namespace {
+
+/// 当前线程所属的调度器与工作线程索引（非工作线程为 nullptr）
+thread_local const Corona::Kernal::Utils::TaskScheduler* t_scheduler = nullptr;
+thread_local std::uint32_t t_worker_index = 0;
+
+/// 选择窃取目标的 xorshift64 状态（每线程一份，以线程 ID 的哈希作种子，必须非零）
+thread_local std::uint64_t t_xorshift_state = std::hash<std::thread::id>{}(std::this_thread::get_id()) | 1;
+
+/// 返回 [0, bound) 内的伪随机数
+std::uint32_t next_random(std::uint32_t bound) {
+    std::uint64_t x = t_xorshift_state;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    t_xorshift_state = x;
+    return static_cast<std::uint32_t>(((x >> 32) * bound) >> 32);
+}
+
+}  // namespace
 
 // 单例实例获取（线程安全的懒汉式）
 Corona::Kernal::Utils::TaskScheduler& Corona::Kernal::Utils::TaskScheduler::instance() {
@@ -10,11 +32,11 @@ Corona::Kernal::Utils::TaskScheduler& Corona::Kernal::Utils::TaskScheduler::inst
 
 // 构造函数：初始化线程池和任务队列
 Corona::Kernal::Utils::TaskScheduler::TaskScheduler()
-    : thread_count_(std::thread::hardware_concurrency()),  // 根据 CPU 核心数创建线程
-      task_queues_(thread_count_),                         // 为每个线程创建独立队列
-      threads_(thread_count_) {                            // 预留线程容器空间
+    : thread_count_(std::max(1u, std::thread::hardware_concurrency())),  // 根据 CPU 核心数创建线程
+      workers_(thread_count_) {                                           // 为每个线程创建独立队列
     // 启动所有工作线程
-    for (std::size_t i = 0; i < thread_count_; ++i) {
+    threads_.reserve(thread_count_);
+    for (std::uint32_t i = 0; i < thread_count_; ++i) {
         threads_.emplace_back(&TaskScheduler::worker_loop, this, i, stop_source_.get_token());
     }
 }
@@ -22,18 +44,24 @@ Corona::Kernal::Utils::TaskScheduler::TaskScheduler()
 // 析构函数：优雅地关闭所有工作线程
 Corona::Kernal::Utils::TaskScheduler::~TaskScheduler() {
     stop_source_.request_stop();  // 请求所有线程停止（协作式取消）
-    cv_.notify_all();             // 唤醒所有休眠的线程，让它们检查停止标志
+    idle_.notify_all();           // 唤醒所有休眠的线程，让它们检查停止标志
     // jthread 的析构函数会自动 join，等待所有线程退出
 }
 
-// 提交任务到调度器（轮询分配策略）
+// 提交任务到调度器
 void Corona::Kernal::Utils::TaskScheduler::submit(Task task) {
-    // 使用原子递增的计数器实现轮询分配，避免竞争
-    uint32_t index = submission_index_.fetch_add(1) % thread_count_;
-    // 将任务推入对应的队列
-    task_queues_[index].push(std::move(task));
-    // 唤醒一个休眠的工作线程（如果有）
-    cv_.notify_one();
+    if (t_scheduler == this) {
+        // 工作线程（如任务内嵌套提交）：推入自己的无锁队列，无需加锁
+        workers_[t_worker_index].local.push(std::move(task));
+    } else {
+        // 外部线程：使用原子递增的计数器轮询分配到各工作线程的收件箱
+        Worker& worker = workers_[submission_index_.fetch_add(1, std::memory_order_relaxed) % thread_count_];
+        std::lock_guard lock(worker.inbox_mutex);
+        worker.inbox.push_back(std::move(task));
+        worker.inbox_size.store(worker.inbox.size(), std::memory_order_release);
+    }
+    // 唤醒一个休眠的工作线程（如果有；没有休眠线程时不加锁、不进入内核）
+    idle_.notify_one();
 }
 
 // 外部线程尝试执行一个任务（用于主线程参与式等待）
@@ -43,53 +71,101 @@ bool Corona::Kernal::Utils::TaskScheduler::try_execute_task() {
 
 // 工作线程的主循环：不断取任务执行，直到收到停止信号
 void Corona::Kernal::Utils::TaskScheduler::worker_loop(std::uint32_t index, std::stop_token stop_token) {
+    t_scheduler = this;
+    t_worker_index = index;
+    Worker& worker = workers_[index];
+    std::uint32_t idle_rounds = 0;  // 连续找不到任务的轮数
+
     while (!stop_token.stop_requested()) {
-        // 步骤 1：尝试从自己的队列中取任务（FIFO，从头部取）
-        if (auto task = task_queues_[index].try_pop()) {
+        // 步骤 1：尝试从自己的无锁队列中取任务（LIFO，从底部取）
+        if (auto task = worker.local.try_pop()) {
             (*task)();  // 执行任务
+            idle_rounds = 0;
+        }
+        // 步骤 2：尝试从自己的收件箱中取任务（FIFO）
+        else if (auto inbox_task = take_from_inbox(worker, true)) {
+            (*inbox_task)();
+            idle_rounds = 0;
         }
-        // 步骤 2：如果自己的队列为空，尝试从其他线程窃取任务
+        // 步骤 3：如果自己的队列都为空，尝试从其他线程窃取任务
         else if (try_steal_and_execute(index)) {
-            continue;  // 成功窃取并执行，继续下一轮循环
+            idle_rounds = 0;  // 成功窃取并执行，继续下一轮循环
         }
-        // 步骤 3：如果窃取也失败，进入休眠等待新任务
+        // 步骤 4：短暂自旋，新任务通常很快到来，避免立即休眠再被唤醒的开销
+        else if (++idle_rounds < kIdleSpinRounds) {
+            std::this_thread::yield();
+        }
+        // 步骤 5：进入休眠等待新任务或停止信号
         else {
-            std::unique_lock lock(cv_mutex_);
-            // 等待直到：1) 收到停止信号，或 2) 有新任务提交
-            cv_.wait(lock, [this, &stop_token, index]() {
-                return stop_token.stop_requested() || has_any_task();
-            });
+            const EventCount::Key key = idle_.prepare_wait();
+            // 登记后再检查一次：登记前提交的任务必然在此可见，登记后提交的任务会唤醒本线程
+            if (stop_token.stop_requested() || has_any_task()) {
+                idle_.cancel_wait();
+            } else {
+                idle_.commit_wait(key);
+            }
+            idle_rounds = 0;
         }
     }
 }
 
 // 尝试从其他线程窃取任务并执行
 bool Corona::Kernal::Utils::TaskScheduler::try_steal_and_execute(std::optional<std::uint32_t> index) {
-    // 随机生成起始索引，避免所有线程总是从同一个队列开始窃取
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<std::uint32_t> dis(0, thread_count_ - 1);
-    std::uint32_t start_index = dis(gen);
+    // 随机生成起始索引（线程本地 xorshift，无需构造随机引擎），避免所有线程总是从同一个队列开始窃取
+    const std::uint32_t start_index = next_random(thread_count_);
 
-    // 遍历所有队列尝试窃取（从随机位置开始，循环一圈）
+    // 先遍历所有无锁队列尝试窃取（从随机位置开始，循环一圈）
     for (std::uint32_t i = 0; i < thread_count_; ++i) {
         std::uint32_t target_index = (start_index + i) % thread_count_;
         // 如果提供了 index，跳过自己的队列（避免重复尝试）
         if (index.has_value() && target_index == index.value()) {
             continue;
         }
-        // 尝试从目标队列的尾部窃取任务（LIFO，减少与所有者的竞争）
-        if (auto task = task_queues_[target_index].try_steal()) {
+        // 尝试从目标队列的顶部窃取任务（FIFO，与所有者在队列两端工作）
+        if (auto task = workers_[target_index].local.try_steal()) {
             (*task)();  // 立即执行窃取到的任务
             return true;
         }
     }
+
+    // 再尝试其他线程收件箱中尚未取走的任务（所有者可能正忙于长任务）
+    for (std::uint32_t i = 0; i < thread_count_; ++i) {
+        std::uint32_t target_index = (start_index + i) % thread_count_;
+        if (index.has_value() && target_index == index.value()) {
+            continue;
+        }
+        if (auto task = take_from_inbox(workers_[target_index], false)) {
+            (*task)();
+            return true;
+        }
+    }
     return false;  // 所有队列都为空，窃取失败
 }
 
-// 检查是否还有任务待执行（简化实现）
+// 从收件箱头部取出任务
+std::optional<Corona::Kernal::Utils::Task> Corona::Kernal::Utils::TaskScheduler::take_from_inbox(Worker& worker,
+                                                                                               bool blocking) {
+    if (worker.inbox_size.load(std::memory_order_acquire) == 0) {
+        return std::nullopt;  // 收件箱为空，不加锁
+    }
+    std::unique_lock lock(worker.inbox_mutex, std::defer_lock);
+    if (blocking) {
+        lock.lock();
+    } else if (!lock.try_lock()) {
+        return std::nullopt;
+    }
+    if (worker.inbox.empty()) {
+        return std::nullopt;
+    }
+    Task task = std::move(worker.inbox.front());
+    worker.inbox.pop_front();
+    worker.inbox_size.store(worker.inbox.size(), std::memory_order_release);
+    return task;
+}
+
+// 检查是否还有任务待执行（只读取各队列的计数，不加锁）
 bool Corona::Kernal::Utils::TaskScheduler::has_any_task() const {
-    return true;  // 简化实现，始终返回 true
-    // TODO: 未来可以优化为实际遍历所有队列检查是否为空
-    //       但这会引入额外的锁竞争，需要权衡性能
+    return std::any_of(workers_.begin(), workers_.end(), [](const Worker& worker) {
+        return !worker.local.empty() || worker.inbox_size.load(std::memory_order_acquire) > 0;
+    });
 }
\ No newline at end of file
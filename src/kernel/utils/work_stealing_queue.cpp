@@ -1,35 +1,104 @@
 #include "corona/kernel/utils/work_stealing_queue.h"
 
+#include <algorithm>
+#include <bit>
 #include <utility>
 
-// 将任务推入队列尾部（所有者操作）
+// 构造函数：分配初始环形缓冲区
+Corona::Kernal::Utils::WorkStealingQueue::WorkStealingQueue(std::size_t initial_capacity) {
+    rings_.push_back(std::make_unique<Ring>(std::bit_ceil(std::max<std::size_t>(initial_capacity, 2))));
+    ring_.store(rings_.back().get(), std::memory_order_relaxed);
+}
+
+// 析构函数：删除尚未执行的任务（缓冲区由 rings_ 释放）
+Corona::Kernal::Utils::WorkStealingQueue::~WorkStealingQueue() {
+    Ring* ring = ring_.load(std::memory_order_relaxed);
+    const std::int64_t bottom = bottom_.load(std::memory_order_relaxed);
+    for (std::int64_t i = top_.load(std::memory_order_relaxed); i < bottom; ++i) {
+        delete ring->load(i);
+    }
+}
+
+// 将任务推入队列底部（所有者操作）
 void Corona::Kernal::Utils::WorkStealingQueue::push(Task task) {
-    std::lock_guard<std::mutex> lock(mutex_);  // 获取锁保护队列
-    tasks_.push_back(std::move(task));         // 移动任务到队列尾部
+    auto* item = new Task(std::move(task));
+    const std::int64_t bottom = bottom_.load(std::memory_order_relaxed);
+    const std::int64_t top = top_.load(std::memory_order_acquire);
+    Ring* ring = ring_.load(std::memory_order_relaxed);
+    if (bottom - top >= static_cast<std::int64_t>(ring->capacity())) {
+        ring = grow(ring, top, bottom);
+    }
+    ring->store(bottom, item);
+    // release：窃取者读到新的 bottom 时，任务对象与（可能扩容后的）缓冲区均已可见
+    bottom_.store(bottom + 1, std::memory_order_release);
 }
 
-// 从队列头部弹出任务（所有者操作，FIFO）
-std::optional<Corona::Kernal::Utils::Task>
-Corona::Kernal::Utils::WorkStealingQueue::try_pop() {
-    std::lock_guard<std::mutex> lock(mutex_);  // 获取锁保护队列
-    if (tasks_.empty()) {
-        return std::nullopt;  // 队列为空，返回空
+// 从队列底部弹出任务（所有者操作，LIFO）
+std::optional<Corona::Kernal::Utils::Task> Corona::Kernal::Utils::WorkStealingQueue::try_pop() {
+    const std::int64_t bottom = bottom_.load(std::memory_order_relaxed) - 1;
+    Ring* ring = ring_.load(std::memory_order_relaxed);
+    // 先占住底部槽位再读取 top：seq_cst 保证与窃取者的 读 top -> 读 bottom 不会互相错过
+    bottom_.store(bottom, std::memory_order_seq_cst);
+    std::int64_t top = top_.load(std::memory_order_seq_cst);
+
+    if (top > bottom) {
+        bottom_.store(bottom + 1, std::memory_order_relaxed);  // 队列为空，恢复
+        return std::nullopt;
+    }
+
+    Task* item = ring->load(bottom);
+    if (top == bottom) {
+        // 最后一个任务：与窃取者竞争 top
+        const bool won =
+            top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+        bottom_.store(bottom + 1, std::memory_order_relaxed);
+        if (!won) {
+            return std::nullopt;
+        }
     }
-    // 从头部取任务（FIFO 顺序）
-    Task task = std::move(tasks_.front());
-    tasks_.pop_front();
+
+    Task task = std::move(*item);
+    delete item;
     return task;
 }
 
-// 从队列尾部窃取任务（窃取者操作，LIFO）
-std::optional<Corona::Kernal::Utils::Task>
-Corona::Kernal::Utils::WorkStealingQueue::try_steal() {
-    std::lock_guard<std::mutex> lock(mutex_);  // 获取锁保护队列
-    if (tasks_.empty()) {
-        return std::nullopt;  // 队列为空，返回空
+// 从队列顶部窃取任务（窃取者操作，FIFO）
+std::optional<Corona::Kernal::Utils::Task> Corona::Kernal::Utils::WorkStealingQueue::try_steal() {
+    std::int64_t top = top_.load(std::memory_order_seq_cst);
+    const std::int64_t bottom = bottom_.load(std::memory_order_seq_cst);
+    if (top >= bottom) {
+        return std::nullopt;
+    }
+
+    // 缓冲区在读到 bottom 之后加载：扩容发生在发布 bottom 之前，此处至少能看到包含 top 的缓冲区
+    Task* item = ring_.load(std::memory_order_acquire)->load(top);
+    if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+        return std::nullopt;  // 被所有者或其他窃取者抢先，item 不属于本线程
     }
-    // 从尾部取任务（LIFO 顺序，与 try_pop 相反，减少竞争）
-    Task task = std::move(tasks_.back());
-    tasks_.pop_back();
+
+    Task task = std::move(*item);
+    delete item;
     return task;
 }
+
+// 当前任务数（近似值）
+std::size_t Corona::Kernal::Utils::WorkStealingQueue::size() const noexcept {
+    const std::int64_t bottom = bottom_.load(std::memory_order_relaxed);
+    const std::int64_t top = top_.load(std::memory_order_relaxed);
+    return bottom > top ? static_cast<std::size_t>(bottom - top) : 0;
+}
+
+// 扩容为两倍大小（所有者操作）
+Corona::Kernal::Utils::WorkStealingQueue::Ring* Corona::Kernal::Utils::WorkStealingQueue::grow(Ring* ring,
+                                                                                                std::int64_t top,
+                                                                                                std::int64_t bottom) {
+    auto next = std::make_unique<Ring>(ring->capacity() * 2);
+    for (std::int64_t i = top; i < bottom; ++i) {
+        next->store(i, ring->load(i));
+    }
+    Ring* result = next.get();
+    rings_.push_back(std::move(next));
+    // 旧缓冲区保留：窃取者可能已加载旧缓冲区指针，其槽位内容不变，读到的仍是有效任务
+    ring_.store(result, std::memory_order_release);
+    return result;
+}
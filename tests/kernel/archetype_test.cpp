@@ -1,6 +1,9 @@
 #include "corona/kernel/ecs/archetype.h"
 
 #include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <string>
 #include <vector>
 
@@ -8,6 +11,7 @@
 #include "corona/kernel/ecs/archetype_layout.h"
 #include "corona/kernel/ecs/archetype_signature.h"
 #include "corona/kernel/ecs/chunk.h"
+#include "corona/kernel/ecs/chunk_allocator.h"
 #include "corona/kernel/ecs/component.h"
 
 using namespace Corona::Kernel::ECS;
@@ -67,6 +71,14 @@ struct alignas(32) AlignedComponent {
 // 空组件（标签组件）
 struct TagComponent {};
 
+// SoA 拆分组件
+struct SplitVec {
+    float x = 0.0f;
+    double y = 0.0;
+    std::uint16_t z = 0;
+};
+CORONA_SOA_COMPONENT(SplitVec, &SplitVec::x, &SplitVec::y, &SplitVec::z);
+
 // 验证组件满足 Component concept
 static_assert(Component<Position>);
 static_assert(Component<Velocity>);
@@ -403,6 +415,69 @@ TEST(ArchetypeLayout, ChunkSizeCalculation) {
     ASSERT_LE(layout.chunk_data_size, kDefaultChunkSize);
 }
 
+TEST(ArchetypeLayout, SoaFieldSubColumns) {
+    CORONA_REGISTER_COMPONENT(Position);
+    CORONA_REGISTER_COMPONENT(SplitVec);
+
+    auto sig = ArchetypeSignature::create<Position, SplitVec>();
+    auto layout = ArchetypeLayout::calculate(sig);
+    ASSERT_TRUE(layout.is_valid());
+    ASSERT_LE(layout.chunk_data_size, kDefaultChunkSize);
+
+    const auto* pos = layout.find_component<Position>();
+    const auto* split = layout.find_component<SplitVec>();
+    ASSERT_TRUE(pos != nullptr && split != nullptr);
+    ASSERT_FALSE(pos->is_split());
+    ASSERT_TRUE(split->is_split());
+    ASSERT_EQ(split->fields.size(), 3u);
+    ASSERT_EQ(split->array_offset, split->fields[0].array_offset);
+
+    // 字段子列按字段大小排布、各自对齐
+    ASSERT_EQ(split->fields[0].size, sizeof(float));
+    ASSERT_EQ(split->fields[1].size, sizeof(double));
+    ASSERT_EQ(split->fields[2].size, sizeof(std::uint16_t));
+    ASSERT_EQ(split->fields[1].offset_in_component, offsetof(SplitVec, y));
+    for (const auto& field : split->fields) {
+        ASSERT_EQ(field.array_offset % field.size, 0u);
+    }
+    ASSERT_GE(split->fields[1].array_offset,
+              split->fields[0].array_offset + sizeof(float) * layout.entities_per_chunk);
+}
+
+TEST(Chunk, SoaComponentSwapAndPop) {
+    CORONA_REGISTER_COMPONENT(SplitVec);
+
+    auto sig = ArchetypeSignature::create<SplitVec>();
+    auto layout = ArchetypeLayout::calculate(sig);
+    Chunk chunk(layout, layout.entities_per_chunk);
+
+    // SoA 组件没有整体数组
+    auto type_id = get_component_type_id<SplitVec>();
+    ASSERT_TRUE(chunk.get_component_array(type_id) == nullptr);
+
+    for (int i = 0; i < 4; ++i) {
+        auto index = chunk.allocate();
+        SplitVec value{static_cast<float>(i), i * 2.0, static_cast<std::uint16_t>(i * 3)};
+        ASSERT_TRUE(chunk.write_split_component(type_id, index, &value));
+    }
+
+    auto moved = chunk.deallocate(1);
+    ASSERT_TRUE(moved.has_value());
+    ASSERT_EQ(*moved, 3u);
+
+    SplitVec out;
+    ASSERT_TRUE(chunk.read_split_component(type_id, 1, &out));
+    ASSERT_EQ(out.x, 3.0f);
+    ASSERT_EQ(out.y, 6.0);
+    ASSERT_EQ(out.z, 9u);
+
+    auto view = chunk.get_soa_components<SplitVec>();
+    ASSERT_EQ(view.size(), 3u);
+    ASSERT_EQ(view.get<&SplitVec::y>()[2], 4.0);
+    view.store(0, SplitVec{9.0f, 9.0, 9});
+    ASSERT_EQ(view.load(0).z, 9u);
+}
+
 // ========================================
 // Chunk 测试
 // ========================================
@@ -1168,6 +1243,116 @@ TEST(Archetype, DeallocateFromMultipleChunks) {
     ASSERT_EQ(archetype.entity_count(), 1000u);
 }
 
+TEST(Archetype, ChunkDataMatchesChunks) {
+    CORONA_REGISTER_COMPONENT(Position);
+    CORONA_REGISTER_COMPONENT(Velocity);
+
+    auto sig = ArchetypeSignature::create<Position, Velocity>();
+    Archetype archetype(1, sig);
+
+    for (std::size_t i = 0; i < 2000; ++i) {
+        (void)archetype.allocate_entity();
+    }
+    ASSERT_GT(archetype.chunk_count(), 1u);
+
+    auto chunk_data = archetype.chunk_data();
+    ASSERT_EQ(chunk_data.size(), archetype.chunk_count());
+    for (std::size_t i = 0; i < chunk_data.size(); ++i) {
+        ASSERT_TRUE(chunk_data[i] != nullptr);
+        ASSERT_EQ(chunk_data[i], archetype.get_chunk(i).data());
+    }
+
+    // 移动后地址数组应随之转移
+    Archetype moved(std::move(archetype));
+    ASSERT_EQ(moved.chunk_data().size(), moved.chunk_count());
+    ASSERT_EQ(moved.chunk_data()[0], moved.get_chunk(0).data());
+
+    // 越界预取应安全忽略
+    const std::size_t offsets[] = {0};
+    moved.prefetch_chunk(moved.chunk_count(), offsets);
+}
+
+// ========================================
+// ChunkAllocator 测试
+// ========================================
+
+TEST(ChunkAllocator, ShrinkReleasesFreeArenas) {
+    ChunkAllocator allocator(16 * 1024, 256 * 1024, false);
+
+    std::vector<void*> chunks;
+    for (int i = 0; i < 64; ++i) {
+        chunks.push_back(allocator.allocate());
+    }
+    ASSERT_EQ(allocator.arena_count(), 4);
+
+    // 释放前 3 个 Arena 的全部 Chunk，最后一个 Arena 保留一个
+    for (std::size_t i = 0; i < 63; ++i) {
+        allocator.deallocate(chunks[i]);
+    }
+    allocator.shrink();
+    ASSERT_EQ(allocator.arena_count(), 1);
+    ASSERT_EQ(allocator.allocated_count(), 1);
+    ASSERT_EQ(allocator.free_count(), 15);
+
+    // 剩余空闲列表仍然可用
+    void* reused = allocator.allocate();
+    ASSERT_NE(reused, nullptr);
+    allocator.deallocate(reused);
+    allocator.deallocate(chunks[63]);
+
+    allocator.shrink();
+    ASSERT_EQ(allocator.arena_count(), 0);
+    ASSERT_EQ(allocator.free_count(), 0);
+}
+
+TEST(ChunkAllocator, VirtualMemoryBackend) {
+    using Corona::Kernal::Memory::PageBackend;
+    constexpr std::size_t kChunkSize = 16 * 1024;
+    constexpr std::size_t kArenaSize = 4 * 1024 * 1024;
+
+    ChunkAllocator allocator(kChunkSize, kArenaSize, true, PageBackend::VirtualMemory);
+    if (allocator.backend() == PageBackend::Heap) {
+        return;  // 平台不支持页后端
+    }
+
+    // 只提交已划分的 Chunk 所在页
+    void* first = allocator.allocate();
+    ASSERT_NE(first, nullptr);
+    ASSERT_LT(allocator.committed_memory(), kArenaSize);
+
+    std::vector<void*> chunks{first};
+    for (int i = 0; i < 100; ++i) {
+        void* chunk = allocator.allocate();
+        ASSERT_NE(chunk, nullptr);
+        std::memset(chunk, 0x5A, kChunkSize);
+        chunks.push_back(chunk);
+    }
+    const std::size_t committed = allocator.committed_memory();
+
+    // 部分空闲的 Arena 归还空闲 Chunk 的物理页
+    for (std::size_t i = 1; i < chunks.size(); ++i) {
+        allocator.deallocate(chunks[i]);
+    }
+    allocator.shrink();
+    ASSERT_EQ(allocator.arena_count(), 1);
+    ASSERT_LT(allocator.committed_memory(), committed);
+
+    // 再次分配时重新提交
+    for (std::size_t i = 1; i < chunks.size(); ++i) {
+        chunks[i] = allocator.allocate();
+        ASSERT_NE(chunks[i], nullptr);
+        std::memset(chunks[i], 0x3C, kChunkSize);
+    }
+    ASSERT_EQ(allocator.committed_memory(), committed);
+
+    for (void* chunk : chunks) {
+        allocator.deallocate(chunk);
+    }
+    allocator.shrink();
+    ASSERT_EQ(allocator.arena_count(), 0);
+    ASSERT_EQ(allocator.committed_memory(), 0);
+}
+
 // ========================================
 // Main
 // ========================================
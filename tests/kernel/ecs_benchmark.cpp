@@ -0,0 +1,339 @@
+// ECS 性能基准
+//
+// 覆盖 each（1/2/4 个组件）、add/remove 组件迁移、创建/销毁吞吐量、
+// 随机 get_component，在实体数量（1k ~ 10M）与 Archetype 数量
+// （1 ~ 1000）的组合矩阵上测量，并输出 JSON 便于版本间对比。
+//
+// 用法：
+//   kernel_ecs_benchmark [--quick] [--max-entities N] [--max-archetypes N]
+//                        [--repeat N] [--out file.json]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "corona/kernel/ecs/world.h"
+
+using namespace Corona::Kernel::ECS;
+
+namespace {
+
+// ========================================
+// 基准组件
+// ========================================
+
+struct Position {
+    float x = 0.0f;
+    float y = 0.0f;
+    float z = 0.0f;
+};
+
+struct Velocity {
+    float vx = 0.0f;
+    float vy = 0.0f;
+    float vz = 0.0f;
+};
+
+struct Health {
+    int current = 100;
+    int max = 100;
+};
+
+struct Mass {
+    float value = 1.0f;
+};
+
+/// 用于 add/remove 迁移的组件
+struct Churn {
+    std::uint32_t value = 0;
+};
+
+/// Archetype 区分位：实体按位组合这些组件，最多产生 2^kArchetypeBits 个 Archetype
+template <std::size_t Bit>
+struct ArchetypeBit {
+    std::uint8_t value = 0;
+};
+
+constexpr std::size_t kArchetypeBits = 10;
+
+// ========================================
+// 辅助工具
+// ========================================
+
+class BenchmarkTimer {
+   public:
+    void start() { start_time_ = std::chrono::steady_clock::now(); }
+
+    [[nodiscard]] double elapsed_ms() const {
+        auto end_time = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::milli>(end_time - start_time_).count();
+    }
+
+   private:
+    std::chrono::steady_clock::time_point start_time_;
+};
+
+/// 单条基准结果
+struct BenchmarkResult {
+    std::string name;
+    std::size_t entities = 0;
+    std::size_t archetypes = 0;
+    std::size_t operations = 0;  ///< 每轮操作次数
+    double best_ms = 0.0;        ///< 多轮中的最佳耗时
+    double mean_ms = 0.0;        ///< 多轮平均耗时
+};
+
+struct BenchmarkOptions {
+    std::vector<std::size_t> entity_counts{1'000, 10'000, 100'000, 1'000'000, 10'000'000};
+    std::vector<std::size_t> archetype_counts{1, 10, 100, 1000};
+    std::size_t max_entities = 10'000'000;
+    std::size_t max_archetypes = 1000;
+    std::size_t repeat = 5;
+    std::string output_path;  ///< 为空时输出到 stdout
+};
+
+/// 为实体添加 mask 指定的区分位组件
+template <std::size_t... Is>
+void add_archetype_bits(World& world, EntityId entity, std::size_t mask, std::index_sequence<Is...>) {
+    ((mask & (std::size_t{1} << Is) ? (void)world.add_component(entity, ArchetypeBit<Is>{}) : void()), ...);
+}
+
+/// 构建包含 entity_count 个实体、分布在 archetype_count 个 Archetype 上的 World
+std::vector<EntityId> populate(World& world, std::size_t entity_count, std::size_t archetype_count) {
+    std::vector<EntityId> entities;
+    entities.reserve(entity_count);
+    for (std::size_t i = 0; i < entity_count; ++i) {
+        EntityId e = world.create_entity(Position{static_cast<float>(i), 0.0f, 0.0f},
+                                         Velocity{1.0f, 0.0f, 0.0f}, Health{}, Mass{});
+        add_archetype_bits(world, e, i % archetype_count, std::make_index_sequence<kArchetypeBits>{});
+        entities.push_back(e);
+    }
+    return entities;
+}
+
+/// 重复执行 body 并汇总耗时
+template <typename Setup, typename Body>
+BenchmarkResult measure(const char* name, std::size_t entities, std::size_t archetypes,
+                        std::size_t operations, std::size_t repeat, Setup&& setup, Body&& body) {
+    BenchmarkResult result{name, entities, archetypes, operations, 0.0, 0.0};
+    double total = 0.0;
+    for (std::size_t r = 0; r < repeat; ++r) {
+        setup();
+        BenchmarkTimer timer;
+        timer.start();
+        body();
+        double elapsed = timer.elapsed_ms();
+        total += elapsed;
+        result.best_ms = (r == 0) ? elapsed : std::min(result.best_ms, elapsed);
+    }
+    result.mean_ms = repeat > 0 ? total / static_cast<double>(repeat) : 0.0;
+    return result;
+}
+
+/// 防止编译器消除被测代码
+volatile float g_sink = 0.0f;
+
+// ========================================
+// 基准用例
+// ========================================
+
+void run_case(std::size_t entity_count, std::size_t archetype_count, std::size_t repeat,
+              std::vector<BenchmarkResult>& results) {
+    World world;
+    std::vector<EntityId> entities = populate(world, entity_count, archetype_count);
+    std::mt19937 rng(static_cast<std::mt19937::result_type>(entity_count * 31 + archetype_count));
+    auto noop = []() {};
+
+    // each：1 / 2 / 4 个组件
+    results.push_back(measure("each_1", entity_count, archetype_count, entity_count, repeat, noop, [&]() {
+        world.each<Position>([](Position& pos) { pos.x += 1.0f; });
+    }));
+    results.push_back(measure("each_2", entity_count, archetype_count, entity_count, repeat, noop, [&]() {
+        world.each<Position, const Velocity>([](Position& pos, const Velocity& vel) { pos.x += vel.vx; });
+    }));
+    results.push_back(measure("each_4", entity_count, archetype_count, entity_count, repeat, noop, [&]() {
+        world.each<Position, const Velocity, Health, const Mass>(
+            [](Position& pos, const Velocity& vel, Health& hp, const Mass& mass) {
+                pos.x += vel.vx * mass.value;
+                hp.current -= 1;
+            });
+    }));
+
+    // 随机 get_component
+    const std::size_t lookups = std::min<std::size_t>(entity_count, 1'000'000);
+    std::vector<EntityId> lookup_order(lookups);
+    for (auto& id : lookup_order) {
+        id = entities[std::uniform_int_distribution<std::size_t>(0, entity_count - 1)(rng)];
+    }
+    results.push_back(measure("get_component_random", entity_count, archetype_count, lookups, repeat, noop, [&]() {
+        const World& view = world;
+        float sum = 0.0f;
+        for (EntityId id : lookup_order) {
+            sum += view.get_component<Position>(id)->x;
+        }
+        g_sink = sum;
+    }));
+
+    // add/remove 迁移
+    const std::size_t churn_count = std::min<std::size_t>(entity_count, 100'000);
+    std::vector<EntityId> churn_order(entities.begin(), entities.end());
+    std::shuffle(churn_order.begin(), churn_order.end(), rng);
+    churn_order.resize(churn_count);
+    results.push_back(measure("add_remove_churn", entity_count, archetype_count, churn_count * 2, repeat, noop,
+                              [&]() {
+                                  for (EntityId id : churn_order) {
+                                      world.add_component(id, Churn{});
+                                  }
+                                  for (EntityId id : churn_order) {
+                                      world.remove_component<Churn>(id);
+                                  }
+                              }));
+
+    // 创建吞吐量（进入已有 Archetype，每轮结束后销毁新建实体）
+    const std::size_t spawn_count = std::min<std::size_t>(entity_count, 1'000'000);
+    std::vector<EntityId> spawned;
+    spawned.reserve(spawn_count);
+    results.push_back(measure(
+        "create", entity_count, archetype_count, spawn_count, repeat,
+        [&]() {
+            for (EntityId id : spawned) {
+                world.destroy_entity(id);
+            }
+            spawned.clear();
+        },
+        [&]() {
+            for (std::size_t i = 0; i < spawn_count; ++i) {
+                spawned.push_back(world.create_entity(Position{}, Velocity{}, Health{}, Mass{}));
+            }
+        }));
+    for (EntityId id : spawned) {
+        world.destroy_entity(id);
+    }
+    spawned.clear();
+
+    // 销毁吞吐量（随机顺序销毁整个 World，只测一轮）
+    std::vector<EntityId> destroy_order(entities.begin(), entities.end());
+    std::shuffle(destroy_order.begin(), destroy_order.end(), rng);
+    results.push_back(measure("destroy", entity_count, archetype_count, entity_count, 1, noop, [&]() {
+        for (EntityId id : destroy_order) {
+            world.destroy_entity(id);
+        }
+    }));
+}
+
+// ========================================
+// 输出
+// ========================================
+
+std::string to_json(const std::vector<BenchmarkResult>& results, const BenchmarkOptions& options) {
+    std::ostringstream out;
+    out.precision(6);
+    out << std::fixed;
+    out << "{\n";
+    out << "  \"suite\": \"corona_ecs\",\n";
+    out << "  \"schema_version\": 1,\n";
+    out << "  \"repeat\": " << options.repeat << ",\n";
+    out << "  \"results\": [\n";
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        const auto& r = results[i];
+        const double ns_per_op = r.operations > 0 ? r.best_ms * 1e6 / static_cast<double>(r.operations) : 0.0;
+        const double ops_per_sec = r.best_ms > 0.0 ? static_cast<double>(r.operations) / (r.best_ms / 1e3) : 0.0;
+        out << "    {\"name\": \"" << r.name << "\", \"entities\": " << r.entities
+            << ", \"archetypes\": " << r.archetypes << ", \"operations\": " << r.operations
+            << ", \"best_ms\": " << r.best_ms << ", \"mean_ms\": " << r.mean_ms
+            << ", \"ns_per_op\": " << ns_per_op << ", \"ops_per_sec\": " << ops_per_sec << "}"
+            << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n";
+    out << "}\n";
+    return out.str();
+}
+
+bool parse_options(int argc, char** argv, BenchmarkOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        auto next_value = [&](std::size_t& value) {
+            if (i + 1 >= argc) {
+                return false;
+            }
+            value = static_cast<std::size_t>(std::strtoull(argv[++i], nullptr, 10));
+            return true;
+        };
+
+        if (arg == "--quick") {
+            options.entity_counts = {1'000, 10'000};
+            options.archetype_counts = {1, 10};
+            options.repeat = 1;
+        } else if (arg == "--max-entities") {
+            if (!next_value(options.max_entities)) {
+                return false;
+            }
+        } else if (arg == "--max-archetypes") {
+            if (!next_value(options.max_archetypes)) {
+                return false;
+            }
+        } else if (arg == "--repeat") {
+            if (!next_value(options.repeat) || options.repeat == 0) {
+                return false;
+            }
+        } else if (arg == "--out") {
+            if (i + 1 >= argc) {
+                return false;
+            }
+            options.output_path = argv[++i];
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    BenchmarkOptions options;
+    if (!parse_options(argc, argv, options)) {
+        std::cerr << "usage: " << argv[0]
+                  << " [--quick] [--max-entities N] [--max-archetypes N] [--repeat N] [--out file.json]\n";
+        return 2;
+    }
+
+    std::vector<BenchmarkResult> results;
+    for (std::size_t entity_count : options.entity_counts) {
+        if (entity_count > options.max_entities) {
+            continue;
+        }
+        for (std::size_t archetype_count : options.archetype_counts) {
+            if (archetype_count > options.max_archetypes || archetype_count > entity_count ||
+                archetype_count > (std::size_t{1} << kArchetypeBits)) {
+                continue;
+            }
+            std::cerr << "[ecs_benchmark] entities=" << entity_count << " archetypes=" << archetype_count
+                      << std::endl;
+            run_case(entity_count, archetype_count, options.repeat, results);
+        }
+    }
+
+    const std::string json = to_json(results, options);
+    if (options.output_path.empty()) {
+        std::cout << json;
+    } else {
+        std::ofstream file(options.output_path);
+        if (!file) {
+            std::cerr << "failed to open " << options.output_path << "\n";
+            return 1;
+        }
+        file << json;
+    }
+    return 0;
+}
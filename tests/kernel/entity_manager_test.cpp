@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <set>
+#include <thread>
 #include <vector>
 
 #include "../test_framework.h"
@@ -380,6 +381,214 @@ TEST(EntityManager, StressTest) {
     ASSERT_EQ(actual_alive, manager.alive_count());
 }
 
+// ========================================
+// 并发预留测试
+// ========================================
+
+TEST(EntityManager, ReserveMaterializesAtSyncPoint) {
+    EntityManager manager;
+    EntityId created = manager.create();
+
+    EntityId reserved = manager.reserve_id();
+    ASSERT_TRUE(reserved.is_valid());
+    ASSERT_NE(reserved, created);
+    ASSERT_TRUE(manager.has_pending_reservations());
+    ASSERT_FALSE(manager.is_alive(reserved));
+
+    manager.materialize_reserved();
+    ASSERT_FALSE(manager.has_pending_reservations());
+    ASSERT_TRUE(manager.is_alive(reserved));
+    ASSERT_EQ(manager.alive_count(), 2u);
+}
+
+TEST(EntityManager, ReserveRange) {
+    EntityManager manager;
+    auto range = manager.reserve_range(10);
+    ASSERT_EQ(range.count, 10u);
+
+    // create() 自动 materialize，不会与预留的索引冲突
+    EntityId created = manager.create();
+    ASSERT_GE(created.index(), range.first + 10u);
+
+    for (std::size_t i = 0; i < range.count; ++i) {
+        ASSERT_TRUE(manager.is_alive(range[i]));
+    }
+    ASSERT_EQ(manager.alive_count(), 11u);
+}
+
+TEST(EntityManager, ReserverRecyclesAndReturns) {
+    EntityManager manager;
+    std::vector<EntityId> old;
+    for (int i = 0; i < 4; ++i) {
+        old.push_back(manager.create());
+    }
+    for (const auto& id : old) {
+        manager.destroy(id);
+    }
+
+    std::vector<EntityId> reserved(2);
+    {
+        EntityManager::Reserver reserver(manager, 8);
+        reserver.reserve_ids(reserved);
+        ASSERT_EQ(reserver.reserved_count(), 2u);
+    }  // 析构时归还其余 6 个
+
+    manager.materialize_reserved();
+    ASSERT_EQ(manager.alive_count(), 2u);
+    for (const auto& id : reserved) {
+        ASSERT_TRUE(manager.is_alive(id));
+        ASSERT_EQ(id.generation(), 2u);  // 复用索引带新版本号
+    }
+    for (const auto& id : old) {
+        ASSERT_FALSE(manager.is_alive(id));
+    }
+
+    // 归还的 ID 可再次被 create() 使用
+    std::set<EntityId::IndexType> indices;
+    for (int i = 0; i < 6; ++i) {
+        indices.insert(manager.create().index());
+    }
+    ASSERT_EQ(manager.alive_count(), 8u);
+    ASSERT_EQ(indices.size(), 6u);
+}
+
+TEST(EntityManager, ConcurrentReservation) {
+    EntityManager manager;
+    for (int i = 0; i < 100; ++i) {
+        manager.destroy(manager.create());
+    }
+
+    constexpr std::size_t kThreads = 4;
+    constexpr std::size_t kPerThread = 5000;
+    std::vector<std::vector<EntityId>> results(kThreads);
+
+    std::vector<std::thread> workers;
+    for (std::size_t t = 0; t < kThreads; ++t) {
+        workers.emplace_back([&, t]() {
+            EntityManager::Reserver reserver(manager);
+            for (std::size_t i = 0; i < kPerThread; ++i) {
+                results[t].push_back(reserver.reserve_id());
+            }
+            auto range = manager.reserve_range(16);
+            for (std::size_t i = 0; i < range.count; ++i) {
+                results[t].push_back(range[i]);
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    manager.materialize_reserved();
+
+    std::set<EntityId::IndexType> indices;
+    for (const auto& ids : results) {
+        for (const auto& id : ids) {
+            ASSERT_TRUE(manager.is_alive(id));
+            indices.insert(id.index());
+        }
+    }
+    ASSERT_EQ(indices.size(), kThreads * (kPerThread + 16));
+    ASSERT_EQ(manager.alive_count(), kThreads * (kPerThread + 16));
+}
+
+TEST(EntityManager, CreateConcurrentWithReservation) {
+    EntityManager manager;
+    for (int i = 0; i < 200; ++i) {
+        manager.destroy(manager.create());
+    }
+
+    constexpr std::size_t kThreads = 3;
+    constexpr std::size_t kPerThread = 3000;
+    std::vector<std::vector<EntityId>> results(kThreads);
+
+    std::vector<std::thread> workers;
+    for (std::size_t t = 0; t < kThreads; ++t) {
+        workers.emplace_back([&, t]() {
+            EntityManager::Reserver reserver(manager, 16);
+            for (std::size_t i = 0; i < kPerThread; ++i) {
+                results[t].push_back(i % 2 == 0 ? reserver.reserve_id() : manager.reserve_id());
+            }
+        });
+    }
+
+    // 拥有者线程同时创建与销毁实体，与工作线程争用空闲列表和新索引
+    std::vector<EntityId> created;
+    for (std::size_t i = 0; i < kPerThread; ++i) {
+        created.push_back(manager.create());
+        if (i % 4 == 0) {
+            manager.destroy(created.back());
+            created.pop_back();
+        }
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    manager.materialize_reserved();
+
+    std::set<EntityId::IndexType> indices;
+    for (const auto& id : created) {
+        ASSERT_TRUE(manager.is_alive(id));
+        indices.insert(id.index());
+    }
+    for (const auto& ids : results) {
+        for (const auto& id : ids) {
+            ASSERT_TRUE(manager.is_alive(id));
+            indices.insert(id.index());
+        }
+    }
+    ASSERT_EQ(indices.size(), created.size() + kThreads * kPerThread);
+    ASSERT_EQ(manager.alive_count(), indices.size());
+}
+
+TEST(EntityManager, CreateInterleavedWithFreshReservations) {
+    // 空闲列表为空：每次 create() 都在预留者划出新索引的间隙里 materialize，
+    // 任何一次预留被漏记都会表现为 is_alive 失败或存活计数偏小
+    constexpr int kRounds = 20;
+    constexpr std::size_t kThreads = 2;
+    constexpr std::size_t kPerThread = 2000;
+
+    for (int round = 0; round < kRounds; ++round) {
+        EntityManager manager;
+        std::vector<std::vector<EntityId>> results(kThreads);
+
+        std::vector<std::thread> workers;
+        for (std::size_t t = 0; t < kThreads; ++t) {
+            workers.emplace_back([&, t]() {
+                for (std::size_t i = 0; i < kPerThread; ++i) {
+                    if (i % 2 == 0) {
+                        results[t].push_back(manager.reserve_id());
+                    } else {
+                        results[t].push_back(manager.reserve_range(1)[0]);
+                    }
+                }
+            });
+        }
+
+        std::vector<EntityId> created;
+        for (std::size_t i = 0; i < kPerThread; ++i) {
+            created.push_back(manager.create());
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+
+        manager.materialize_reserved();
+
+        for (const auto& id : created) {
+            ASSERT_TRUE(manager.is_alive(id));
+        }
+        for (const auto& ids : results) {
+            for (const auto& id : ids) {
+                ASSERT_TRUE(manager.is_alive(id));
+            }
+        }
+        ASSERT_EQ(manager.alive_count(), created.size() + kThreads * kPerThread);
+        ASSERT_FALSE(manager.has_pending_reservations());
+    }
+}
+
 // ========================================
 // 主函数
 // ========================================
@@ -2,7 +2,12 @@
 
 #include <atomic>
 #include <chrono>
+#include <cstdint>
+#include <cstring>
 #include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <string>
 #include <thread>
 #include <vector>
 
@@ -23,6 +28,8 @@ TEST(PoolConfigTests, DefaultConfig) {
     ASSERT_EQ(config.max_chunks, 0);
     ASSERT_TRUE(config.thread_safe);
     ASSERT_FALSE(config.enable_debug);
+    ASSERT_EQ(config.magazine_size, 0);
+    ASSERT_TRUE(config.backend == PageBackend::Heap);
 }
 
 TEST(PoolConfigTests, ValidConfig) {
@@ -214,6 +221,82 @@ TEST(FixedPoolTests, MoveConstruction) {
     pool2.deallocate(ptr);
 }
 
+TEST(FixedPoolTests, ShrinkKeepsPartiallyUsedChunks) {
+    PoolConfig config{
+        .block_size = 64,
+        .chunk_size = 4096,
+        .initial_chunks = 0,
+        .thread_safe = false,
+    };
+
+    FixedPool pool(config);
+    std::vector<void*> ptrs;
+    for (int i = 0; i < 500; ++i) {
+        ptrs.push_back(pool.allocate());
+    }
+    const std::size_t chunks = pool.chunk_count();
+    ASSERT_GT(chunks, 4);
+
+    // 释放前 3 个 Chunk 之外的所有块
+    const std::size_t per_chunk = pool.total_blocks() / chunks;
+    const std::size_t kept = per_chunk * 3;
+    for (std::size_t i = kept; i < ptrs.size(); ++i) {
+        pool.deallocate(ptrs[i]);
+    }
+
+    pool.shrink_to_fit();
+    ASSERT_EQ(pool.chunk_count(), 3);
+    ASSERT_EQ(pool.used_blocks(), kept);
+    ASSERT_EQ(pool.free_blocks(), 0);
+
+    // 仍被占用的块可以正常释放并重新分配
+    for (std::size_t i = 0; i < kept; ++i) {
+        pool.deallocate(ptrs[i]);
+    }
+    ASSERT_EQ(pool.used_blocks(), 0);
+    void* ptr = pool.allocate();
+    ASSERT_NE(ptr, nullptr);
+    pool.deallocate(ptr);
+}
+
+TEST(FixedPoolTests, ShrinkLargePoolIsFast) {
+    PoolConfig config{
+        .block_size = 64,
+        .chunk_size = 4096,
+        .initial_chunks = 0,
+        .thread_safe = false,
+    };
+
+    FixedPool pool(config);
+    std::vector<void*> ptrs;
+    for (int i = 0; i < 200000; ++i) {
+        ptrs.push_back(pool.allocate());
+    }
+    // 交错释放：一半 Chunk 完全空闲，一半保留一个块
+    const std::size_t per_chunk = pool.total_blocks() / pool.chunk_count();
+    for (std::size_t i = 0; i < ptrs.size(); ++i) {
+        const std::size_t chunk = i / per_chunk;
+        if (chunk % 2 == 0 || i % per_chunk != 0) {
+            pool.deallocate(ptrs[i]);
+            ptrs[i] = nullptr;
+        }
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    pool.shrink_to_fit();
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    ASSERT_LT(std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count(), 500);
+    std::size_t live = 0;
+    for (void* ptr : ptrs) {
+        if (ptr) {
+            ++live;
+            pool.deallocate(ptr);
+        }
+    }
+    ASSERT_EQ(pool.chunk_count(), live);
+}
+
 // ========================================
 // FixedPool 多线程测试
 // ========================================
@@ -257,6 +340,337 @@ TEST(FixedPoolTests, ConcurrentAllocations) {
     ASSERT_EQ(pool.used_blocks(), 0);
 }
 
+TEST(FixedPoolTests, MagazineStats) {
+    PoolConfig config{
+        .block_size = 64,
+        .chunk_size = 4096,
+        .thread_safe = true,
+        .magazine_size = 8,
+    };
+
+    FixedPool pool(config);
+    std::vector<void*> ptrs;
+    for (int i = 0; i < 20; ++i) {
+        void* ptr = pool.allocate();
+        ASSERT_NE(ptr, nullptr);
+        ptrs.push_back(ptr);
+    }
+    ASSERT_EQ(pool.used_blocks(), 20);
+
+    for (void* ptr : ptrs) {
+        pool.deallocate(ptr);
+    }
+    // 缓存在弹匣中的块仍计入空闲块
+    ASSERT_EQ(pool.used_blocks(), 0);
+    ASSERT_EQ(pool.free_blocks(), pool.total_blocks());
+
+    auto stats = pool.stats();
+    ASSERT_EQ(stats.allocation_count, 20);
+    ASSERT_EQ(stats.deallocation_count, 20);
+    ASSERT_EQ(stats.used_memory, 0);
+}
+
+TEST(FixedPoolTests, MagazineFlushAndShrink) {
+    PoolConfig config{
+        .block_size = 64,
+        .chunk_size = 4096,
+        .initial_chunks = 0,
+        .thread_safe = true,
+        .magazine_size = 16,
+    };
+
+    FixedPool pool(config);
+    std::vector<void*> ptrs;
+    for (int i = 0; i < 200; ++i) {
+        ptrs.push_back(pool.allocate());
+    }
+    ASSERT_GT(pool.chunk_count(), 1);
+    for (void* ptr : ptrs) {
+        pool.deallocate(ptr);
+    }
+
+    pool.flush_thread_cache();
+    ASSERT_EQ(pool.free_blocks(), pool.total_blocks());
+
+    // 弹匣清空后所有 Chunk 都可回收
+    pool.shrink_to_fit();
+    ASSERT_EQ(pool.chunk_count(), 0);
+
+    // 回收后仍可继续分配
+    void* ptr = pool.allocate();
+    ASSERT_NE(ptr, nullptr);
+    pool.deallocate(ptr);
+}
+
+TEST(FixedPoolTests, MagazineConcurrentAllocations) {
+    PoolConfig config{
+        .block_size = 64,
+        .chunk_size = 64 * 1024,
+        .thread_safe = true,
+        .magazine_size = kDefaultMagazineSize,
+    };
+
+    FixedPool pool(config);
+    constexpr int num_threads = 4;
+    constexpr int rounds = 50;
+    constexpr int allocs_per_round = 100;
+
+    std::atomic<int> failures{0};
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < num_threads; ++t) {
+        threads.emplace_back([&pool, &failures, t]() {
+            std::vector<int*> ptrs;
+            for (int r = 0; r < rounds; ++r) {
+                for (int i = 0; i < allocs_per_round; ++i) {
+                    auto* ptr = static_cast<int*>(pool.allocate());
+                    if (!ptr) {
+                        failures.fetch_add(1, std::memory_order_relaxed);
+                        continue;
+                    }
+                    *ptr = t;
+                    ptrs.push_back(ptr);
+                }
+                for (int* ptr : ptrs) {
+                    if (*ptr != t) {
+                        failures.fetch_add(1, std::memory_order_relaxed);
+                    }
+                    pool.deallocate(ptr);
+                }
+                ptrs.clear();
+            }
+        });
+    }
+
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    // 线程退出时弹匣已归还池中
+    ASSERT_EQ(failures.load(), 0);
+    ASSERT_EQ(pool.used_blocks(), 0);
+    ASSERT_EQ(pool.free_blocks(), pool.total_blocks());
+    ASSERT_EQ(pool.stats().allocation_count, num_threads * rounds * allocs_per_round);
+}
+
+TEST(FixedPoolTests, MagazineOutlivesPool) {
+    PoolConfig config{
+        .block_size = 64,
+        .chunk_size = 4096,
+        .thread_safe = true,
+        .magazine_size = 8,
+    };
+
+    std::atomic<int> stage{0};
+    auto pool = std::make_unique<FixedPool>(config);
+
+    // 工作线程在池析构之后才退出
+    std::thread worker([&pool, &stage]() {
+        void* ptr = pool->allocate();
+        pool->deallocate(ptr);
+        stage.store(1, std::memory_order_release);
+        while (stage.load(std::memory_order_acquire) != 2) {
+            std::this_thread::yield();
+        }
+    });
+
+    while (stage.load(std::memory_order_acquire) != 1) {
+        std::this_thread::yield();
+    }
+    pool.reset();
+    stage.store(2, std::memory_order_release);
+    worker.join();
+
+    // 同一线程上新建的池不会误用旧弹匣
+    FixedPool other(config);
+    void* ptr = other.allocate();
+    ASSERT_NE(ptr, nullptr);
+    other.deallocate(ptr);
+    ASSERT_EQ(other.used_blocks(), 0);
+}
+
+TEST(FixedPoolTests, VirtualMemoryBackend) {
+    PoolConfig config{
+        .block_size = 64,
+        .chunk_size = 64 * 1024,
+        .initial_chunks = 0,
+        .backend = PageBackend::VirtualMemory,
+    };
+
+    FixedPool pool(config);
+    std::vector<void*> ptrs;
+    for (int i = 0; i < 2000; ++i) {
+        void* ptr = pool.allocate();
+        ASSERT_NE(ptr, nullptr);
+        std::memset(ptr, 0xCD, 64);
+        ptrs.push_back(ptr);
+    }
+    ASSERT_GT(pool.chunk_count(), 1);
+
+    for (void* ptr : ptrs) {
+        pool.deallocate(ptr);
+    }
+    pool.shrink_to_fit();
+    ASSERT_EQ(pool.chunk_count(), 0);
+
+    // HugePages 后端在 Chunk 小于大页时退化为普通页映射
+    config.backend = PageBackend::HugePages;
+    FixedPool huge_pool(config);
+    void* ptr = huge_pool.allocate();
+    ASSERT_NE(ptr, nullptr);
+    huge_pool.deallocate(ptr);
+}
+
+TEST(FixedPoolTests, LockFreeModeBasic) {
+    PoolConfig config{
+        .block_size = 32,
+        .block_alignment = 8,
+        .chunk_size = 4096,
+        .initial_chunks = 0,
+        .max_chunks = 2,
+        .lock_free = true,
+    };
+
+    FixedPool pool(config);
+    ASSERT_TRUE(pool.config().thread_safe);
+
+    // 耗尽两个 Chunk 后分配失败
+    std::vector<void*> ptrs;
+    while (void* ptr = pool.allocate()) {
+        std::memset(ptr, 0xAB, 32);
+        ptrs.push_back(ptr);
+    }
+    ASSERT_EQ(pool.chunk_count(), 2);
+    ASSERT_EQ(ptrs.size(), pool.total_blocks());
+    ASSERT_EQ(pool.free_blocks(), 0);
+
+    PoolStats stats = pool.stats();
+    ASSERT_EQ(stats.allocation_count, ptrs.size());
+    ASSERT_EQ(stats.peak_memory, ptrs.size() * 32);
+
+    for (void* ptr : ptrs) {
+        pool.deallocate(ptr);
+    }
+    ASSERT_EQ(pool.used_blocks(), 0);
+    ASSERT_EQ(pool.stats().deallocation_count, ptrs.size());
+
+    // 释放的块可再次分配
+    void* ptr = pool.allocate();
+    ASSERT_NE(ptr, nullptr);
+    pool.deallocate(ptr);
+
+    pool.shrink_to_fit();
+    ASSERT_EQ(pool.chunk_count(), 0);
+    ASSERT_EQ(pool.total_blocks(), 0);
+
+    // 回收后仍可扩容
+    ptr = pool.allocate();
+    ASSERT_NE(ptr, nullptr);
+    ASSERT_EQ(pool.chunk_count(), 1);
+    pool.deallocate(ptr);
+}
+
+TEST(FixedPoolTests, LockFreeModeResetAndMove) {
+    PoolConfig config{
+        .block_size = 64,
+        .chunk_size = 4096,
+        .lock_free = true,
+    };
+
+    FixedPool pool(config);
+    const std::size_t total = pool.total_blocks();
+    for (int i = 0; i < 10; ++i) {
+        (void)pool.allocate();
+    }
+    ASSERT_EQ(pool.used_blocks(), 10);
+
+    pool.reset();
+    ASSERT_EQ(pool.used_blocks(), 0);
+    ASSERT_EQ(pool.free_blocks(), total);
+
+    void* ptr = pool.allocate();
+    FixedPool moved(std::move(pool));
+    ASSERT_EQ(moved.used_blocks(), 1);
+    ASSERT_EQ(moved.free_blocks(), total - 1);
+    ASSERT_EQ(pool.total_blocks(), 0);
+
+    moved.deallocate(ptr);
+    std::vector<void*> ptrs;
+    for (std::size_t i = 0; i < total; ++i) {
+        ptrs.push_back(moved.allocate());
+        ASSERT_NE(ptrs.back(), nullptr);
+    }
+    ASSERT_EQ(moved.chunk_count(), 1);
+    for (void* p : ptrs) {
+        moved.deallocate(p);
+    }
+}
+
+TEST(FixedPoolTests, LockFreeConcurrentProducerConsumer) {
+    PoolConfig config{
+        .block_size = 64,
+        .chunk_size = 16 * 1024,
+        .initial_chunks = 0,
+        .lock_free = true,
+    };
+
+    FixedPool pool(config);
+    constexpr int num_pairs = 4;
+    constexpr int items_per_producer = 20000;
+
+    // 生产者分配并写入标记，消费者校验后在另一线程释放
+    std::vector<std::unique_ptr<LockFreeStack>> queues;
+    for (int i = 0; i < num_pairs; ++i) {
+        queues.push_back(std::make_unique<LockFreeStack>());
+    }
+
+    std::atomic<int> corrupted{0};
+    std::atomic<int> consumed{0};
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < num_pairs; ++t) {
+        threads.emplace_back([&, t]() {
+            for (int i = 0; i < items_per_producer; ++i) {
+                void* ptr = pool.allocate();
+                if (!ptr) {
+                    corrupted.fetch_add(1, std::memory_order_relaxed);
+                    continue;
+                }
+                auto* payload = static_cast<std::uint64_t*>(ptr);
+                payload[1] = static_cast<std::uint64_t>(t) << 32 | static_cast<std::uint32_t>(i);
+                payload[2] = ~payload[1];
+                queues[t]->push(static_cast<LockFreeNode*>(ptr));
+            }
+        });
+        threads.emplace_back([&, t]() {
+            int local = 0;
+            while (local < items_per_producer) {
+                LockFreeNode* node = queues[t]->pop();
+                if (!node) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                const auto* payload = reinterpret_cast<const std::uint64_t*>(node);
+                if (payload[2] != ~payload[1] || (payload[1] >> 32) != static_cast<std::uint64_t>(t)) {
+                    corrupted.fetch_add(1, std::memory_order_relaxed);
+                }
+                pool.deallocate(node);
+                ++local;
+            }
+            consumed.fetch_add(local, std::memory_order_relaxed);
+        });
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    ASSERT_EQ(corrupted.load(), 0);
+    ASSERT_EQ(consumed.load(), num_pairs * items_per_producer);
+    ASSERT_EQ(pool.used_blocks(), 0);
+    ASSERT_EQ(pool.stats().allocation_count, static_cast<std::size_t>(num_pairs * items_per_producer));
+}
+
 // ========================================
 // ObjectPool 测试
 // ========================================
@@ -362,6 +776,114 @@ TEST(ObjectPoolTests, ConcurrentCreateDestroy) {
     ASSERT_EQ(pool.size(), 0);
 }
 
+// ========================================
+// HandlePool 测试
+// ========================================
+
+TEST(HandlePoolTests, CreateGetDestroy) {
+    static_assert(sizeof(PoolHandle<std::string>) == 4);
+
+    HandlePool<std::string> pool;
+    PoolHandle<std::string> a = pool.create("alpha");
+    PoolHandle<std::string> b = pool.create("beta");
+
+    ASSERT_TRUE(a.is_valid());
+    ASSERT_NE(a, b);
+    ASSERT_EQ(pool.size(), 2);
+    ASSERT_EQ(*pool.get(a), "alpha");
+    ASSERT_EQ(*pool.get(b), "beta");
+
+    ASSERT_TRUE(pool.destroy(a));
+    ASSERT_FALSE(pool.contains(a));
+    ASSERT_EQ(pool.get(a), nullptr);
+    ASSERT_FALSE(pool.destroy(a));  // 重复销毁被拒绝
+    ASSERT_EQ(*pool.get(b), "beta");
+
+    ASSERT_FALSE(pool.contains(PoolHandle<std::string>{}));
+}
+
+TEST(HandlePoolTests, StaleHandleAfterSlotReuse) {
+    HandlePool<int> pool;
+    PoolHandle<int> old_handle = pool.create(1);
+    ASSERT_TRUE(pool.destroy(old_handle));
+
+    // 复用同一槽位，但版本号不同
+    PoolHandle<int> new_handle = pool.create(2);
+    ASSERT_EQ(new_handle.index(), old_handle.index());
+    ASSERT_NE(new_handle.generation(), old_handle.generation());
+    ASSERT_FALSE(pool.contains(old_handle));
+    ASSERT_EQ(*pool.get(new_handle), 2);
+}
+
+TEST(HandlePoolTests, DenseStorageStaysPacked) {
+    HandlePool<int> pool;
+    std::vector<PoolHandle<int>> handles;
+    for (int i = 0; i < 100; ++i) {
+        handles.push_back(pool.create(i));
+    }
+
+    // 销毁偶数对象后稠密数组仍然连续，句柄仍指向正确对象
+    for (int i = 0; i < 100; i += 2) {
+        ASSERT_TRUE(pool.destroy(handles[i]));
+    }
+    ASSERT_EQ(pool.size(), 50);
+    ASSERT_EQ(pool.values().size(), 50);
+
+    int sum = 0;
+    for (int value : pool.values()) {
+        ASSERT_EQ(value % 2, 1);
+        sum += value;
+    }
+    ASSERT_EQ(sum, 2500);
+
+    for (int i = 1; i < 100; i += 2) {
+        ASSERT_EQ(*pool.get(handles[i]), i);
+    }
+
+    // for_each 提供的句柄与对象一致
+    pool.for_each([&](PoolHandle<int> handle, int& value) { ASSERT_EQ(pool.get(handle), &value); });
+    for (std::size_t i = 0; i < pool.size(); ++i) {
+        ASSERT_EQ(*pool.get(pool.handle_at(i)), pool.values()[i]);
+    }
+}
+
+TEST(HandlePoolTests, ClearInvalidatesHandles) {
+    HandlePool<std::unique_ptr<int>> pool;
+    PoolHandle<std::unique_ptr<int>> a = pool.create(std::make_unique<int>(1));
+    PoolHandle<std::unique_ptr<int>> b = pool.create(std::make_unique<int>(2));
+
+    pool.clear();
+    ASSERT_TRUE(pool.empty());
+    ASSERT_FALSE(pool.contains(a));
+    ASSERT_FALSE(pool.contains(b));
+
+    PoolHandle<std::unique_ptr<int>> c = pool.create(std::make_unique<int>(3));
+    ASSERT_EQ(**pool.get(c), 3);
+}
+
+TEST(HandlePoolTests, ExhaustedGenerationRetiresSlot) {
+    HandlePool<int> pool;
+    PoolHandle<int> first = pool.create(0);
+    const auto index = first.index();
+    ASSERT_TRUE(pool.destroy(first));
+
+    // 反复复用同一槽位直到版本号耗尽
+    PoolHandle<int> handle;
+    for (;;) {
+        handle = pool.create(0);
+        if (handle.index() != index) {
+            break;
+        }
+        ASSERT_TRUE(pool.destroy(handle));
+    }
+
+    // 退役的槽位不再复用，任何旧句柄都不会误命中
+    ASSERT_EQ(pool.retired_slots(), 1);
+    ASSERT_FALSE(pool.contains(PoolHandle<int>(index, PoolHandle<int>::kMaxGeneration)));
+    ASSERT_FALSE(pool.contains(first));
+    ASSERT_TRUE(pool.contains(handle));
+}
+
 // ========================================
 // LinearArena 测试
 // ========================================
@@ -468,6 +990,131 @@ TEST(LinearArenaTests, MoveConstruction) {
     ASSERT_EQ(arena1.capacity(), 0);
 }
 
+TEST(LinearArenaTests, GrowableChaining) {
+    LinearArena arena(256, true);
+    ASSERT_TRUE(arena.growable());
+
+    std::vector<void*> ptrs;
+    for (int i = 0; i < 64; ++i) {
+        void* ptr = arena.allocate(100);
+        ASSERT_NE(ptr, nullptr);
+        std::memset(ptr, i, 100);
+        ptrs.push_back(ptr);
+    }
+    ASSERT_GT(arena.chained_block_count(), 0);
+    ASSERT_GE(arena.used(), 64 * 100);
+    ASSERT_GE(arena.capacity(), arena.used());
+
+    // 超过默认块大小的请求得到足够大的追加块
+    void* big = arena.allocate(4096, 256);
+    ASSERT_NE(big, nullptr);
+    ASSERT_TRUE(is_aligned(big, 256));
+    ASSERT_TRUE(arena.owns(big));
+
+    for (int i = 0; i < 64; ++i) {
+        ASSERT_EQ(static_cast<unsigned char*>(ptrs[i])[99], static_cast<unsigned char>(i));
+    }
+}
+
+TEST(LinearArenaTests, GrowableReusesCachedBlocks) {
+    LinearArena arena(1024, true);
+    for (int i = 0; i < 16; ++i) {
+        (void)arena.allocate(512);
+    }
+    const std::size_t chained = arena.chained_block_count();
+    ASSERT_GT(chained, 0);
+
+    // reset 后追加块进入块缓存，再次溢出时复用而不是重新分配
+    arena.reset();
+    ASSERT_EQ(arena.chained_block_count(), 0);
+    ASSERT_EQ(arena.cached_block_count(), chained);
+    ASSERT_EQ(arena.used(), 0);
+
+    for (int i = 0; i < 16; ++i) {
+        (void)arena.allocate(512);
+    }
+    ASSERT_EQ(arena.chained_block_count(), chained);
+    ASSERT_EQ(arena.cached_block_count(), 0);
+
+    arena.reset();
+    arena.release_cached_blocks();
+    ASSERT_EQ(arena.cached_block_count(), 0);
+    ASSERT_EQ(arena.capacity(), 1024);
+}
+
+TEST(LinearArenaTests, MarkAndRewind) {
+    LinearArena arena(4096);
+    (void)arena.allocate(100);
+    auto marker = arena.mark();
+    const std::size_t used_at_mark = arena.used();
+
+    void* scratch = arena.allocate(1000);
+    ASSERT_NE(scratch, nullptr);
+    arena.rewind(marker);
+    ASSERT_EQ(arena.used(), used_at_mark);
+
+    // 回退后同一位置被重新使用
+    ASSERT_EQ(arena.allocate(1000), scratch);
+}
+
+TEST(LinearArenaTests, NestedScopesAcrossBlocks) {
+    LinearArena arena(256, true);
+    (void)arena.allocate(64);
+    const std::size_t base_used = arena.used();
+    {
+        LinearArena::Scope outer(arena);
+        for (int i = 0; i < 8; ++i) {
+            (void)arena.allocate(200);
+        }
+        const std::size_t outer_used = arena.used();
+        const std::size_t outer_blocks = arena.chained_block_count();
+        {
+            LinearArena::Scope inner(arena);
+            for (int i = 0; i < 8; ++i) {
+                (void)arena.allocate(200);
+            }
+            ASSERT_GT(arena.chained_block_count(), outer_blocks);
+        }
+        ASSERT_EQ(arena.used(), outer_used);
+        ASSERT_EQ(arena.chained_block_count(), outer_blocks);
+    }
+    ASSERT_EQ(arena.used(), base_used);
+    ASSERT_EQ(arena.chained_block_count(), 0);
+    ASSERT_GT(arena.cached_block_count(), 0);
+}
+
+TEST(LinearArenaTests, VirtualMemoryLazyCommit) {
+    constexpr std::size_t kCapacity = 16 * 1024 * 1024;
+    LinearArena arena(kCapacity, false, PageBackend::VirtualMemory);
+    if (!virtual_memory_supported()) {
+        ASSERT_TRUE(arena.backend() == PageBackend::Heap);
+        return;
+    }
+    ASSERT_TRUE(arena.backend() == PageBackend::VirtualMemory);
+    ASSERT_EQ(arena.capacity(), kCapacity);
+
+    // 只提交实际使用的页
+    void* small = arena.allocate(128);
+    ASSERT_NE(small, nullptr);
+    ASSERT_LT(arena.committed(), kCapacity);
+
+    void* large = arena.allocate(4 * 1024 * 1024);
+    ASSERT_NE(large, nullptr);
+    std::memset(large, 0xAB, 4 * 1024 * 1024);
+    const std::size_t committed = arena.committed();
+    ASSERT_GE(committed, arena.used());
+
+    // 重置后归还多余的页
+    arena.reset();
+    arena.shrink_to_fit();
+    ASSERT_LT(arena.committed(), committed);
+
+    // 归还后的页可以重新分配
+    auto* bytes = static_cast<unsigned char*>(arena.allocate(1024 * 1024));
+    ASSERT_NE(bytes, nullptr);
+    bytes[1024 * 1024 - 1] = 1;
+}
+
 // ========================================
 // FrameArena 测试
 // ========================================
@@ -555,6 +1202,185 @@ TEST(FrameArenaTests, ResetAll) {
     ASSERT_EQ(arena.current_index(), 0);
 }
 
+TEST(FrameArenaTests, TripleBuffering) {
+    FrameArena arena(FrameArenaConfig{.buffer_size = 4096, .buffer_count = 3});
+    ASSERT_EQ(arena.buffer_count(), 3);
+
+    arena.begin_frame();
+    int* frame1 = arena.create<int>(1);
+    arena.end_frame();
+
+    arena.begin_frame();
+    int* frame2 = arena.create<int>(2);
+    arena.end_frame();
+
+    // 三缓冲：两帧之前的数据仍然有效
+    arena.begin_frame();
+    ASSERT_EQ(*frame1, 1);
+    ASSERT_EQ(*frame2, 2);
+    ASSERT_TRUE(arena.frame_buffer(2).owns(frame1));
+    ASSERT_TRUE(arena.previous().owns(frame2));
+    arena.end_frame();
+
+    // 轮转一周后回到第一个缓冲区
+    ASSERT_EQ(arena.current_index(), 0);
+}
+
+TEST(FrameArenaTests, ThreadSubArenas) {
+    FrameArena arena(FrameArenaConfig{
+        .buffer_size = 4096,
+        .thread_buffer_size = 1024 * 1024,
+        .thread_block_size = 4096,
+    });
+
+    constexpr int num_threads = 8;
+    constexpr int allocs_per_thread = 1000;
+
+    for (int frame = 0; frame < 3; ++frame) {
+        arena.begin_frame();
+
+        std::atomic<int> failures{0};
+        std::vector<std::thread> threads;
+        for (int t = 0; t < num_threads; ++t) {
+            threads.emplace_back([&arena, &failures, t]() {
+                std::vector<std::uint64_t*> values;
+                for (int i = 0; i < allocs_per_thread; ++i) {
+                    auto* value = arena.thread_create<std::uint64_t>(static_cast<std::uint64_t>(t) << 32 | i);
+                    values.push_back(value);
+                }
+                for (int i = 0; i < allocs_per_thread; ++i) {
+                    if (*values[i] != (static_cast<std::uint64_t>(t) << 32 | i) || !arena.owns(values[i])) {
+                        failures.fetch_add(1, std::memory_order_relaxed);
+                    }
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        ASSERT_EQ(failures.load(), 0);
+        ASSERT_GT(arena.current_thread_used(), 0);
+        arena.end_frame();
+    }
+
+    // begin_frame 同时重置所有线程的子分配器
+    arena.begin_frame();
+    ASSERT_EQ(arena.current_thread_used(), 0);
+    void* ptr = arena.thread_allocate(64);
+    ASSERT_NE(ptr, nullptr);
+    ASSERT_EQ(arena.current_thread_used(), 4096);
+}
+
+TEST(FrameArenaTests, HugePageBackend) {
+    FrameArena arena(FrameArenaConfig{
+        .buffer_size = 4 * 1024 * 1024,
+        .backend = PageBackend::HugePages,
+    });
+
+    arena.begin_frame();
+    auto* data = static_cast<std::uint64_t*>(arena.allocate(1024 * 1024, 64));
+    ASSERT_NE(data, nullptr);
+    data[0] = 42;
+    data[1024 * 1024 / sizeof(std::uint64_t) - 1] = 7;
+    arena.end_frame();
+
+    ASSERT_EQ(arena.previous().used(), 1024 * 1024);
+    ASSERT_EQ(data[0], 42);
+}
+
+TEST(FrameArenaTests, ThreadRegionExhausted) {
+    // 未启用线程区域
+    FrameArena disabled(4096);
+    ASSERT_EQ(disabled.thread_allocate(16), nullptr);
+
+    FrameArena arena(FrameArenaConfig{
+        .buffer_size = 4096,
+        .thread_buffer_size = 8192,
+        .thread_block_size = 4096,
+    });
+    int allocated = 0;
+    while (arena.thread_allocate(1000)) {
+        ++allocated;
+    }
+    ASSERT_GT(allocated, 0);
+    ASSERT_LE(allocated * 1000, 8192);
+}
+
+// ========================================
+// pmr 适配器测试
+// ========================================
+
+TEST(ArenaResourceTests, VectorFromArena) {
+    LinearArena arena(64 * 1024);
+    ArenaResource resource(arena);
+
+    std::pmr::vector<int> values(&resource);
+    for (int i = 0; i < 100; ++i) {
+        values.push_back(i);
+    }
+    ASSERT_EQ(values[99], 99);
+    ASSERT_TRUE(arena.owns(values.data()));
+    ASSERT_GT(arena.used(), 100 * sizeof(int));
+}
+
+TEST(ArenaResourceTests, ExhaustedArena) {
+    LinearArena arena(256);
+
+    // 默认无后备资源：空间不足抛出 std::bad_alloc
+    ArenaResource strict(arena);
+    bool threw = false;
+    try {
+        (void)strict.allocate(1024);
+    } catch (const std::bad_alloc&) {
+        threw = true;
+    }
+    ASSERT_TRUE(threw);
+
+    // 有后备资源时转交上游，释放时归还上游
+    ArenaResource fallback(arena, std::pmr::new_delete_resource());
+    void* ptr = fallback.allocate(1024);
+    ASSERT_NE(ptr, nullptr);
+    ASSERT_FALSE(arena.owns(ptr));
+    fallback.deallocate(ptr, 1024);
+}
+
+TEST(FrameArenaResourceTests, PerFrameContainers) {
+    FrameArena frame_arena(64 * 1024);
+    FrameArenaResource resource(frame_arena);
+
+    for (int frame = 0; frame < 4; ++frame) {
+        frame_arena.begin_frame();
+        {
+            FrameVector<int> values(&resource);
+            FrameString text("per-frame string that does not fit the small buffer", &resource);
+            FrameMap<int, int> ordered(&resource);
+            FrameUnorderedMap<int, int> hashed(&resource);
+            for (int i = 0; i < 64; ++i) {
+                values.push_back(i);
+                ordered[i] = i * frame;
+                hashed[i] = i + frame;
+            }
+
+            ASSERT_TRUE(frame_arena.current().owns(values.data()));
+            ASSERT_TRUE(frame_arena.current().owns(text.data()));
+            ASSERT_EQ(ordered[63], 63 * frame);
+            ASSERT_EQ(hashed[63], 63 + frame);
+        }
+        ASSERT_GT(frame_arena.current_used(), 0);
+        frame_arena.end_frame();
+    }
+
+    // 上一帧的容器数据在本帧仍可读
+    frame_arena.begin_frame();
+    FrameVector<int> carried(&resource);
+    carried.assign({1, 2, 3});
+    frame_arena.end_frame();
+    frame_arena.begin_frame();
+    ASSERT_TRUE(frame_arena.previous().owns(carried.data()));
+    ASSERT_EQ(carried[2], 3);
+}
+
 // ========================================
 // LockFreeStack 测试
 // ========================================
@@ -663,6 +1489,89 @@ TEST(LockFreeStackTests, ConcurrentPushPop) {
     ASSERT_EQ(pop_count.load(), (num_threads / 2) * ops_per_thread);
 }
 
+TEST(LockFreeStackTests, PushListAndTakeAll) {
+    LockFreeStack stack;
+    LockFreeNode nodes[3];
+    nodes[0].next.store(&nodes[1]);
+    nodes[1].next.store(&nodes[2]);
+
+    stack.push_list(&nodes[0], &nodes[2]);
+    ASSERT_EQ(stack.approximate_size(), 3);
+    ASSERT_EQ(stack.pop(), &nodes[0]);
+
+    LockFreeNode* chain = stack.take_all();
+    ASSERT_EQ(chain, &nodes[1]);
+    ASSERT_EQ(chain->next.load(), &nodes[2]);
+    ASSERT_TRUE(stack.empty());
+}
+
+TEST(LockFreeStackTests, TagAdvancesOnPop) {
+    LockFreeStack stack;
+    LockFreeNode node;
+
+    const std::uint64_t initial = stack.tag();
+    stack.push(&node);
+    ASSERT_EQ(stack.tag(), initial);  // push 不改变版本号
+
+    // 同一节点弹出后重新压入：栈顶指针相同，但版本号不同（ABA 防护）
+    ASSERT_EQ(stack.pop(), &node);
+    stack.push(&node);
+    ASSERT_EQ(stack.peek(), &node);
+    ASSERT_EQ(stack.tag(), initial + 1);
+}
+
+TEST(LockFreeStackTests, ConcurrentPopPushRecycling) {
+    // 少量节点在多个线程间反复弹出/压入，是最容易触发 ABA 的模式：
+    // 若 ABA 导致链表损坏，节点会丢失或重复出现
+    LockFreeStack stack;
+    constexpr int num_nodes = 4;
+    constexpr int num_threads = 8;
+    constexpr int iterations = 50000;
+
+    LockFreeNode nodes[num_nodes];
+    std::atomic<int> owners[num_nodes] = {};
+    for (auto& node : nodes) {
+        stack.push(&node);
+    }
+
+    std::atomic<int> duplicates{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < num_threads; ++t) {
+        threads.emplace_back([&]() {
+            for (int i = 0; i < iterations; ++i) {
+                LockFreeNode* node = stack.pop();
+                if (!node) {
+                    continue;
+                }
+                const auto index = static_cast<std::size_t>(node - nodes);
+                if (owners[index].fetch_add(1, std::memory_order_relaxed) != 0) {
+                    duplicates.fetch_add(1, std::memory_order_relaxed);
+                }
+                owners[index].fetch_sub(1, std::memory_order_relaxed);
+                stack.push(node);
+            }
+        });
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    ASSERT_EQ(duplicates.load(), 0);
+    ASSERT_EQ(stack.approximate_size(), num_nodes);
+
+    // 每个节点恰好出现一次
+    bool seen[num_nodes] = {};
+    while (LockFreeNode* node = stack.pop()) {
+        const auto index = static_cast<std::size_t>(node - nodes);
+        ASSERT_FALSE(seen[index]);
+        seen[index] = true;
+    }
+    for (bool value : seen) {
+        ASSERT_TRUE(value);
+    }
+}
+
 // ========================================
 // ThreadLocalPool 测试
 // ========================================
@@ -729,6 +1638,245 @@ TEST(ThreadLocalPoolTests, UniquePtr) {
     // 离开作用域自动销毁
 }
 
+/// 统计析构次数的测试对象
+struct CountedObject {
+    static inline std::atomic<int> destroyed{0};
+
+    explicit CountedObject(int v) : value(v) {}
+    ~CountedObject() { destroyed.fetch_add(1, std::memory_order_relaxed); }
+
+    int value;
+};
+
+TEST(ThreadLocalPoolTests, CrossThreadDestroyReturnsToOwner) {
+    using Pool = ThreadLocalPool<CountedObject>;
+    Pool::drain_remote_frees();
+    const int destroyed_before = CountedObject::destroyed.load();
+
+    std::vector<CountedObject*> objects;
+    for (int i = 0; i < 100; ++i) {
+        objects.push_back(Pool::create(i));
+    }
+    const std::size_t available = Pool::available();
+    ASSERT_EQ(Pool::size(), 100);
+
+    // 在其他线程销毁：对象析构，但内存排队等待所属线程回收
+    std::thread consumer([&objects] {
+        for (CountedObject* obj : objects) {
+            Pool::destroy(obj);
+        }
+    });
+    consumer.join();
+
+    ASSERT_EQ(CountedObject::destroyed.load(), destroyed_before + 100);
+    ASSERT_EQ(Pool::size(), 0);
+    ASSERT_EQ(Pool::available(), available);
+
+    // 下一次分配时整批回收
+    CountedObject* obj = Pool::create(7);
+    ASSERT_EQ(Pool::available(), available + 99);
+    Pool::destroy(obj);
+}
+
+TEST(ThreadLocalPoolTests, ObjectsOutliveOwnerThread) {
+    using Pool = ThreadLocalPool<CountedObject>;
+    const int destroyed_before = CountedObject::destroyed.load();
+
+    std::vector<CountedObject*> objects;
+    std::thread producer([&objects] {
+        for (int i = 0; i < 500; ++i) {
+            objects.push_back(Pool::create(i));
+        }
+        // 部分在所属线程销毁
+        for (int i = 0; i < 100; ++i) {
+            Pool::destroy(objects.back());
+            objects.pop_back();
+        }
+    });
+    producer.join();
+
+    // 所属线程已退出，剩余对象仍然有效，最后一个销毁时释放池
+    for (int i = 0; i < static_cast<int>(objects.size()); ++i) {
+        ASSERT_EQ(objects[i]->value, i);
+    }
+    for (CountedObject* obj : objects) {
+        Pool::destroy(obj);
+    }
+    ASSERT_EQ(CountedObject::destroyed.load(), destroyed_before + 500);
+}
+
+TEST(ThreadLocalPoolTests, ProducerConsumerHandoff) {
+    constexpr int kProducers = 4;
+    constexpr int kItemsPerProducer = 5000;
+
+    std::mutex mutex;
+    std::vector<ThreadLocalUniquePtr<TestObject>> queue;
+    std::atomic<int> producers_done{0};
+    std::atomic<long long> sum{0};
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < kProducers; ++p) {
+        threads.emplace_back([&] {
+            for (int i = 0; i < kItemsPerProducer; ++i) {
+                auto item = make_thread_local_unique<TestObject>(i, 0.0);
+                std::lock_guard<std::mutex> lock(mutex);
+                queue.push_back(std::move(item));
+            }
+            producers_done.fetch_add(1, std::memory_order_release);
+        });
+    }
+    for (int c = 0; c < 2; ++c) {
+        threads.emplace_back([&] {
+            while (true) {
+                ThreadLocalUniquePtr<TestObject> item;
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if (!queue.empty()) {
+                        item = std::move(queue.back());
+                        queue.pop_back();
+                    }
+                }
+                if (item) {
+                    sum.fetch_add(item->value, std::memory_order_relaxed);
+                } else if (producers_done.load(std::memory_order_acquire) == kProducers) {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if (queue.empty()) {
+                        break;
+                    }
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    const long long expected = static_cast<long long>(kProducers) * kItemsPerProducer * (kItemsPerProducer - 1) / 2;
+    ASSERT_EQ(sum.load(), expected);
+}
+
+// ========================================
+// SizeClassAllocator 测试
+// ========================================
+
+TEST(SizeClassAllocatorTests, SizeClassTable) {
+    using Allocator = SizeClassAllocator;
+    ASSERT_EQ(Allocator::class_size(0), kMinBlockSize);
+    ASSERT_EQ(Allocator::class_size(Allocator::kClassCount - 1), kMaxBlockSize);
+
+    // 每个请求都映射到能容纳它的最小级别
+    for (std::size_t bytes = 1; bytes <= kMaxBlockSize; ++bytes) {
+        std::size_t index = Allocator::size_class_index(bytes);
+        ASSERT_LT(index, Allocator::kClassCount);
+        ASSERT_GE(Allocator::class_size(index), bytes);
+        if (index > 0) {
+            ASSERT_LT(Allocator::class_size(index - 1), bytes);
+        }
+    }
+    ASSERT_EQ(Allocator::size_class_index(kMaxBlockSize + 1), Allocator::kClassCount);
+}
+
+TEST(SizeClassAllocatorTests, AllocateFromClasses) {
+    SizeClassAllocator allocator(SizeClassConfig{.thread_safe = false});
+
+    std::vector<std::pair<void*, std::size_t>> blocks;
+    for (std::size_t bytes : {1, 16, 17, 100, 129, 500, 1000, 4096}) {
+        void* ptr = allocator.allocate(bytes);
+        ASSERT_NE(ptr, nullptr);
+        ASSERT_TRUE(is_aligned(ptr, alignof(std::max_align_t)));
+        std::memset(ptr, 0xAB, bytes);
+        blocks.emplace_back(ptr, bytes);
+    }
+    ASSERT_EQ(allocator.stats().allocation_count, blocks.size());
+    ASSERT_EQ(allocator.large_allocation_count(), 0);
+
+    for (auto [ptr, bytes] : blocks) {
+        allocator.deallocate(ptr, bytes);
+    }
+    ASSERT_EQ(allocator.stats().used_memory, 0);
+
+    allocator.shrink_to_fit();
+    ASSERT_EQ(allocator.stats().chunk_count, 0);
+}
+
+TEST(SizeClassAllocatorTests, OverAlignedAllocation) {
+    SizeClassAllocator allocator(SizeClassConfig{.thread_safe = false});
+
+    void* ptr = allocator.allocate(48, 64);
+    ASSERT_TRUE(is_aligned(ptr, 64));
+    allocator.deallocate(ptr, 48, 64);
+
+    // 超过缓存行的对齐交给上游资源
+    void* wide = allocator.allocate(256, 256);
+    ASSERT_TRUE(is_aligned(wide, 256));
+    ASSERT_EQ(allocator.large_allocation_count(), 1);
+    allocator.deallocate(wide, 256, 256);
+    ASSERT_EQ(allocator.large_bytes(), 0);
+}
+
+TEST(SizeClassAllocatorTests, LargeAllocationFallback) {
+    std::pmr::monotonic_buffer_resource upstream;
+    SizeClassAllocator allocator(SizeClassConfig{.upstream = &upstream});
+
+    void* ptr = allocator.allocate(kMaxBlockSize + 1);
+    ASSERT_NE(ptr, nullptr);
+    ASSERT_EQ(allocator.large_bytes(), kMaxBlockSize + 1);
+    ASSERT_EQ(allocator.stats().allocation_count, 0);
+    allocator.deallocate(ptr, kMaxBlockSize + 1);
+    ASSERT_EQ(allocator.large_bytes(), 0);
+}
+
+TEST(SizeClassAllocatorTests, PmrContainers) {
+    SizeClassAllocator allocator;
+    {
+        std::pmr::vector<int> values(&allocator);
+        for (int i = 0; i < 2000; ++i) {
+            values.push_back(i);
+        }
+        std::pmr::string text("a string that is long enough to leave the small buffer", &allocator);
+        text += text;
+
+        ASSERT_EQ(values[1999], 1999);
+        ASSERT_GT(allocator.stats().used_memory, 0);
+        ASSERT_GT(allocator.large_allocation_count(), 0);  // 8000 字节的 vector 缓冲
+    }
+    ASSERT_EQ(allocator.stats().used_memory, 0);
+    ASSERT_EQ(allocator.large_bytes(), 0);
+}
+
+TEST(SizeClassAllocatorTests, ConcurrentAllocations) {
+    SizeClassAllocator allocator;
+    constexpr int num_threads = 4;
+    constexpr int allocs_per_thread = 2000;
+
+    std::atomic<int> failures{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < num_threads; ++t) {
+        threads.emplace_back([&allocator, &failures, t]() {
+            std::vector<std::pair<unsigned char*, std::size_t>> blocks;
+            for (int i = 0; i < allocs_per_thread; ++i) {
+                std::size_t bytes = 8 + static_cast<std::size_t>(i * 37 + t) % 3000;
+                auto* ptr = static_cast<unsigned char*>(allocator.allocate(bytes));
+                ptr[0] = static_cast<unsigned char>(t);
+                ptr[bytes - 1] = static_cast<unsigned char>(t);
+                blocks.emplace_back(ptr, bytes);
+            }
+            for (auto [ptr, bytes] : blocks) {
+                if (ptr[0] != t || ptr[bytes - 1] != t) {
+                    failures.fetch_add(1, std::memory_order_relaxed);
+                }
+                allocator.deallocate(ptr, bytes);
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    ASSERT_EQ(failures.load(), 0);
+    ASSERT_EQ(allocator.stats().used_memory, 0);
+}
+
 // ========================================
 // ChunkHeader 测试
 // ========================================
@@ -752,6 +1900,209 @@ TEST(ChunkHeaderTests, SmallChunkSize) {
     ASSERT_EQ(count, 0);
 }
 
+// ========================================
+// MemoryTracker 测试
+// ========================================
+
+TEST(MemoryTrackerTests, RecordAndQuery) {
+    auto& tracker = MemoryTracker::instance();
+    const TagStats before = tracker.stats(MemoryTag::User7);
+
+    track_allocation(MemoryTag::User7, 4096);
+    track_allocation(MemoryTag::User7, 1024);
+    track_deallocation(MemoryTag::User7, 4096);
+
+    const TagStats after = tracker.stats(MemoryTag::User7);
+    ASSERT_EQ(after.current_bytes, before.current_bytes + 1024);
+    ASSERT_EQ(after.allocation_count, before.allocation_count + 2);
+    ASSERT_EQ(after.deallocation_count, before.deallocation_count + 1);
+    ASSERT_GE(after.peak_bytes, after.current_bytes);
+    ASSERT_EQ(std::string(memory_tag_name(MemoryTag::User7)), "User7");
+
+    track_deallocation(MemoryTag::User7, 1024);
+    ASSERT_EQ(tracker.stats(MemoryTag::User7).current_bytes, before.current_bytes);
+}
+
+TEST(MemoryTrackerTests, PeakTracksLargeAllocations) {
+    auto& tracker = MemoryTracker::instance();
+    const std::size_t base = tracker.stats(MemoryTag::User3).current_bytes;
+
+    // 超过阈值的增量立即并入峰值，释放后峰值保持
+    track_allocation(MemoryTag::User3, 1024 * 1024);
+    track_deallocation(MemoryTag::User3, 1024 * 1024);
+    ASSERT_GE(tracker.stats(MemoryTag::User3).peak_bytes, base + 1024 * 1024);
+
+    tracker.reset_peaks();
+    ASSERT_EQ(tracker.stats(MemoryTag::User3).peak_bytes, base);
+}
+
+TEST(MemoryTrackerTests, BudgetAndRates) {
+    auto& tracker = MemoryTracker::instance();
+    tracker.set_budget(MemoryTag::User6, 64 * 1024);
+    ASSERT_EQ(tracker.budget(MemoryTag::User6), 64 * 1024);
+
+    tracker.sample();
+    track_allocation(MemoryTag::User6, 48 * 1024);
+    ASSERT_FALSE(tracker.stats(MemoryTag::User6).over_budget());
+    ASSERT_TRUE(tracker.would_exceed_budget(MemoryTag::User6, 32 * 1024));
+
+    track_allocation(MemoryTag::User6, 32 * 1024);
+    const auto stats = tracker.sample();
+    const TagStats& user6 = stats[static_cast<std::size_t>(MemoryTag::User6)];
+    ASSERT_TRUE(user6.over_budget());
+    ASSERT_GT(user6.allocation_rate, 0.0);
+    ASSERT_GT(user6.allocated_bytes_rate, 0.0);
+
+    track_deallocation(MemoryTag::User6, 80 * 1024);
+    tracker.set_budget(MemoryTag::User6, 0);
+    ASSERT_FALSE(tracker.would_exceed_budget(MemoryTag::User6, 1024 * 1024));
+}
+
+TEST(MemoryTrackerTests, AggregatesAcrossThreads) {
+    auto& tracker = MemoryTracker::instance();
+    const TagStats before = tracker.stats(MemoryTag::User5);
+
+    constexpr int kThreads = 4;
+    constexpr int kIterations = 1000;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([] {
+            for (int i = 0; i < kIterations; ++i) {
+                track_allocation(MemoryTag::User5, 256);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // 已退出线程的计数并入全局累计值，并可在其他线程释放
+    TagStats after = tracker.stats(MemoryTag::User5);
+    ASSERT_EQ(after.current_bytes, before.current_bytes + kThreads * kIterations * 256);
+    ASSERT_EQ(after.allocation_count, before.allocation_count + kThreads * kIterations);
+    ASSERT_GE(after.peak_bytes, after.current_bytes);
+
+    track_deallocation(MemoryTag::User5, kThreads * kIterations * 256);
+    ASSERT_EQ(tracker.stats(MemoryTag::User5).current_bytes, before.current_bytes);
+}
+
+TEST(MemoryTrackerTests, AllocatorsReportTags) {
+    auto& tracker = MemoryTracker::instance();
+    const std::size_t pool_before = tracker.stats(MemoryTag::User0).current_bytes;
+    const std::size_t arena_before = tracker.stats(MemoryTag::User1).current_bytes;
+    const std::size_t frame_before = tracker.stats(MemoryTag::User2).current_bytes;
+
+    {
+        FixedPool pool(PoolConfig{.block_size = 64, .chunk_size = 4096, .initial_chunks = 2, .tag = MemoryTag::User0});
+        ASSERT_EQ(tracker.stats(MemoryTag::User0).current_bytes, pool_before + 2 * 4096);
+
+        LinearArena arena(1024, true, PageBackend::Heap, MemoryTag::User1);
+        void* ptr = arena.allocate(4096);
+        ASSERT_NE(ptr, nullptr);
+        ASSERT_GT(tracker.stats(MemoryTag::User1).current_bytes, arena_before + 1024 + 4096);
+
+        FrameArena frame(FrameArenaConfig{
+            .buffer_size = 1024,
+            .buffer_count = 3,
+            .thread_buffer_size = 4096,
+            .tag = MemoryTag::User2,
+        });
+        ASSERT_EQ(tracker.stats(MemoryTag::User2).current_bytes, frame_before + 3 * (1024 + 4096));
+    }
+
+    ASSERT_EQ(tracker.stats(MemoryTag::User0).current_bytes, pool_before);
+    ASSERT_EQ(tracker.stats(MemoryTag::User1).current_bytes, arena_before);
+    ASSERT_EQ(tracker.stats(MemoryTag::User2).current_bytes, frame_before);
+}
+
+// ========================================
+// EpochManager 测试
+// ========================================
+
+namespace {
+std::atomic<int> g_epoch_deleted{0};
+
+struct EpochTracked {
+    ~EpochTracked() { g_epoch_deleted.fetch_add(1, std::memory_order_relaxed); }
+};
+}  // namespace
+
+TEST(EpochManagerTests, DefersReclamationWhilePinned) {
+    auto& epochs = EpochManager::instance();
+    epochs.synchronize();
+    g_epoch_deleted.store(0);
+
+    {
+        auto guard = epochs.pin();
+        ASSERT_TRUE(guard.active());
+        {
+            auto nested = epochs.pin();  // 嵌套临界区
+        }
+        epochs.retire(new EpochTracked());
+        ASSERT_EQ(epochs.pending(), 1u);
+
+        // 本线程仍在临界区，纪元最多推进一步，对象不会被删除
+        for (int i = 0; i < 4; ++i) {
+            epochs.collect();
+        }
+        ASSERT_EQ(g_epoch_deleted.load(), 0);
+    }
+
+    epochs.synchronize();
+    ASSERT_EQ(g_epoch_deleted.load(), 1);
+    ASSERT_EQ(epochs.pending(), 0u);
+
+    // 其他线程的临界区同样阻止回收
+    std::atomic<bool> pinned{false};
+    std::atomic<bool> release{false};
+    std::thread reader([&] {
+        auto guard = epochs.pin();
+        pinned.store(true);
+        while (!release.load()) {
+            std::this_thread::yield();
+        }
+    });
+    while (!pinned.load()) {
+        std::this_thread::yield();
+    }
+
+    epochs.retire(new EpochTracked());
+    for (int i = 0; i < 4; ++i) {
+        epochs.collect();
+    }
+    ASSERT_EQ(g_epoch_deleted.load(), 1);
+
+    release.store(true);
+    reader.join();
+    epochs.synchronize();
+    ASSERT_EQ(g_epoch_deleted.load(), 2);
+}
+
+TEST(EpochManagerTests, ExitedThreadsHandOverRetiredObjects) {
+    auto& epochs = EpochManager::instance();
+    epochs.synchronize();
+    g_epoch_deleted.store(0);
+
+    constexpr int kThreads = 4;
+    constexpr int kPerThread = 100;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&] {
+            for (int i = 0; i < kPerThread; ++i) {
+                auto guard = epochs.pin();
+                epochs.retire(new EpochTracked());
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // 退出线程未回收的对象由其他线程接管
+    epochs.synchronize();
+    ASSERT_EQ(g_epoch_deleted.load(), kThreads * kPerThread);
+}
+
 // ========================================
 // PoolStats 测试
 // ========================================
@@ -1,16 +1,23 @@
 #include "corona/kernel/utils/storage.h"
+#include "corona/kernel/utils/snapshot_storage.h"
 
 #include <algorithm>
 #include <array>
 #include <atomic>
 #include <chrono>
+#include <filesystem>
+#include <latch>
+#include <map>
 #include <random>
 #include <set>
+#include <span>
 #include <thread>
 #include <vector>
 
 #include "../test_framework.h"
 
+using Corona::Kernel::Utils::RwSpinLock;
+using Corona::Kernel::Utils::SnapshotStorage;
 using Corona::Kernel::Utils::Storage;
 
 TEST(StorageTests, BasicAllocateAndAccess) {
@@ -1132,6 +1139,347 @@ TEST(StorageTests, SeqIdInvalidHandle) {
     ASSERT_EQ(storage.seq_id(invalid_write_handle), -1);
 }
 
+TEST(StorageTests, ObjectIdResolvesAcrossManyBuffers) {
+    // ID 编码 buffer 索引与槽位索引，解析不依赖 buffer 数量
+    Storage<int, 4, 1> storage;
+    std::vector<Storage<int, 4, 1>::ObjectId> ids;
+    for (int i = 0; i < 4000; ++i) {
+        auto id = storage.allocate();
+        ASSERT_TRUE(id > 0);
+        {
+            auto accessor = storage.acquire_write(id);
+            ASSERT_EQ(accessor.id(), id);
+            *accessor = i;
+        }
+        ids.push_back(id);
+    }
+    ASSERT_EQ(storage.capacity(), 4000U);
+
+    // 序列号连续且唯一
+    std::set<std::int64_t> seqs;
+    for (std::size_t i = 0; i < ids.size(); ++i) {
+        ASSERT_TRUE(storage.contains(ids[i]));
+        ASSERT_EQ(*storage.acquire_read(ids[i]), static_cast<int>(i));
+        seqs.insert(storage.seq_id(ids[i]));
+    }
+    ASSERT_EQ(seqs.size(), ids.size());
+    ASSERT_EQ(*seqs.begin(), 0);
+    ASSERT_EQ(*seqs.rbegin(), 3999);
+
+    // 超出目录范围或尚未创建的 buffer
+    ASSERT_FALSE(storage.contains(0));
+    ASSERT_FALSE(storage.contains(ids.back() + 4));
+    ASSERT_FALSE(storage.contains(~Storage<int, 4, 1>::ObjectId{0}));
+    ASSERT_FALSE(storage.try_acquire_read(ids.back() + 4).valid());
+
+    for (auto id : ids) {
+        storage.deallocate(id);
+    }
+    ASSERT_TRUE(storage.empty());
+}
+
+TEST(StorageTests, RwSpinLockSharedExclusiveAndVersion) {
+    RwSpinLock lock;
+    ASSERT_EQ(sizeof(lock), 8U);
+
+    // 多个读者可以同时持锁，读者存在时写者无法加锁
+    lock.lock_shared();
+    ASSERT_TRUE(lock.try_lock_shared());
+    ASSERT_FALSE(lock.try_lock());
+    ASSERT_FALSE(lock.try_lock_for(std::chrono::milliseconds(5)));
+    lock.unlock_shared();
+    lock.unlock_shared();
+
+    // 乐观读：无写入时校验通过，写锁释放后版本号变化
+    const auto version = lock.read_begin();
+    ASSERT_TRUE(lock.read_validate(version));
+    ASSERT_TRUE(lock.try_lock());
+    ASSERT_EQ(lock.read_begin(), RwSpinLock::kWriteLocked);
+    ASSERT_FALSE(lock.read_validate(version));
+    ASSERT_FALSE(lock.try_lock_shared());
+    ASSERT_FALSE(lock.try_lock_shared_for(std::chrono::milliseconds(5)));
+    lock.unlock();
+    ASSERT_FALSE(lock.read_validate(version));
+    ASSERT_EQ(lock.version(), 1U);
+
+    // 超时放弃写锁不会改变版本号，也不会阻塞后续读者
+    lock.lock_shared();
+    ASSERT_FALSE(lock.try_lock_for(std::chrono::milliseconds(5)));
+    lock.unlock_shared();
+    ASSERT_EQ(lock.version(), 1U);
+    ASSERT_TRUE(lock.try_lock_shared());
+    lock.unlock_shared();
+}
+
+TEST(StorageTests, SpinLockStorageOptimisticRead) {
+    struct Pair {
+        std::int64_t a = 0;
+        std::int64_t b = 0;
+    };
+    using SpinStorage = Storage<Pair, 64, 1, RwSpinLock>;
+
+    // 每个槽位只多出 8 字节的锁
+    {
+        SpinStorage spin;
+        Storage<Pair, 64, 1> timed;
+        spin.deallocate(spin.allocate());
+        timed.deallocate(timed.allocate());
+        ASSERT_EQ(spin.committed_bytes(), 64 * (sizeof(RwSpinLock) + sizeof(Pair)));
+        ASSERT_LT(spin.committed_bytes(), timed.committed_bytes());
+    }
+
+    SpinStorage storage;
+    std::vector<SpinStorage::ObjectId> ids;
+    for (int i = 0; i < 128; ++i) {
+        auto id = storage.allocate();
+        {
+            auto writer = storage.acquire_write(id);
+            writer->a = i;
+            writer->b = i;
+        }
+        ids.push_back(id);
+    }
+
+    Pair value;
+    ASSERT_TRUE(storage.try_read(ids[5], value));
+    ASSERT_EQ(value.a, 5);
+    ASSERT_FALSE(storage.try_read(0, value));
+
+    storage.deallocate(ids[5]);
+    value = Pair{-1, -1};
+    ASSERT_FALSE(storage.try_read(ids[5], value));
+    ASSERT_EQ(value.a, -1);  // 失败时不修改输出
+    ids.erase(ids.begin() + 5);
+
+    // 写者保持 a == b，读者读到的副本必须一致
+    constexpr int kReaders = 4;
+    constexpr std::int64_t kMinReadsPerReader = 100;
+    std::atomic<bool> stop{false};
+    std::atomic<int> torn{0};
+    std::atomic<std::int64_t> reads{0};
+    std::latch readers_ready(kReaders);  // 读者全部开始运行后写者才开始，确保与写入并发
+    std::vector<std::thread> threads;
+    for (int w = 0; w < 2; ++w) {
+        threads.emplace_back([&, w] {
+            readers_ready.wait();
+            std::mt19937 rng(w);
+            for (int n = 0; n < 20000; ++n) {
+                auto writer = storage.acquire_write(ids[rng() % ids.size()]);
+                writer->a += 1;
+                writer->b = writer->a;
+            }
+        });
+    }
+    for (int r = 0; r < kReaders; ++r) {
+        threads.emplace_back([&, r] {
+            std::mt19937 rng(100 + r);
+            readers_ready.count_down();
+            // 至少完成 kMinReadsPerReader 次成功读取后才响应停止，断言不依赖线程调度
+            std::int64_t local_reads = 0;
+            while (local_reads < kMinReadsPerReader || !stop.load(std::memory_order_relaxed)) {
+                Pair copy;
+                if (storage.try_read(ids[rng() % ids.size()], copy)) {
+                    if (copy.a != copy.b) {
+                        torn.fetch_add(1, std::memory_order_relaxed);
+                    }
+                    ++local_reads;
+                }
+            }
+            reads.fetch_add(local_reads, std::memory_order_relaxed);
+        });
+    }
+    threads[0].join();
+    threads[1].join();
+    stop.store(true);
+    for (std::size_t t = 2; t < threads.size(); ++t) {
+        threads[t].join();
+    }
+
+    ASSERT_EQ(torn.load(), 0);
+    ASSERT_GE(reads.load(), kReaders * kMinReadsPerReader);
+
+    // 迭代器在自旋锁策略下同样可用
+    std::size_t visited = 0;
+    for (const auto& pair : storage) {
+        ASSERT_EQ(pair.a, pair.b);
+        ++visited;
+    }
+    ASSERT_EQ(visited, ids.size());
+}
+
+TEST(StorageTests, ForEachSweepsOccupiedSlots) {
+    using IntStorage = Storage<int, 64, 1>;
+    IntStorage storage;
+    std::vector<IntStorage::ObjectId> ids;
+    for (int i = 0; i < 1000; ++i) {
+        auto id = storage.allocate();
+        *storage.acquire_write(id) = i;
+        ids.push_back(id);
+    }
+    // 释放部分对象，让位图中出现空洞
+    std::map<IntStorage::ObjectId, int> live;
+    for (std::size_t i = 0; i < ids.size(); ++i) {
+        if (i % 3 == 0) {
+            storage.deallocate(ids[i]);
+        } else {
+            live[ids[i]] = static_cast<int>(i);
+        }
+    }
+
+    std::size_t visited = 0;
+    storage.for_each_read([&](IntStorage::ObjectId id, const int& value) {
+        ASSERT_TRUE(live.count(id) == 1);
+        ASSERT_EQ(value, live[id]);
+        ++visited;
+    });
+    ASSERT_EQ(visited, live.size());
+
+    storage.for_each_write([](int& value) { value = 1; });
+    std::int64_t sum = 0;
+    storage.for_each_read([&](const int& value) { sum += value; });
+    ASSERT_EQ(sum, static_cast<std::int64_t>(live.size()));
+
+    // 并行版本：每个对象恰好访问一次
+    storage.parallel_for_each_write([](int& value) { value += 1; });
+    std::atomic<std::int64_t> parallel_sum{0};
+    std::atomic<std::size_t> parallel_visited{0};
+    storage.parallel_for_each_read([&](IntStorage::ObjectId id, const int& value) {
+        if (storage.contains(id)) {
+            parallel_visited.fetch_add(1, std::memory_order_relaxed);
+        }
+        parallel_sum.fetch_add(value, std::memory_order_relaxed);
+    });
+    ASSERT_EQ(parallel_visited.load(), live.size());
+    ASSERT_EQ(parallel_sum.load(), static_cast<std::int64_t>(2 * live.size()));
+
+    // 迭代器同样按位图跳过空槽位
+    std::size_t iterated = 0;
+    for (const auto& value : storage) {
+        ASSERT_EQ(value, 2);
+        ++iterated;
+    }
+    ASSERT_EQ(iterated, live.size());
+}
+
+TEST(StorageTests, ForEachWaitsForLiveHandles) {
+    using IntStorage = Storage<int, 8, 1>;
+    IntStorage storage;
+    std::vector<IntStorage::ObjectId> ids;
+    for (int i = 0; i < 8; ++i) {
+        ids.push_back(storage.allocate());
+    }
+
+    std::atomic<bool> holding{false};
+    std::atomic<bool> sweep_started{false};
+    std::thread holder([&] {
+        auto handle = storage.acquire_write(ids[3]);
+        holding.store(true);
+        while (!sweep_started.load()) {
+            std::this_thread::yield();
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        // 持有句柄期间扩容：遍历在重试前会释放列表锁，不会死锁
+        for (int i = 0; i < 32; ++i) {
+            (void)storage.allocate();
+        }
+        *handle = 100;
+    });
+
+    while (!holding.load()) {
+        std::this_thread::yield();
+    }
+    sweep_started.store(true);
+    bool saw_written_value = false;
+    storage.for_each_write([&](IntStorage::ObjectId id, int& value) {
+        if (id == ids[3]) {
+            saw_written_value = value == 100;  // 必须等句柄释放后才能访问
+        }
+    });
+    holder.join();
+
+    ASSERT_TRUE(saw_written_value);
+    ASSERT_EQ(storage.count(), 40U);
+}
+
+TEST(StorageTests, BatchAllocateAndDeallocate) {
+    using IntStorage = Storage<int, 16, 1>;
+    IntStorage storage;
+
+    std::vector<IntStorage::ObjectId> ids(1000);
+    storage.allocate_n(ids);
+    ASSERT_EQ(storage.count(), 1000U);
+    // 一次扩容所需数量的 buffer：16 + 62 * 16
+    ASSERT_EQ(storage.capacity(), 1008U);
+
+    std::set<IntStorage::ObjectId> unique(ids.begin(), ids.end());
+    ASSERT_EQ(unique.size(), ids.size());
+    for (auto id : ids) {
+        ASSERT_TRUE(storage.contains(id));
+        ASSERT_EQ(*storage.acquire_read(id), 0);
+    }
+
+    // 批量释放后缩容到末尾只保留 2 个空 buffer
+    storage.deallocate_n(ids);
+    ASSERT_TRUE(storage.empty());
+    ASSERT_EQ(storage.capacity(), 32U);
+
+    // 缩容后非满链表中不再有已释放的 buffer
+    std::vector<IntStorage::ObjectId> again(40);
+    storage.allocate_n(again);
+    for (auto id : again) {
+        ASSERT_TRUE(storage.contains(id));
+    }
+    ASSERT_EQ(storage.capacity(), 48U);
+
+    // 批量中的重复释放：之前的 ID 已归还，计数保持一致
+    std::vector<IntStorage::ObjectId> duplicated = {again[0], again[1], again[0]};
+    ASSERT_THROW(storage.deallocate_n(duplicated), std::runtime_error);
+    ASSERT_EQ(storage.count(), 38U);
+    ASSERT_FALSE(storage.contains(again[1]));
+    storage.deallocate_n(std::span<const IntStorage::ObjectId>(again).subspan(2));
+    ASSERT_TRUE(storage.empty());
+}
+
+TEST(StorageTests, ConcurrentBatchAllocation) {
+    using IntStorage = Storage<int, 32, 1>;
+    IntStorage storage;
+    constexpr int kThreads = 4;
+    constexpr int kRounds = 100;
+
+    std::atomic<int> errors{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&, t] {
+            std::vector<IntStorage::ObjectId> ids(100 + t * 37);
+            for (int round = 0; round < kRounds; ++round) {
+                storage.allocate_n(ids);
+                for (auto id : ids) {
+                    auto writer = storage.acquire_write(id);
+                    if (*writer != 0) {
+                        errors.fetch_add(1);  // 槽位被重复分配
+                    }
+                    *writer = t + 1;
+                }
+                auto single = storage.allocate();
+                for (auto id : ids) {
+                    if (*storage.acquire_read(id) != t + 1) {
+                        errors.fetch_add(1);
+                    }
+                    *storage.acquire_write(id) = 0;
+                }
+                storage.deallocate_n(ids);
+                storage.deallocate(single);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    ASSERT_EQ(errors.load(), 0);
+    ASSERT_TRUE(storage.empty());
+}
+
 TEST(StorageTests, DoubleFreeDetection) {
     Storage<int, 8> storage;
 
@@ -2079,6 +2427,252 @@ TEST(StorageTests, ComprehensiveConcurrentOperations) {
     std::cout << "  Iterations: " << iterations.load() << "\n";
 }
 
+TEST(StorageTests, MemoryTagAccounting) {
+    using Corona::Kernal::Memory::MemoryTag;
+    using Corona::Kernal::Memory::MemoryTracker;
+    auto& tracker = MemoryTracker::instance();
+    const std::size_t before = tracker.stats(MemoryTag::User4).current_bytes;
+
+    {
+        Storage<int, 8, 1> storage(MemoryTag::User4);
+        ASSERT_EQ(storage.memory_tag(), MemoryTag::User4);
+        const std::size_t one_buffer = tracker.stats(MemoryTag::User4).current_bytes - before;
+        ASSERT_GT(one_buffer, 0u);
+        ASSERT_EQ(storage.committed_bytes(), 0u);  // 槽位区尚未提交
+
+        // 扩容计入新 buffer，分配计入已提交的槽位区
+        std::vector<Storage<int, 8, 1>::ObjectId> ids;
+        for (int i = 0; i < 20; ++i) {
+            ids.push_back(storage.allocate());
+        }
+        ASSERT_GT(storage.committed_bytes(), sizeof(int) * 20);
+        ASSERT_EQ(tracker.stats(MemoryTag::User4).current_bytes - before, one_buffer * 3 + storage.committed_bytes());
+
+        for (auto id : ids) {
+            storage.deallocate(id);
+        }
+    }
+
+    ASSERT_EQ(tracker.stats(MemoryTag::User4).current_bytes, before);
+}
+
+// 全局原子计数器用于 LazyCommitAndInPlaceConstruction 测试
+namespace {
+std::atomic<int> g_lazy_construct_count{0};
+std::atomic<int> g_lazy_destruct_count{0};
+}  // namespace
+
+TEST(StorageTests, LazyCommitAndInPlaceConstruction) {
+    struct Counted {
+        int value = 0;
+        Counted() { g_lazy_construct_count.fetch_add(1, std::memory_order_relaxed); }
+        ~Counted() { g_lazy_destruct_count.fetch_add(1, std::memory_order_relaxed); }
+    };
+
+    {
+        Storage<Counted, 64, 2> storage;
+        ASSERT_EQ(g_lazy_construct_count.load(), 0);  // 不为空槽位默认构造
+        ASSERT_EQ(storage.committed_bytes(), 0u);
+
+        auto a = storage.allocate();
+        auto b = storage.allocate();
+        auto c = storage.allocate();
+        ASSERT_EQ(g_lazy_construct_count.load(), 3);
+        storage.acquire_write(b)->value = 7;
+
+        storage.deallocate(b);
+        ASSERT_EQ(g_lazy_destruct_count.load(), 1);
+
+        // 复用的槽位重新构造
+        auto d = storage.allocate();
+        ASSERT_EQ(d, b);
+        ASSERT_EQ(storage.acquire_read(d)->value, 0);
+        ASSERT_EQ(g_lazy_construct_count.load(), 4);
+        (void)a;
+        (void)c;
+    }
+    // 析构时销毁存活对象
+    ASSERT_EQ(g_lazy_destruct_count.load(), 4);
+
+    // 较大的槽位区按页提交
+    struct Big {
+        std::array<char, 256> data{};
+    };
+    using BigStorage = Storage<Big, 256, 1, RwSpinLock>;
+    const std::size_t full = 256 * (sizeof(RwSpinLock) + sizeof(Big));
+
+    BigStorage storage;
+    ASSERT_EQ(storage.committed_bytes(), 0u);
+    std::vector<BigStorage::ObjectId> ids;
+    ids.push_back(storage.allocate());
+    ASSERT_GT(storage.committed_bytes(), 0u);
+    if (Corona::Kernal::Memory::virtual_memory_supported()) {
+        ASSERT_LT(storage.committed_bytes(), full);
+    }
+
+    // 高水位线以上的槽位从未分配过，不可访问
+    Big value;
+    const auto unused = ids[0] + 200;
+    ASSERT_FALSE(storage.contains(unused));
+    ASSERT_FALSE(storage.try_read(unused, value));
+    ASSERT_FALSE(storage.try_acquire_write(unused).valid());
+    ASSERT_THROW(storage.deallocate(unused), std::runtime_error);
+
+    for (int i = 1; i < 256; ++i) {
+        ids.push_back(storage.allocate());
+    }
+    ASSERT_GE(storage.committed_bytes(), full);
+    ASSERT_EQ(storage.capacity(), 256u);
+
+    ASSERT_TRUE(storage.try_read(ids.back(), value));
+    storage.deallocate_n(ids);
+    ASSERT_FALSE(storage.try_read(ids.back(), value));
+}
+
+TEST(StorageTests, SnapshotStorageReadAndPublish) {
+    struct Config {
+        int width = 0;
+        int height = 0;
+    };
+    SnapshotStorage<Config, 16, 1> configs;
+
+    auto id = configs.allocate(Config{1280, 720});
+    ASSERT_TRUE(configs.contains(id));
+    ASSERT_EQ(configs.count(), 1u);
+
+    auto before = configs.read(id);
+    ASSERT_TRUE(before.valid());
+    ASSERT_EQ(before->width, 1280);
+
+    // 已有快照不受之后发布的版本影响
+    ASSERT_TRUE(configs.publish(id, Config{1920, 1080}));
+    ASSERT_TRUE(configs.update(id, [](Config& config) { config.height = 1200; }));
+    ASSERT_EQ(before->width, 1280);
+    ASSERT_EQ(before->height, 720);
+
+    auto after = configs.read(id);
+    ASSERT_EQ(after->width, 1920);
+    ASSERT_EQ(after->height, 1200);
+    ASSERT_NE(before.get(), after.get());
+
+    configs.deallocate(id);
+    ASSERT_FALSE(configs.read(id).valid());
+    ASSERT_FALSE(configs.publish(id, Config{}));
+    ASSERT_FALSE(configs.update(id, [](Config&) {}));
+    ASSERT_THROW(configs.deallocate(id), std::runtime_error);
+    ASSERT_EQ(after->width, 1920);  // 释放后旧快照仍然有效
+}
+
+TEST(StorageTests, SnapshotStorageConcurrentReadersAndWriters) {
+    struct Pair {
+        std::int64_t a = 0;
+        std::int64_t b = 0;
+    };
+    SnapshotStorage<Pair, 16, 1> pairs;
+    auto id = pairs.allocate();
+
+    // 写者保持 a == b，读者看到的每个快照都必须一致，且在持有期间不被回收
+    constexpr int kWriters = 2;
+    constexpr int kUpdates = 2000;
+    std::atomic<bool> stop{false};
+    std::atomic<int> torn{0};
+    std::atomic<std::int64_t> reads{0};
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 4; ++r) {
+        readers.emplace_back([&] {
+            while (!stop.load(std::memory_order_relaxed)) {
+                auto snapshot = pairs.read(id);
+                if (!snapshot || snapshot->a != snapshot->b) {
+                    torn.fetch_add(1);
+                }
+                reads.fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+    }
+
+    std::vector<std::thread> writers;
+    for (int w = 0; w < kWriters; ++w) {
+        writers.emplace_back([&] {
+            for (int i = 0; i < kUpdates; ++i) {
+                pairs.update(id, [](Pair& pair) {
+                    ++pair.a;
+                    ++pair.b;
+                });
+            }
+        });
+    }
+    for (auto& writer : writers) {
+        writer.join();
+    }
+    stop.store(true);
+    for (auto& reader : readers) {
+        reader.join();
+    }
+
+    ASSERT_EQ(torn.load(), 0);
+    ASSERT_GT(reads.load(), 0);
+    // update 基于最新版本重做，不会丢失写入
+    ASSERT_EQ(pairs.read(id)->a, kWriters * kUpdates);
+    std::cout << "Snapshot reads: " << reads.load() << "\n";
+}
+
+TEST(StorageTests, PersistentStorageWarmRestart) {
+    struct Record {
+        std::uint32_t key;
+        float value;
+    };
+    const auto path = std::filesystem::temp_directory_path() / "corona_storage_persistent_test.bin";
+    std::filesystem::remove(path);
+
+    std::vector<std::pair<std::uintptr_t, std::uint32_t>> live;
+    std::uintptr_t freed_id = 0;
+    {
+        Storage<Record, 64, 1> records(path.string());
+        ASSERT_TRUE(records.is_persistent());
+        ASSERT_EQ(records.count(), 0u);
+
+        for (std::uint32_t i = 0; i < 100; ++i) {  // 跨越两个 buffer
+            auto id = records.allocate();
+            *records.acquire_write(id) = Record{i, i * 0.5f};
+            live.emplace_back(id, i);
+        }
+        freed_id = live[10].first;
+        records.deallocate(freed_id);
+        live.erase(live.begin() + 10);
+        ASSERT_TRUE(records.flush());
+
+        // 文件在打开期间被独占锁定
+        ASSERT_THROW((Storage<Record, 64, 1>(path.string())), std::runtime_error);
+    }
+
+    {
+        Storage<Record, 64, 1> records(path.string());
+        ASSERT_EQ(records.count(), live.size());
+        ASSERT_FALSE(records.contains(freed_id));
+        for (const auto& [id, key] : live) {
+            auto reader = records.acquire_read(id);
+            ASSERT_EQ(reader->key, key);
+            ASSERT_EQ(reader->value, key * 0.5f);
+        }
+
+        // 重启后优先复用空闲槽位，ID 保持稳定
+        auto id = records.allocate();
+        ASSERT_EQ(id, freed_id);
+        *records.acquire_write(id) = Record{1000, 1.0f};
+    }
+
+    {
+        Storage<Record, 64, 1> records(path.string());
+        ASSERT_EQ(records.count(), live.size() + 1);
+        ASSERT_EQ(records.acquire_read(freed_id)->key, 1000u);
+    }
+
+    // 布局不匹配（元素大小不同）时拒绝打开
+    ASSERT_THROW((Storage<std::uint64_t, 64, 1>(path.string())), std::runtime_error);
+    ASSERT_THROW((Storage<Record, 128, 1>(path.string())), std::runtime_error);
+    std::filesystem::remove(path);
+}
+
 int main() {
     return CoronaTest::TestRunner::instance().run_all();
 }
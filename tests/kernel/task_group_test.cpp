@@ -636,6 +636,132 @@ TEST(TaskGroup, MixedWorkloadConcurrency) {
     std::cout << "  Long tasks: " << long_tasks.load() << "\n";
 }
 
+// ========================================
+// 工作窃取队列测试
+// ========================================
+
+TEST(WorkStealingQueue, OwnerLifoThiefFifoAndGrowth) {
+    WorkStealingQueue queue(4);
+    std::vector<int> order;
+    for (int i = 0; i < 10; ++i) {  // 超过初始容量，触发扩容
+        queue.push([&order, i]() { order.push_back(i); });
+    }
+    ASSERT_EQ(queue.size(), 10u);
+
+    // 窃取者从最早推入的一端取
+    (*queue.try_steal())();
+    (*queue.try_steal())();
+    // 所有者从最近推入的一端取
+    while (auto task = queue.try_pop()) {
+        (*task)();
+    }
+    ASSERT_TRUE(queue.empty());
+    ASSERT_FALSE(queue.try_steal().has_value());
+
+    const std::vector<int> expected{0, 1, 9, 8, 7, 6, 5, 4, 3, 2};
+    ASSERT_TRUE(order == expected);
+}
+
+TEST(WorkStealingQueue, ConcurrentStealExecutesEachTaskOnce) {
+    constexpr int task_count = 20000;
+    constexpr int thief_count = 3;
+    WorkStealingQueue queue(16);
+    std::vector<std::atomic<int>> executed(task_count);
+    std::atomic<bool> done{false};
+
+    std::vector<std::thread> thieves;
+    for (int t = 0; t < thief_count; ++t) {
+        thieves.emplace_back([&]() {
+            while (!done.load(std::memory_order_acquire)) {
+                if (auto task = queue.try_steal()) {
+                    (*task)();
+                }
+            }
+        });
+    }
+
+    // 所有者交替推入与弹出，与窃取者争夺最后一个任务
+    for (int i = 0; i < task_count; ++i) {
+        queue.push([&executed, i]() { executed[i].fetch_add(1, std::memory_order_relaxed); });
+        if (i % 3 == 0) {
+            if (auto task = queue.try_pop()) {
+                (*task)();
+            }
+        }
+    }
+    while (auto task = queue.try_pop()) {
+        (*task)();
+    }
+    done.store(true, std::memory_order_release);
+    for (auto& thief : thieves) {
+        thief.join();
+    }
+
+    for (const auto& count : executed) {
+        ASSERT_EQ(count.load(), 1);
+    }
+}
+
+// ========================================
+// 空闲休眠与唤醒测试
+// ========================================
+
+TEST(EventCount, WaiterWakesOnNotify) {
+    EventCount event;
+    std::atomic<bool> ready{false};
+    std::atomic<bool> woke{false};
+
+    std::thread waiter([&]() {
+        while (!ready.load(std::memory_order_acquire)) {
+            const auto key = event.prepare_wait();
+            if (ready.load(std::memory_order_acquire)) {
+                event.cancel_wait();
+                break;
+            }
+            event.commit_wait(key);
+        }
+        woke.store(true, std::memory_order_release);
+    });
+
+    // 等待线程登记后再发布条件
+    while (event.waiters() == 0) {
+        std::this_thread::yield();
+    }
+    ready.store(true, std::memory_order_release);
+    event.notify_one();
+    waiter.join();
+
+    ASSERT_TRUE(woke.load());
+    ASSERT_EQ(event.waiters(), 0u);
+}
+
+TEST(EventCount, NotifyBeforeCommitIsNotLost) {
+    EventCount event;
+    const auto key = event.prepare_wait();
+    event.notify_one();
+    event.commit_wait(key);  // 登记后发生过通知，不应休眠
+    ASSERT_EQ(event.waiters(), 0u);
+
+    event.notify_all();  // 没有等待者时为空操作
+    ASSERT_EQ(event.waiters(), 0u);
+}
+
+TEST(TaskGroup, SubmitWakesParkedWorker) {
+    auto& scheduler = TaskScheduler::instance();
+    // 留出时间让空闲的工作线程进入休眠
+    std::this_thread::sleep_for(50ms);
+
+    std::atomic<bool> executed{false};
+    scheduler.submit([&executed]() { executed.store(true, std::memory_order_release); });
+
+    // 不调用 try_execute_task：任务只能由被唤醒的工作线程执行
+    const auto deadline = std::chrono::steady_clock::now() + 5s;
+    while (!executed.load(std::memory_order_acquire) && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(1ms);
+    }
+    ASSERT_TRUE(executed.load());
+}
+
 // ========================================
 // 主函数
 // ========================================
@@ -1,5 +1,9 @@
 #include "corona/kernel/ecs/world.h"
 
+#include "corona/kernel/ecs/world_delta.h"
+
+#include <cstddef>
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -58,6 +62,20 @@ struct Name {
 struct EnemyTag {};
 struct PlayerTag {};
 
+// SoA 拆分组件
+struct SoaPosition {
+    float x = 0.0f;
+    float y = 0.0f;
+    float z = 0.0f;
+};
+CORONA_SOA_COMPONENT(SoaPosition, &SoaPosition::x, &SoaPosition::y, &SoaPosition::z);
+
+struct SoaMass {
+    double value = 1.0;
+    std::uint8_t flags = 7;
+};
+CORONA_SOA_COMPONENT(SoaMass, &SoaMass::value, &SoaMass::flags);
+
 // ========================================
 // World 基本测试
 // ========================================
@@ -405,6 +423,54 @@ TEST(World, EachModifyComponents) {
     ASSERT_EQ(sum, 6.0f);
 }
 
+TEST(World, EachPrefetchedMatchesEach) {
+    World world;
+
+    // 跨越多个 Chunk 和多个 Archetype
+    constexpr int kCount = 5000;
+    for (int i = 0; i < kCount; ++i) {
+        if (i % 2 == 0) {
+            world.create_entity(Position{static_cast<float>(i), 0, 0}, Velocity{1, 0, 0});
+        } else {
+            world.create_entity(Position{static_cast<float>(i), 0, 0}, Velocity{1, 0, 0},
+                                Health{i, i});
+        }
+    }
+
+    double expected = 0.0;
+    std::size_t expected_count = 0;
+    world.each<Position, Velocity>([&](Position& pos, Velocity& vel) {
+        expected += pos.x + vel.vx;
+        ++expected_count;
+    });
+
+    double actual = 0.0;
+    std::size_t actual_count = 0;
+    world.each_prefetched<Position, Velocity>([&](Position& pos, Velocity& vel) {
+        actual += pos.x + vel.vx;
+        ++actual_count;
+    });
+
+    ASSERT_EQ(actual_count, static_cast<std::size_t>(kCount));
+    ASSERT_EQ(actual_count, expected_count);
+    ASSERT_EQ(actual, expected);
+
+    // 修改通过预取模式可见
+    world.each_prefetched<Position, Velocity>([](Position& pos, Velocity& vel) { pos.y = vel.vx; });
+    float sum_y = 0.0f;
+    world.each<Position>([&sum_y](Position& pos) { sum_y += pos.y; });
+    ASSERT_EQ(sum_y, static_cast<float>(kCount));
+
+    // 组件顺序与签名顺序无关
+    int health_count = 0;
+    world.each_prefetched<Health, Position>([&](Health& h, Position& pos) {
+        if (static_cast<float>(h.current) == pos.x) {
+            ++health_count;
+        }
+    });
+    ASSERT_EQ(health_count, kCount / 2);
+}
+
 // ========================================
 // 非平凡类型测试
 // ========================================
@@ -452,6 +518,295 @@ TEST(World, TagComponent) {
     ASSERT_TRUE(world.has_component<PlayerTag>(player));
 }
 
+// ========================================
+// SoA 拆分组件测试
+// ========================================
+
+TEST(World, SoaComponentCreateAndRead) {
+    World world;
+
+    EntityId e = world.create_entity(SoaPosition{1, 2, 3}, Velocity{4, 5, 6});
+    auto pos = world.read_component<SoaPosition>(e);
+    ASSERT_TRUE(pos.has_value());
+    ASSERT_EQ(pos->x, 1.0f);
+    ASSERT_EQ(pos->y, 2.0f);
+    ASSERT_EQ(pos->z, 3.0f);
+
+    ASSERT_TRUE(world.set_component(e, SoaPosition{7, 8, 9}));
+    pos = world.read_component<SoaPosition>(e);
+    ASSERT_EQ(pos->z, 9.0f);
+
+    // 非 SoA 组件也可读取副本
+    auto vel = world.read_component<Velocity>(e);
+    ASSERT_TRUE(vel.has_value());
+    ASSERT_EQ(vel->vy, 5.0f);
+
+    ASSERT_FALSE(world.read_component<Health>(e).has_value());
+}
+
+TEST(World, SoaComponentDefaultConstructed) {
+    World world;
+
+    EntityId e = world.create_entity(Health{1, 1});
+    ASSERT_TRUE(world.add_component(e, SoaMass{}));
+    world.destroy_entity(e);
+
+    // 复用槽位时应写入默认值而不是残留数据
+    EntityId a = world.create_entity(Health{2, 2});
+    ASSERT_TRUE(world.add_component(a, SoaMass{3.5, 1}));
+    EntityId b = world.create_entity(Health{3, 3});
+    ASSERT_TRUE(world.add_component(b, SoaMass{}));
+
+    auto mass = world.read_component<SoaMass>(b);
+    ASSERT_TRUE(mass.has_value());
+    ASSERT_EQ(mass->value, 1.0);
+    ASSERT_EQ(mass->flags, 7);
+    ASSERT_EQ(world.read_component<SoaMass>(a)->value, 3.5);
+}
+
+TEST(World, SoaComponentMigrationAndSwapAndPop) {
+    World world;
+
+    std::vector<EntityId> entities;
+    for (int i = 0; i < 100; ++i) {
+        entities.push_back(world.create_entity(SoaPosition{static_cast<float>(i), 0, 0}));
+    }
+
+    // 迁移：添加/移除其他组件时 SoA 数据随实体移动
+    ASSERT_TRUE(world.add_component(entities[10], Health{50, 100}));
+    ASSERT_EQ(world.read_component<SoaPosition>(entities[10])->x, 10.0f);
+    ASSERT_TRUE(world.remove_component<Health>(entities[10]));
+    ASSERT_EQ(world.read_component<SoaPosition>(entities[10])->x, 10.0f);
+
+    // 销毁触发 swap-and-pop
+    world.destroy_entity(entities[0]);
+    for (int i = 1; i < 100; ++i) {
+        ASSERT_EQ(world.read_component<SoaPosition>(entities[i])->x, static_cast<float>(i));
+    }
+
+    ASSERT_TRUE(world.remove_component<SoaPosition>(entities[5]));
+    ASSERT_FALSE(world.has_component<SoaPosition>(entities[5]));
+}
+
+TEST(World, EachChunkSoaFieldSpans) {
+    World world;
+
+    constexpr int kCount = 3000;
+    for (int i = 0; i < kCount; ++i) {
+        world.create_entity(SoaPosition{static_cast<float>(i), 0, 0}, Velocity{1, 2, 0});
+    }
+
+    std::size_t visited = 0;
+    world.each_chunk<SoaPosition, Velocity>(
+        [&](std::size_t count, SoaSpan<SoaPosition> pos, std::span<Velocity> vel) {
+            auto x = pos.get<&SoaPosition::x>();
+            auto y = pos.field<1>();
+            ASSERT_EQ(x.size(), count);
+            ASSERT_EQ(vel.size(), count);
+            if (count > 1) {
+                // 字段子列连续存储
+                ASSERT_EQ(&x[1] - &x[0], 1);
+            }
+            for (std::size_t i = 0; i < count; ++i) {
+                x[i] += vel[i].vx;
+                y[i] += vel[i].vy;
+            }
+            visited += count;
+        });
+    ASSERT_EQ(visited, static_cast<std::size_t>(kCount));
+
+    double sum_x = 0.0;
+    double sum_y = 0.0;
+    world.each_chunk<SoaPosition>([&](std::size_t count, SoaSpan<SoaPosition> pos) {
+        for (std::size_t i = 0; i < count; ++i) {
+            SoaPosition p = pos.load(i);
+            sum_x += p.x;
+            sum_y += p.y;
+        }
+    });
+    ASSERT_EQ(sum_x, static_cast<double>(kCount) * (kCount - 1) / 2.0 + kCount);
+    ASSERT_EQ(sum_y, 2.0 * kCount);
+}
+
+// ========================================
+// 变更追踪与增量编解码测试
+// ========================================
+
+TEST(World, EachWithEntityPassesEntityIds) {
+    World world;
+    EntityId e1 = world.create_entity(Position{1, 0, 0});
+    EntityId e2 = world.create_entity(Position{2, 0, 0});
+    EntityId e3 = world.create_entity(Position{3, 0, 0});
+    world.destroy_entity(e1);  // swap-and-pop：e3 移到第 0 行
+
+    std::vector<EntityId> seen;
+    world.each_with_entity<Position>([&](EntityId entity, Position& pos) {
+        ASSERT_TRUE(world.is_alive(entity));
+        ASSERT_EQ(world.get_component<Position>(entity)->x, pos.x);
+        seen.push_back(entity);
+    });
+
+    ASSERT_EQ(seen.size(), 2u);
+    ASSERT_TRUE((seen[0] == e2 && seen[1] == e3) || (seen[0] == e3 && seen[1] == e2));
+}
+
+TEST(World, DeltaTracksMutableAccess) {
+    World source;
+    EntityId e = source.create_entity(Position{1, 0, 0}, Velocity{1, 0, 0});
+
+    std::vector<std::byte> stream;
+    WorldDelta::encode(source, 0, stream);
+    World replica;
+    ASSERT_TRUE(WorldDelta::apply(replica, stream));
+
+    ChangeTick baseline = source.change_tick();
+    ASSERT_GT(source.advance_tick(), baseline);
+
+    // 可写指针访问视为写入
+    source.get_component<Position>(e)->x = 42.0f;
+    stream.clear();
+    ASSERT_EQ(WorldDelta::encode(source, baseline, stream), 1u);
+    ASSERT_TRUE(WorldDelta::apply(replica, stream));
+    ASSERT_EQ(replica.read_component<Position>(e)->x, 42.0f);
+
+    // 可写遍历标记查询的列
+    baseline = source.change_tick();
+    source.advance_tick();
+    source.each<const Position, Velocity>([](const Position& pos, Velocity& vel) { vel.vx = pos.x; });
+    stream.clear();
+    ASSERT_EQ(WorldDelta::encode(source, baseline, stream), 1u);
+    ASSERT_TRUE(WorldDelta::apply(replica, stream));
+    ASSERT_EQ(replica.read_component<Velocity>(e)->vx, 42.0f);
+}
+
+TEST(World, DeltaFullSnapshotRoundTrip) {
+    World source;
+    std::vector<EntityId> entities;
+    for (int i = 0; i < 300; ++i) {
+        entities.push_back(source.create_entity(Position{static_cast<float>(i), 1, 2},
+                                                Velocity{0, static_cast<float>(i), 0}));
+    }
+    for (int i = 0; i < 50; ++i) {
+        entities.push_back(source.create_entity(SoaPosition{static_cast<float>(i), -1.0f, 0.5f},
+                                                Health{i, 100}));
+    }
+
+    std::vector<std::byte> stream;
+    ASSERT_GT(WorldDelta::encode(source, 0, stream), 0u);
+
+    World replica;
+    ASSERT_TRUE(WorldDelta::apply(replica, stream));
+    ASSERT_EQ(replica.entity_count(), source.entity_count());
+
+    for (int i = 0; i < 300; ++i) {
+        EntityId e = entities[static_cast<std::size_t>(i)];
+        ASSERT_TRUE(replica.is_alive(e));
+        ASSERT_EQ(*replica.read_component<Position>(e), (Position{static_cast<float>(i), 1, 2}));
+        ASSERT_EQ(*replica.read_component<Velocity>(e), (Velocity{0, static_cast<float>(i), 0}));
+    }
+    for (int i = 0; i < 50; ++i) {
+        EntityId e = entities[300 + static_cast<std::size_t>(i)];
+        auto pos = replica.read_component<SoaPosition>(e);
+        ASSERT_TRUE(pos.has_value());
+        ASSERT_EQ(pos->x, static_cast<float>(i));
+        ASSERT_EQ(pos->y, -1.0f);
+        ASSERT_EQ(replica.read_component<Health>(e)->current, i);
+    }
+}
+
+TEST(World, DeltaOnlyChangedColumns) {
+    World source;
+    std::vector<EntityId> entities;
+    for (int i = 0; i < 2000; ++i) {
+        entities.push_back(source.create_entity(Position{static_cast<float>(i), 0, 0}, Velocity{}));
+    }
+
+    std::vector<std::byte> full;
+    WorldDelta::encode(source, 0, full);
+    World replica;
+    ASSERT_TRUE(WorldDelta::apply(replica, full));
+
+    ChangeTick baseline = source.change_tick();
+    source.advance_tick();
+
+    // 没有写入时只输出头部
+    std::vector<std::byte> empty;
+    ASSERT_EQ(WorldDelta::encode(source, baseline, empty), 0u);
+    ASSERT_TRUE(WorldDelta::apply(replica, empty));
+
+    // 修改单个实体的 Velocity：只应编码其所在 Chunk 的一列
+    ASSERT_TRUE(source.set_component(entities[5], Velocity{9, 8, 7}));
+    std::vector<std::byte> delta;
+    ASSERT_EQ(WorldDelta::encode(source, baseline, delta), 1u);
+    ASSERT_LT(delta.size() * 4, full.size());
+
+    ASSERT_TRUE(WorldDelta::apply(replica, delta));
+    ASSERT_EQ(*replica.read_component<Velocity>(entities[5]), (Velocity{9, 8, 7}));
+    ASSERT_EQ(replica.read_component<Position>(entities[5])->x, 5.0f);
+
+    // const 遍历不产生增量
+    baseline = source.change_tick();
+    source.advance_tick();
+    float sum = 0.0f;
+    source.each<const Position>([&](const Position& pos) { sum += pos.x; });
+    std::vector<std::byte> read_only;
+    ASSERT_EQ(WorldDelta::encode(source, baseline, read_only), 0u);
+    ASSERT_GT(sum, 0.0f);
+}
+
+TEST(World, DeltaStructuralChanges) {
+    World source;
+    std::vector<EntityId> entities;
+    for (int i = 0; i < 20; ++i) {
+        entities.push_back(source.create_entity(Position{static_cast<float>(i), 0, 0}));
+    }
+
+    std::vector<std::byte> stream;
+    WorldDelta::encode(source, 0, stream);
+    World replica;
+    ASSERT_TRUE(WorldDelta::apply(replica, stream));
+
+    ChangeTick baseline = source.change_tick();
+    source.advance_tick();
+
+    // 销毁、迁移、新建
+    source.destroy_entity(entities[3]);
+    source.add_component(entities[7], Velocity{7, 7, 7});
+    EntityId created = source.create_entity(Position{100, 0, 0}, Health{5, 10});
+
+    stream.clear();
+    WorldDelta::encode(source, baseline, stream);
+    ASSERT_TRUE(WorldDelta::apply(replica, stream));
+
+    ASSERT_EQ(replica.entity_count(), source.entity_count());
+    ASSERT_FALSE(replica.is_alive(entities[3]));
+    ASSERT_TRUE(replica.has_component<Velocity>(entities[7]));
+    ASSERT_EQ(*replica.read_component<Velocity>(entities[7]), (Velocity{7, 7, 7}));
+    ASSERT_EQ(replica.read_component<Position>(entities[7])->x, 7.0f);
+    ASSERT_EQ(replica.read_component<Health>(created)->max, 10);
+
+    for (std::size_t i = 0; i < entities.size(); ++i) {
+        if (i == 3) {
+            continue;
+        }
+        ASSERT_EQ(replica.read_component<Position>(entities[i])->x, static_cast<float>(i));
+    }
+}
+
+TEST(World, DeltaRejectsCorruptStream) {
+    World source;
+    source.create_entity(Position{1, 2, 3});
+
+    std::vector<std::byte> stream;
+    WorldDelta::encode(source, 0, stream);
+
+    World replica;
+    ASSERT_FALSE(WorldDelta::apply(replica, std::span<const std::byte>(stream.data(), stream.size() - 1)));
+
+    stream[0] = std::byte{0};
+    ASSERT_FALSE(WorldDelta::apply(replica, stream));
+}
+
 // ========================================
 // 压力测试
 // ========================================